@@ -0,0 +1,44 @@
+// AVR core step loop, standalone (no Qt): AvrCore::runStep() on a small
+// ALU / data space / IO loop, ns per instruction and MIPS.
+// shim/ stands in for Qt and eMcu, only what AvrCore, Mcu8bits and Cpu8bits use.
+//
+// S=../../../src/microsim/cores
+// g++ -O2 -std=c++14 -include shim/qtshim.h -Ishim -I$S -I$S/avr avrbench.cpp $S/avr/avrcore.cpp $S/mcu8bits.cpp $S/cpu8bits.cpp -o avrbench && ./avrbench
+//
+// To compare against another AvrCore version put its avrcore.cpp and avrcore.h
+// in a folder and build with that avrcore.cpp instead (see README.txt).
+#include <chrono>
+#include <cstdio>
+#include "avrcore.h"
+
+static const uint16_t loop[] = {
+    0xE505,         // LDI  r16,0x55
+    0x0F10,         // ADD  r17,r16
+    0x2721,         // EOR  r18,r17
+    0x9130, 0x0100, // LDS  r19,0x0100
+    0x9533,         // INC  r19
+    0x9330, 0x0100, // STS  0x0100,r19
+    0xB925,         // OUT  0x05,r18
+    0xB143,         // IN   r20,0x03
+    0x9701,         // SBIW r24,1
+    0xF7A1,         // BRNE loop
+    0xCFF3,         // RJMP loop
+};
+
+int main()
+{
+    eMcu mcu;
+    for( unsigned i=0; i<sizeof(loop)/2; ++i ) mcu.m_progMem[i] = loop[i];
+
+    AvrCore core( &mcu );
+    core.reset();
+
+    const uint64_t steps = 300000000;
+    uint64_t cycles = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for( uint64_t i=0; i<steps; ++i ){ core.runStep(); cycles += mcu.cyclesDone; }
+    double ns = std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now()-t0 ).count();
+
+    printf("%5.2f ns/instruction  %4.0f MIPS  (cycles %llu, r19 %u)\n", ns/steps, 1e3*steps/ns
+          , (unsigned long long)cycles, mcu.m_ram[0x100] );
+}
@@ -0,0 +1,10 @@
+// Minimal datautils.h (avrbench.cpp only)
+#pragma once
+#include "mcutypes.h"
+
+class eMcu;
+static uint8_t g_dummyReg;
+
+static inline regBits_t getRegBits( QString, eMcu* ) { regBits_t r; r.reg = &g_dummyReg; return r; }
+static inline uint8_t getRegBitsBool( regBits_t rb ) { return (*rb.reg & rb.mask) > 0; }
+static inline void clearRegBits( regBits_t bits )    { *bits.reg &= ~bits.mask; }
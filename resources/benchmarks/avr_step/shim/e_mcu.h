@@ -0,0 +1,44 @@
+// Minimal eMcu for building the AVR core without Qt (avrbench.cpp only)
+// Flat data memory, registers without watchers: same cost for any core version.
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "mcutypes.h"
+
+struct Interrupts { void retI(){} };
+
+class eMcu
+{
+    public:
+        uint8_t* getRam()    { return m_ram.data(); }
+        uint32_t ramSize()   { return m_ram.size(); }
+        uint32_t flashSize() { return m_progMem.size(); }
+
+        // Out of line like the real DataSpace::readReg()/writeReg()
+        uint8_t __attribute__((noinline)) readReg( uint16_t a ) { return m_ram[a]; }
+        void __attribute__((noinline)) writeReg( uint16_t a, uint8_t v ) { m_ram[a] = v; }
+
+        bool isReadWatched( uint16_t ) { return false; }
+        bool regExist( QString )       { return false; }
+        uint8_t* getReg( QString )     { return nullptr; }
+        uint16_t getRegAddress( QString ) { return 0; }
+        int pgmPage() { return 64; }
+
+        void enableInterrupts( uint8_t ){}
+        void sleep( bool ){}
+        void wdr(){}
+        void instExecuted(){ m_instCount++; }
+        Interrupts* interrupts() { return &m_interrupts; }
+
+        uint64_t cyclesDone = 0;
+        uint64_t m_instCount = 0;
+
+        std::vector<uint8_t>  m_ram     = std::vector<uint8_t>( 0x900 );  // ATmega328 data space
+        std::vector<uint16_t> m_progMem = std::vector<uint16_t>( 0x4000 );
+
+        uint16_t m_regStart = 0x20;
+        uint16_t m_regEnd   = 0xFF;
+        uint16_t m_sregAddr = 0x5F;
+
+        Interrupts m_interrupts;
+};
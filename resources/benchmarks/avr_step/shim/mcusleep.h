@@ -0,0 +1,17 @@
+// Minimal McuSleep (avrbench.cpp only)
+#pragma once
+#include <cstdint>
+
+class eMcu;
+class Interrupt;
+
+class McuSleep
+{
+    public:
+        McuSleep( eMcu*, QString ){}
+        virtual ~McuSleep(){}
+
+        virtual void setup(){}
+        virtual void initialize(){}
+        virtual void configureA( uint8_t ){}
+};
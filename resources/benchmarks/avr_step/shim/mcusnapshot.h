@@ -0,0 +1,12 @@
+// Minimal StateStream, snapshots not used (avrbench.cpp only)
+#pragma once
+#include <vector>
+
+class StateStream
+{
+    public:
+        template<typename T> void put( T ){}
+        template<typename T> void get( T& ){}
+        template<typename T> void putVector( const std::vector<T>& ){}
+        template<typename T> void getVector( std::vector<T>& ){}
+};
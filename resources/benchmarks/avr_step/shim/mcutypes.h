@@ -0,0 +1,11 @@
+// Minimal mcutypes.h (avrbench.cpp only)
+#pragma once
+#include <cstdint>
+
+struct regBits_t
+{
+    uint8_t  bit0 = 0;
+    uint8_t  mask = 0;
+    uint8_t* reg  = 0;
+    uint16_t regAddr = 0;
+};
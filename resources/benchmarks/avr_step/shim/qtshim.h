@@ -0,0 +1,24 @@
+// Minimal Qt for building the AVR core without Qt (avrbench.cpp only)
+#pragma once
+#include <cstdint>
+#include <string>
+
+typedef unsigned int uint;
+
+class QString
+{
+    public:
+        QString(){}
+        QString( const char* c ): s( c ){}
+        QString operator+( const QString& o ) const { return QString( (s+o.s).c_str() ); }
+        bool operator==( const QString& o ) const { return s == o.s; }
+        bool isEmpty() const { return s.empty(); }
+        int toInt( bool* =0, int=10 ) const { return 0; }
+        static QString number( int, int=10 ) { return QString(); }
+
+    private:
+        std::string s;
+};
+
+class QDebug { public: template<class T> QDebug& operator<<( const T& ){ return *this; } };
+inline QDebug qDebug(){ return QDebug(); }
@@ -0,0 +1,2 @@
+// Empty: Simulator not used by the AVR core step loop (avrbench.cpp only)
+#pragma once
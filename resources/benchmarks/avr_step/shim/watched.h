@@ -0,0 +1,4 @@
+// Minimal Watched (avrbench.cpp only)
+#pragma once
+
+class Watched { public: virtual ~Watched(){} };
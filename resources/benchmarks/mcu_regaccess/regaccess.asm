@@ -0,0 +1,31 @@
+; MCU register access benchmark for ATmega328
+;
+; Tight loop mixing watched registers (PINB, PORTB, TCNT0),
+; unwatched registers (GPIOR0) and plain RAM accesses.
+; Run headless and compare the MIPS reported for the MCU:
+;
+;   simulide -run regaccess.sim2 -time 1s
+
+.equ PINB   = 0x03
+.equ DDRB   = 0x04
+.equ PORTB  = 0x05
+.equ GPIOR0 = 0x1E
+.equ TCCR0B = 0x25
+.equ TCNT0  = 0x26
+
+.org 0x0000
+        ldi  r16, 0xFF
+        out  DDRB, r16       ; PORTB output
+        ldi  r16, 0x01
+        out  TCCR0B, r16     ; Timer0 clock = Fcpu
+        ldi  r20, 0x00
+loop:
+        in   r17, PINB       ; Watched read
+        out  PORTB, r20      ; Watched write
+        in   r18, TCNT0      ; Watched read, timer updates counter
+        out  GPIOR0, r20     ; Unwatched register write
+        in   r22, GPIOR0     ; Unwatched register read
+        sts  0x0100, r18     ; RAM write
+        lds  r19, 0x0100     ; RAM read
+        inc  r20
+        rjmp loop
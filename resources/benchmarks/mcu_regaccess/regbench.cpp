@@ -0,0 +1,71 @@
+// DataSpace register access path, standalone (no Qt):
+// before: Signal lookup in a hash by address (std::unordered_map stands in for QHash)
+// after:  flat Signal tables indexed by address, inline readReg()
+//
+// g++ -O2 -std=c++14 -I../../../src/microsim regbench.cpp -o regbench && ./regbench
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+#include "mcusignal.h"
+
+struct Port { uint8_t pin = 0; void readPin( uint8_t ){ pin++; } void write( uint8_t v ){ pin ^= v; } };
+
+struct Before {
+    std::vector<uint8_t> mem = std::vector<uint8_t>( 0x900 );
+    std::unordered_map<uint16_t, McuSignal*> rd, wr;
+    int ov;
+    uint8_t readReg( uint16_t a ){
+        uint8_t v = mem[a];
+        auto it = rd.find( a ); McuSignal* s = it == rd.end() ? nullptr : it->second;
+        if( s ){ ov = -1; s->emitValue( v ); v = ov >= 0 ? ov : mem[a]; }
+        return v;
+    }
+    void writeReg( uint16_t a, uint8_t v ){
+        auto it = wr.find( a ); McuSignal* s = it == wr.end() ? nullptr : it->second;
+        if( s ){ ov = -1; s->emitValue( v ); if( ov >= 0 ) v = ov; }
+        mem[a] = v;
+    }
+    McuSignal* watch( uint16_t a, bool w ){ auto& t = w ? wr : rd; if( !t[a] ) t[a] = new McuSignal; return t[a]; }
+};
+struct After {
+    std::vector<uint8_t> mem = std::vector<uint8_t>( 0x900 );
+    std::vector<McuSignal*> rd = std::vector<McuSignal*>( 0x900 ), wr = std::vector<McuSignal*>( 0x900 );
+    int ov;
+    uint8_t __attribute__((noinline)) readWatched( uint16_t a, McuSignal* s ){ ov = -1; s->emitValue( mem[a] ); return ov >= 0 ? ov : mem[a]; }
+    inline uint8_t readReg( uint16_t a ){ McuSignal* s = rd[a]; if( !s ) return mem[a]; return readWatched( a, s ); }
+    void writeReg( uint16_t a, uint8_t v ){
+        McuSignal* s = wr[a];
+        if( s ){ ov = -1; s->emitValue( v ); if( ov >= 0 ) v = ov; }
+        mem[a] = v;
+    }
+    McuSignal* watch( uint16_t a, bool w ){ auto& t = w ? wr : rd; if( !t[a] ) t[a] = new McuSignal; return t[a]; }
+};
+
+template<class S> double run( const char* name, uint64_t n )
+{
+    S s; Port p;
+    for( int a : { 0x23, 0x24, 0x25, 0x46, 0x47, 0x48, 0x5F } ) s.watch( a, false ); // Some other watched regs
+    s.watch( 0x23, false )->connect( &p, &Port::readPin );  // PINB
+    s.watch( 0x25, true  )->connect( &p, &Port::write );    // PORTB
+    s.watch( 0x46, false )->connect( &p, &Port::readPin );  // TCNT0
+    volatile uint8_t sink = 0; uint8_t r20 = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for( uint64_t i=0; i<n; ++i ){
+        sink = s.readReg( 0x23 );     // in r17, PINB
+        s.writeReg( 0x25, r20 );      // out PORTB, r20
+        sink = s.readReg( 0x46 );     // in r18, TCNT0
+        s.writeReg( 0x3E, r20 );      // out GPIOR0, r20
+        sink = s.readReg( 0x3E );     // in r22, GPIOR0
+        r20++;
+    }
+    double ns = std::chrono::duration<double,std::nano>( std::chrono::steady_clock::now()-t0 ).count()/n;
+    printf( "%-7s %.2f ns per loop pass (5 register accesses)\n", name, ns );
+    return ns;
+}
+
+int main()
+{
+    uint64_t n = 200000000;
+    for( int i=0; i<3; ++i ){ run<Before>( "before", n ); run<After>( "after", n ); }
+}
@@ -0,0 +1,198 @@
+// Pic14eCore instruction dispatch, standalone (no Qt):
+// decode:   decode the flash word at every step (before predecoding)
+// twoLevel: predecoded entry, Pic14e switch falling back to the PicMrCore switch
+// oneLevel: predecoded entry, one switch over base and Pic14e handlers
+// Handlers and register access are reduced copies of picmrcore.cpp/pic14ecore.cpp,
+// out of line and behind virtual GET_RAM/SET_RAM as in the simulator.
+//
+// g++ -O2 -std=c++14 picbench.cpp -o picbench && ./picbench
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#define NOINLINE __attribute__((noinline))
+
+enum { C=0, Z=2 };
+enum {
+    PIC_UNDECODED=0, PIC_NOP, PIC_RETURN,
+    PIC_MOVWF, PIC_CLR, PIC_SUBWF, PIC_DECF, PIC_IORWF, PIC_ANDWF, PIC_XORWF, PIC_ADDWF,
+    PIC_MOVF, PIC_COMF, PIC_INCF, PIC_DECFSZ, PIC_RRF, PIC_RLF, PIC_SWAPF, PIC_INCFSZ,
+    PIC_BCF, PIC_BSF, PIC_BTFSC, PIC_BTFSS, PIC_CALL, PIC_GOTO,
+    PIC_MOVLW, PIC_RETLW, PIC_IORLW, PIC_ANDLW, PIC_XORLW, PIC_SUBLW, PIC_ADDLW,
+    PIC_MOVIW_Fi, PIC_LSLF, PIC_LSRF, PIC_MOVLB, PIC_BRA, PIC_MOVIW
+};
+struct picInst_t { uint8_t op; uint8_t f; uint16_t k; };
+
+struct Core
+{
+    std::vector<uint8_t>   m_dataMem = std::vector<uint8_t>( 0x1000 );
+    std::vector<uint16_t>  m_progMem;
+    std::vector<picInst_t> m_decoded;
+    uint8_t  m_W = 0, m_FSR0 = 0x40;
+    uint16_t m_PC = 0, m_bank = 0;
+    uint64_t m_steps = 0, m_cycles = 0, m_cyclesDone = 0;
+
+    virtual ~Core() {}
+    virtual void runStep() = 0;
+
+    virtual uint8_t GET_RAM( uint16_t addr ) { addr += m_bank; if( addr == 0 ) addr = m_FSR0; return m_dataMem[addr]; }
+    virtual void SET_RAM( uint16_t addr, uint8_t v ) { addr += m_bank; if( addr == 0 ) addr = m_FSR0; m_dataMem[addr] = v; }
+
+    void incDefault() { m_PC++; m_cyclesDone++; }
+    void setValue( uint8_t v, uint8_t f, uint8_t d ) { if( d ) SET_RAM( f, v ); else m_W = v; }
+    void setZ( bool z ) { if( z ) m_dataMem[3] |= 1<<Z; else m_dataMem[3] &= ~(1<<Z); }
+    void setValueZ( uint8_t v, uint8_t f, uint8_t d ) { setValue( v, f, d ); setZ( v == 0 ); }
+    uint8_t add( uint8_t a, uint8_t b ) { uint16_t r = a+b; if( r > 0xFF ) m_dataMem[3] |= 1; else m_dataMem[3] &= ~1; setZ( (r & 0xFF) == 0 ); return r; }
+
+    NOINLINE void MOVWF( uint8_t f )             { SET_RAM( f, m_W ); }
+    NOINLINE void ADDWF( uint8_t f, uint8_t d )  { setValue( add( GET_RAM( f ), m_W ), f, d ); }
+    NOINLINE void MOVF( uint8_t f, uint8_t d )   { setValueZ( GET_RAM( f ), f, d ); }
+    NOINLINE void INCF( uint8_t f, uint8_t d )   { uint8_t v = GET_RAM( f ); setValueZ( ++v, f, d ); }
+    NOINLINE void DECFSZ( uint8_t f, uint8_t d ) { uint8_t v = GET_RAM( f )-1; setValue( v, f, d ); if( v == 0 ) incDefault(); }
+    NOINLINE void BTFSC( uint8_t f, uint8_t b )  { if( (GET_RAM( f ) & 1<<b) == 0 ) incDefault(); }
+    NOINLINE void GOTO( uint16_t k )             { m_PC = k; m_cyclesDone = 2; }
+    NOINLINE void XORLW( uint8_t k )             { m_W ^= k; setZ( m_W == 0 ); }
+    NOINLINE void MOVLW( uint8_t k )             { m_W = k; }
+    NOINLINE void MOVIW_Fi( uint8_t )            { m_W = GET_RAM( 0 ); m_FSR0++; setZ( m_W == 0 ); }
+    NOINLINE void LSLF( uint8_t f, uint8_t d )   { setValue( GET_RAM( f ) << 1, f, d ); }
+
+    void decodeMr( uint16_t instr, picInst_t* inst ) // Reduced PicMrCore::decode, same mask tree
+    {
+        *inst = { PIC_NOP, 0, 0 };
+        if( (instr & 0x3F80) == 0 ) return;
+        if( (instr & 0x3000) == 0 ) {
+            uint8_t f = instr & 0x7F, d = instr>>7 & 1;
+            if( (instr & 0x3800) == 0 ) {
+                switch( instr & 0x0700 ) {
+                    case 0x0000: *inst = { PIC_MOVWF, f, 0 }; return;
+                    case 0x0700: *inst = { PIC_ADDWF, f, d }; return;
+                }
+            } else {
+                switch( instr & 0x0700 ) {
+                    case 0x0000: *inst = { PIC_MOVF, f, d };   return;
+                    case 0x0200: *inst = { PIC_INCF, f, d };   return;
+                    case 0x0300: *inst = { PIC_DECFSZ, f, d }; return;
+                }
+            }
+        }
+        else if( (instr & 0x3000) == 0x1000 ) {
+            if( (instr & 0x3C00) == 0x1800 ) *inst = { PIC_BTFSC, (uint8_t)(instr & 0x7F), (uint16_t)(instr>>7 & 7) };
+        }
+        else if( (instr & 0x3000) == 0x2000 ) {
+            if( instr & 0x0800 ) *inst = { PIC_GOTO, 0, (uint16_t)(instr & 0x7FF) };
+        }
+        else {
+            switch( instr & 0x3F00 ) {
+                case 0x3000: *inst = { PIC_MOVLW, 0, (uint16_t)(instr & 0xFF) }; return;
+                case 0x3A00: *inst = { PIC_XORLW, 0, (uint16_t)(instr & 0xFF) }; return;
+            }
+        }
+    }
+    void decode14e( uint16_t instr, picInst_t* inst ) // Reduced Pic14eCore::decode
+    {
+        if( (instr & 0x3FC0) == 0 ) {
+            if( (instr & 0x0030) == 0x10 && (instr & 0x000B) == 2 ) { *inst = { PIC_MOVIW_Fi, (uint8_t)(instr & 4), 0 }; return; }
+        }
+        else if( (instr & 0x3000) == 0x3000 ) {
+            switch( instr & 0x3F00 ) {
+                case 0x3500: *inst = { PIC_LSLF, (uint8_t)(instr & 0x7F), (uint16_t)(instr & 0x80) }; return;
+            }
+        }
+        decodeMr( instr, inst );
+    }
+
+    NOINLINE void executeMr( const picInst_t* inst ) // PicMrCore::execute
+    {
+        const uint8_t f = inst->f; const uint16_t k = inst->k;
+        switch( inst->op ) {
+            case PIC_MOVWF:  MOVWF( f );     break;
+            case PIC_ADDWF:  ADDWF( f, k );  break;
+            case PIC_MOVF:   MOVF( f, k );   break;
+            case PIC_INCF:   INCF( f, k );   break;
+            case PIC_DECFSZ: DECFSZ( f, k ); break;
+            case PIC_BTFSC:  BTFSC( f, k );  break;
+            case PIC_GOTO:   GOTO( k );      break;
+            case PIC_MOVLW:  MOVLW( k );     break;
+            case PIC_XORLW:  XORLW( k );     break;
+        }
+    }
+    virtual void execute( const picInst_t* inst ) // Pic14eCore::execute, default: PicMrCore::execute
+    {
+        const uint8_t f = inst->f; const uint16_t k = inst->k;
+        switch( inst->op ) {
+            case PIC_MOVIW_Fi: MOVIW_Fi( f ); break;
+            case PIC_LSLF:     LSLF( f, k );  break;
+            default: executeMr( inst );
+        }
+    }
+    void executeOne( const picInst_t* inst ) // Pic14eCore::execute with PIC_MR_CASES
+    {
+        const uint8_t f = inst->f; const uint16_t k = inst->k;
+        switch( inst->op ) {
+            case PIC_MOVIW_Fi: MOVIW_Fi( f );   break;
+            case PIC_LSLF:     LSLF( f, k );    break;
+            case PIC_MOVWF:    MOVWF( f );      break;
+            case PIC_ADDWF:    ADDWF( f, k );   break;
+            case PIC_MOVF:     MOVF( f, k );    break;
+            case PIC_INCF:     INCF( f, k );    break;
+            case PIC_DECFSZ:   DECFSZ( f, k );  break;
+            case PIC_BTFSC:    BTFSC( f, k );   break;
+            case PIC_GOTO:     GOTO( k );       break;
+            case PIC_MOVLW:    MOVLW( k );      break;
+            case PIC_XORLW:    XORLW( k );      break;
+        }
+    }
+    picInst_t* getInst( uint16_t pc )
+    {
+        picInst_t* inst = &m_decoded[pc];
+        if( inst->op == PIC_UNDECODED ) decode14e( m_progMem[pc], inst );
+        return inst;
+    }
+};
+
+struct DecodeCore : Core {
+    void runStep() override { picInst_t inst; decode14e( m_progMem[m_PC], &inst ); m_cyclesDone = 0; incDefault(); execute( &inst ); }
+};
+struct TwoLevelCore : Core {
+    void runStep() override { picInst_t* inst = getInst( m_PC ); m_cyclesDone = 0; incDefault(); execute( inst ); }
+};
+struct OneLevelCore : Core {
+    void runStep() override { picInst_t* inst = getInst( m_PC ); m_cyclesDone = 0; incDefault(); executeOne( inst ); }
+};
+
+static const std::vector<uint16_t> loop = {
+    0x0012, // MOVIW  FSR0++
+    0x07A0, // ADDWF  0x20,f
+    0x35A1, // LSLF   0x21,f
+    0x0822, // MOVF   0x22,w
+    0x3A55, // XORLW  0x55
+    0x00A3, // MOVWF  0x23
+    0x1824, // BTFSC  0x24,0
+    0x0AA5, // INCF   0x25,f
+    0x0BA6, // DECFSZ 0x26,f
+    0x2800, // GOTO   0
+    0x2800, // GOTO   0
+};
+
+static void run( const char* name, Core* core, uint64_t steps )
+{
+    core->m_progMem = loop;
+    core->m_decoded.assign( loop.size(), picInst_t{ PIC_UNDECODED, 0, 0 } );
+
+    auto t0 = std::chrono::steady_clock::now();
+    for( uint64_t i=0; i<steps; ++i ) core->runStep();
+    double ns = std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now()-t0 ).count();
+
+    uint32_t sum = 0; for( uint8_t v : core->m_dataMem ) sum += v;
+    printf("%-9s %5.2f ns/instruction  %6.0f MIPS  (check %u)\n", name, ns/steps, 1e3*steps/ns, sum );
+}
+
+int main()
+{
+    const uint64_t steps = 500000000;
+    Core* cores[] = { new DecodeCore, new TwoLevelCore, new OneLevelCore };
+    run("decode",   cores[0], steps );
+    run("twoLevel", cores[1], steps );
+    run("oneLevel", cores[2], steps );
+}
@@ -0,0 +1,125 @@
+// CircMatrix group solvers, standalone (no Qt):
+// dense:  LuKernel::factor + solve (fastest kernel for this CPU), as CircMatrix with Solver_Dense
+// sparse: SparseLU::factor + solve, as CircMatrix with Solver_Sparse
+// Both solve the same matrices built like circuits stamp them: admittances
+// between connected nodes plus a conductance to ground on some nodes.
+//
+// Auto column: solver CircMatrix::createSparse() selects with Solver_Auto,
+// Analyze marked * when Auto picks dense from the pattern density, without analyze.
+// qshim/QElapsedTimer stands in for Qt, only used by LuKernel::benchmark().
+//
+// S=../../../src/simulator
+// g++ -O2 -std=c++14 -Iqshim -I$S lubench.cpp $S/lukernel.cpp $S/sparselu.cpp -o lubench && ./lubench
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "lukernel.h"
+#include "sparselu.h"
+
+struct Circuit
+{
+    int n;
+    std::vector<std::vector<double>> a;      // Dense admittance Matrix
+    std::vector<std::vector<int>> pattern;   // Connections of each node, as CircMatrix::createSparse()
+
+    Circuit( int size ) : n( size ), a( size, std::vector<double>( size, 0 ) ), pattern( size ) {}
+
+    void connect( int i, int j, double adm )   // Resistor between nodes i and j
+    {
+        if( a[i][j] == 0 ){ pattern[i].push_back( j ); pattern[j].push_back( i ); }
+        a[i][j] -= adm; a[j][i] -= adm;
+        a[i][i] += adm; a[j][j] += adm;
+    }
+    void ground( int i, double adm ) { a[i][i] += adm; }
+};
+
+static uint32_t seed = 12345;
+static uint32_t rnd() { seed = seed*1103515245 + 12345; return (seed>>16) & 0x7FFF; }
+static double rndAdm() { return 1.0/(1+rnd()%1000); }
+
+static Circuit ladder( int n )  // Resistor ladder, R-2R DAC like
+{
+    Circuit c( n );
+    for( int i=0; i<n; ++i ){ if( i ) c.connect( i-1, i, rndAdm() ); c.ground( i, rndAdm() ); }
+    return c;
+}
+static Circuit grid( int n )    // 2D mesh, LED/resistor matrix like
+{
+    Circuit c( n );
+    int w = (int)std::sqrt( (double)n );
+    for( int i=0; i<n; ++i ){
+        if( i%w ) c.connect( i-1, i, rndAdm() );
+        if( i>=w ) c.connect( i-w, i, rndAdm() );
+        if( i%7 == 0 ) c.ground( i, rndAdm() );
+    }
+    return c;
+}
+static Circuit filled( int n )  // 25% of node pairs connected: worst case for sparse
+{
+    Circuit c( n );
+    for( int i=0; i<n; ++i ){
+        c.ground( i, rndAdm() );
+        for( int j=0; j<i; ++j ) if( rnd()%4 == 0 ) c.connect( j, i, rndAdm() );
+    }
+    return c;
+}
+
+template<typename F> static double nsPerCall( F f )
+{
+    int reps = 1;
+    while( true ){
+        auto t0 = std::chrono::steady_clock::now();
+        for( int i=0; i<reps; ++i ) f();
+        double ns = std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now()-t0 ).count();
+        if( ns > 2e8 ) return ns/reps;
+        reps *= 2;
+    }
+}
+
+static void bench( const char* name, const Circuit& c )
+{
+    int n = c.n;
+    int stride = (n+7) & ~7;
+    std::vector<double> dense( 2*stride*n + 8 );
+    double* a  = (double*)(((uintptr_t)dense.data()+63) & ~(uintptr_t)63); // Aligned rows, as CircMatrix
+    double* lu = a + stride*n;
+    for( int i=0; i<n; ++i ) for( int j=0; j<n; ++j ) a[i*stride+j] = c.a[i][j];
+
+    std::vector<double> b( stride ), xd( stride ), xs( n );
+    for( int i=0; i<n; ++i ) b[i] = (i%5)-2;
+
+    std::vector<std::vector<int>> pattern = c.pattern;
+    int nonZeros = 0;
+    for( int i=0; i<n; ++i ){ pattern[i].push_back( i ); nonZeros += pattern[i].size(); }
+    bool tooDense = n < 8 || (double)nonZeros/((double)n*n)*std::sqrt( (double)n ) > 2; // Auto: no analyze
+
+    SparseLU sparse;
+    double analyzeNs = nsPerCall( [&](){ sparse.analyze( n, pattern ); } );
+    for( int i=0; i<n; ++i ) for( int j=0; j<n; ++j )
+        if( double* e = sparse.element( i, j ) ) *e = c.a[i][j];
+
+    double denseNs  = nsPerCall( [&](){ LuKernel::factor( a, lu, n, stride, 0 ); LuKernel::solve( lu, n, stride, b.data(), xd.data() ); } );
+    double sparseNs = nsPerCall( [&](){ sparse.factor( 0 ); sparse.solve( b.data(), xs.data() ); } );
+
+    bool autoSparse = !tooDense && 4*sparse.factorOps() <= (double)n*n*n/3;
+
+    double diff = 0;
+    for( int i=0; i<n; ++i ) diff = std::fmax( diff, std::fabs( xd[i]-xs[i] ) );
+
+    printf("%-7s %4d %6d %12.0f %12.0f %7.1fx %-7s %12.0f%s %9.1e\n", name, n, sparse.nonZeros(),
+           denseNs, sparseNs, denseNs/sparseNs, autoSparse ? "sparse" : "dense", analyzeNs, tooDense ? "*" : " ", diff );
+}
+
+int main()
+{
+    LuKernel::init();
+    printf("Dense kernel: %s\n\n", LuKernel::name( LuKernel::kernel() ) );
+    printf("%-7s %4s %6s %12s %12s %8s %-7s %12s %9s\n", "Matrix", "n", "LU nnz", "Dense(ns)", "Sparse(ns)", "Speedup", "Auto", "Analyze(ns)", "Max diff");
+
+    const int sizes[] = { 16, 32, 64, 128, 256, 512 };
+    for( int n : sizes ) bench("ladder", ladder( n ) );
+    for( int n : sizes ) bench("grid",   grid( n ) );
+    for( int n : sizes ) bench("filled", filled( n ) );
+}
@@ -0,0 +1,32 @@
+; Z80 execution mode benchmark
+;
+; Memory loop with indexed access, calls and one OUT per pass.
+; Run it with Int_Memory on (whole instruction mode) and with
+; Int_Memory off and an external 64K RAM, compare MIPS.
+
+        org  0000h
+        ld   sp, 0000h      ; Stack at top of memory
+start:
+        ld   hl, 8000h
+        ld   bc, 0100h
+loop:
+        ld   a, (hl)        ; Memory read
+        add  a, c
+        ld   (hl), a        ; Memory write
+        inc  hl
+        dec  bc
+        ld   a, b
+        or   c
+        jr   nz, loop
+
+        ld   a, (8000h)
+        out  (00h), a       ; I/O write: runs in TState machine
+        call sub
+        jr   start
+
+sub:
+        push hl
+        ld   ix, 8000h
+        inc  (ix+1)         ; Indexed read-modify-write
+        pop  hl
+        ret
@@ -31,12 +31,7 @@ Amperimeter::Amperimeter( QString type, QString id )
 }
 Amperimeter::~Amperimeter(){}
 
-void Amperimeter::updateStep()
+double Amperimeter::measure()
 {
-    double curr = current();
-    
-    if( curr != m_dispValue )
-    {
-        m_dispValue = curr;
-        Meter::updateStep();
-}   }
+    return current();
+}
@@ -18,5 +18,6 @@ class Amperimeter : public Meter
  static Component* construct( QString type, QString id );
  static LibraryItem* libraryItem();
 
-        void updateStep() override;
+    protected:
+        double measure() override;
 };
@@ -23,6 +23,9 @@ Meter::Meter( QString type, QString id )
     m_area = QRectF( -24, -24, 50, 32 );
     m_graphical = true;
     m_switchPins = false;
+    m_dispValue  = 0;
+    m_shownValue = 0;
+    m_concurrent = true;
 
     m_pin.resize( 3 );
     m_ePin[0] = m_pin[0] = new Pin( 270, QPoint(-8, 16), id+"-lPin", 0, this);
@@ -58,17 +61,44 @@ bool Meter::propNotFound( QString prop, QString val )
     return false;
 }
 
+void Meter::stamp()
+{
+    eResistor::stamp();
+    Simulator::self()->addEvent( Simulator::self()->psPerFrame(), this );
+}
+
+void Meter::runEvent() // Output pin updated once per frame
+{
+    double value = measure();
+    if( value != m_dispValue )
+    {
+        m_dispValue = value;
+        m_outPin->setOutHighV( m_dispValue );
+        m_outPin->setOutState( true );
+    }
+    Simulator::self()->addEvent( Simulator::self()->psPerFrame(), this );
+}
+
+void Meter::publish() // Simulation thread
+{
+    m_value.write( measure() );
+}
+
 void Meter::updateStep()
 {
+    double dispValue = m_value.read();
+    if( dispValue == m_shownValue ) return;
+    m_shownValue = dispValue;
+
     QString sign = " ";
     QString mult = " ";
     int decimals = 3;
-    double value = qFabs(m_dispValue);
+    double value = qFabs( dispValue );
 
     if( value < 1e-9 ) value = 0;
     else{
         value *= 1e12;
-        if( m_dispValue < 0 ) sign = "-";
+        if( dispValue < 0 ) sign = "-";
         valToUnit( value, mult, decimals )
     }
     if( value > 999 )
@@ -77,9 +107,6 @@ void Meter::updateStep()
         m_crashed = true;
     }
     else m_display.setText( sign+QString::number( value,'f', decimals ).left(5)+"\n"+mult+m_unit );
-
-    m_outPin->setOutHighV( m_dispValue );
-    m_outPin->setOutState( true );
 }
 
 void Meter::setSwitchPins( bool s )
@@ -22,6 +22,9 @@ class Meter : public Component, public eResistor
         void setSwitchPins( bool s );
 
         void initialize() override { m_crashed = false;}
+        void stamp() override;
+        void runEvent() override;
+        void publish() override;
         void updateStep() override;
 
         void paint( QPainter* p, const QStyleOptionGraphicsItem* o, QWidget* w ) override;
@@ -29,8 +32,12 @@ class Meter : public Component, public eResistor
     protected:
         void setflip() override;
 
+        virtual double measure()=0;  // Simulation thread
+
         QString m_unit;
-        double m_dispValue;
+        double m_dispValue;          // Value in output pin
+        double m_shownValue;         // Value in display
+        Published<double> m_value;
         bool m_switchPins;
 
         IoPin* m_outPin;
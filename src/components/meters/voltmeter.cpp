@@ -31,12 +31,7 @@ Voltimeter::Voltimeter( QString type, QString id )
 }
 Voltimeter::~Voltimeter(){}
 
-void Voltimeter::updateStep()
+double Voltimeter::measure()
 {
-    double volt = m_ePin[0]->getVoltage()-m_ePin[1]->getVoltage();
-    
-    if( volt != m_dispValue )
-    {
-        m_dispValue = volt;
-        Meter::updateStep();
-}   }
+    return m_ePin[0]->getVoltage()-m_ePin[1]->getVoltage();
+}
@@ -100,7 +100,7 @@ void TestUnit::updateStep()
 
     CircuitWidget::self()->powerCircOff();
     bool testOk = m_truthTable->checkThruth( &m_samples );
-    if( !BatchTest::isRunning() ) BatchTest::testCompleted( this, testOk );
+    if( BatchTest::isRunning() ) BatchTest::testCompleted( this, testOk );
 }
 
 void TestUnit::runEvent() // Running test
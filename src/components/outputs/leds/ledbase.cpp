@@ -30,6 +30,8 @@ LedBase::LedBase( QString type, QString id )
     m_graphical = true;
     m_grounded  = false;
     m_intensity = 0;
+    m_dispIntensity = 0;
+    m_concurrent = true;
 
     m_color = QColor( Qt::black );
     setColorStr("Yellow");
@@ -68,28 +70,37 @@ void LedBase::initialize()
     update();
 }
 
-void LedBase::updateStep()
+void LedBase::publish() // Simulation thread
 {
-    uint32_t intensity = m_intensity;
     eLed::updateBright();
 
-    if( overCurrent() > 1.5 )
+    if( m_changed )
+    {
+        m_changed = false;
+        voltChanged();
+    }
+    m_ledState.write( { m_intensity, overCurrent() } );
+}
+
+void LedBase::updateStep()
+{
+    ledState_t state = m_ledState.read();
+
+    if( state.overCurrent > 1.5 )
     {
         m_warning = true;
-        m_crashed = overCurrent() > 2;
+        m_crashed = state.overCurrent > 2;
         update();
     }else{
         if( m_warning ) update();
         m_warning = false;
         m_crashed = false;
     }
-    if( intensity != m_intensity ) update();
-    if( m_changed )
+    if( state.intensity != m_dispIntensity )
     {
-        m_changed = false;
-        voltChanged();
-    }
-}
+        m_dispIntensity = state.intensity;
+        update();
+}   }
 
 void LedBase::setGrounded( bool grounded )
 {
@@ -169,7 +180,7 @@ void LedBase::paint( QPainter* p, const QStyleOptionGraphicsItem* o, QWidget* w
         foreColor = QColor( Qt::white );
         pen.setColor( foreColor );
     }else{
-        foreColor = getColor( m_ledColor, m_intensity );
+        foreColor = getColor( m_ledColor, m_dispIntensity );
         int over = m_overBright*2;
         backColor = QColor( over, over, m_overBright );
     }
@@ -34,6 +34,7 @@ class LedBase : public Component, public eLed
         void setGrounded( bool grounded );
 
         virtual void initialize() override;
+        virtual void publish() override;
         virtual void updateStep() override;
 
  static QColor getColor( ledColor_t c, int bright );
@@ -45,6 +46,13 @@ class LedBase : public Component, public eLed
         virtual void drawBackground( QPainter* p )=0;
         virtual void drawForeground( QPainter* p )=0;
         
+        struct ledState_t{
+            uint32_t intensity;
+            double overCurrent;
+        };
+        Published<ledState_t> m_ledState; // Published by simulation thread
+        uint32_t m_dispIntensity;         // Intensity painted
+
         bool   m_grounded;
 
  static int m_overBright;
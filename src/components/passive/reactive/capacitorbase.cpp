@@ -40,6 +40,13 @@ CapacitorBase::CapacitorBase( QString type, QString id )
 }
 CapacitorBase::~CapacitorBase(){}
 
+double CapacitorBase::updtCurr()
+{
+    double curr = histVolt()*m_admit;
+    if( m_integration == intTRAPEZOIDAL ) curr += m_current;
+    return curr;
+}
+
 void CapacitorBase::setCurrentValue( double c )
 {
     m_capacitance = c;
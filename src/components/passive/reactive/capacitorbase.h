@@ -16,8 +16,8 @@ class CapacitorBase : public Reactive
         void setCurrentValue( double c ) override;
 
     protected:
-        double updtRes()  override { return m_tStep/m_capacitance; }
-        double updtCurr() override { return m_volt*m_admit; }
+        double updtRes()  override { return m_tStep/(m_capacitance*m_intK); }
+        double updtCurr() override;
 
         double m_capacitance;
 };
@@ -56,6 +56,13 @@ Inductor::Inductor( QString type, QString id )
 }
 Inductor::~Inductor(){}
 
+double Inductor::updtCurr()
+{
+    double curr = histCurr();
+    if( m_integration == intTRAPEZOIDAL ) curr += m_volt*m_admit;
+    return -curr;
+}
+
 void Inductor::setCurrentValue( double c )
 {
     m_inductance = c;
@@ -18,7 +18,7 @@ class Inductor : public Reactive
  static Component* construct( QString type, QString id );
  static LibraryItem* libraryItem();
 
-        double indCurrent() { return m_curSource; }
+        double indCurrent() { return -m_current; }
 
         virtual void setCurrentValue( double c ) override;
 
@@ -27,8 +27,8 @@ class Inductor : public Reactive
         virtual void paint( QPainter* p, const QStyleOptionGraphicsItem* o, QWidget* w ) override;
 
     protected:
-        double updtRes()  override { return m_inductance/m_tStep; }
-        double updtCurr() override { return m_curSource - m_volt*m_admit; }
+        double updtRes()  override { return m_inductance*m_intK/m_tStep; }
+        double updtCurr() override;
 
         double m_inductance;
 };
@@ -12,6 +12,7 @@
 #include "circuitwidget.h"
 #include "componentlist.h"
 #include "analogclock.h"
+#include "circmatrix.h"
 
 AppDialog::AppDialog( QWidget* parent )
          : QDialog( parent )
@@ -80,7 +81,11 @@ AppDialog::AppDialog( QWidget* parent )
     realStepUnitBox->setCurrentIndex( unit );
 
     nlStepsBox->setValue( Simulator::self()->maxNlSteps() );
+    freeRunBox->setChecked( Simulator::self()->freeRun() );
     slopeStepsBox->setValue( Simulator::self()->slopeSteps() );
+    solverBox->setCurrentIndex( (int)CircMatrix::self()->solver() );
+    threadsBox->setValue( CircMatrix::self()->threads() );
+    threadMinBox->setValue( CircMatrix::self()->threadMin() );
     m_blocked = false;
 
     updtSpeedPer();
@@ -280,6 +285,12 @@ void AppDialog::updtSpeedPer()
     updtSpeed();
 }
 
+void AppDialog::on_freeRunBox_toggled( bool free )
+{
+    if( m_blocked ) return;
+    Simulator::self()->setFreeRun( free );
+}
+
 void AppDialog::on_nlStepsBox_editingFinished()
 {
     Simulator::self()->setMaxNlSteps( nlStepsBox->value() );
@@ -321,6 +332,22 @@ void AppDialog::on_slopeStepsBox_editingFinished()
     Simulator::self()->setSlopeSteps( slopeStepsBox->value() );
 }
 
+void AppDialog::on_solverBox_currentIndexChanged( int index )
+{
+    if( m_blocked ) return;
+    CircMatrix::self()->setSolver( (solver_t)index );
+}
+
+void AppDialog::on_threadsBox_editingFinished()
+{
+    CircMatrix::self()->setThreads( threadsBox->value() );
+}
+
+void AppDialog::on_threadMinBox_editingFinished()
+{
+    CircMatrix::self()->setThreadMin( threadMinBox->value() );
+}
+
 void AppDialog::on_fontName_currentFontChanged( const QFont &f )
 {
     MainWindow::self()->setDefaultFontName( f.family() );
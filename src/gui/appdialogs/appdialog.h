@@ -48,6 +48,7 @@ class AppDialog : public QDialog, private Ui::AppDialog
 
         // Simulation Settings
         void on_simSpeedPerSlider_valueChanged( int speed );
+        void on_freeRunBox_toggled( bool free );
 
         void on_simStepUnitBox_currentIndexChanged( int index );
         void on_simStepBox_editingFinished();
@@ -59,6 +60,10 @@ class AppDialog : public QDialog, private Ui::AppDialog
 
         void on_slopeStepsBox_editingFinished();
 
+        void on_solverBox_currentIndexChanged( int index );
+        void on_threadsBox_editingFinished();
+        void on_threadMinBox_editingFinished();
+
     private slots:
         void on_fontName_currentFontChanged( const QFont &f );
 
@@ -13,6 +13,7 @@
 #include "simulator.h"
 #include "itemlibrary.h"
 #include "analogclock.h"
+#include "circmatrix.h"
 #include "mainwindow.h"
 #include "circuitwidget.h"
 #include "comproperty.h"
@@ -165,9 +166,9 @@ Pin* Circuit::findPin( int x, int y, QString id )
     return nullptr;
 }
 
-void Circuit::loadCircuit( QString filePath )
+bool Circuit::loadCircuit( QString filePath )
 {
-    if( m_conStarted ) return;
+    if( m_conStarted ) return false;
 
     m_busy = true;
     m_loading = true;
@@ -180,12 +181,15 @@ void Circuit::loadCircuit( QString filePath )
     m_busy = false;
     m_loading = false;
 
-    if( m_error != 0 ) clearCircuit();
-    else{
-        m_graphicView->zoomToFit();
-        qDebug() << "Circuit Loaded: ";
-        qDebug() << filePath;
-}   }
+    if( m_error != 0 ){
+        clearCircuit();
+        return false;
+    }
+    m_graphicView->zoomToFit();
+    qDebug() << "Circuit Loaded: ";
+    qDebug() << filePath;
+    return true;
+}
 
 void Circuit::loadStrDoc( QString &doc )
 {
@@ -372,7 +376,14 @@ void Circuit::loadStrDoc( QString &doc )
                 if     ( prop.name == "stepSize") m_simulator->setStepSize( prop.value.toULongLong() );
                 else if( prop.name == "stepsPS" ) m_simulator->setStepsPerSec(prop.value.toULongLong() );
                 else if( prop.name == "NLsteps" ) m_simulator->setMaxNlSteps( prop.value.toUInt() );
+                else if( prop.name == "NLabsTol") m_simulator->setNlAbsTol( prop.value.toDouble() );
+                else if( prop.name == "NLrelTol") m_simulator->setNlRelTol( prop.value.toDouble() );
+                else if( prop.name == "freeRun" ) m_simulator->setFreeRun( prop.value.toInt() );
                 else if( prop.name == "reaStep" ) AnalogClock::self()->setPeriod( prop.value.toULongLong() );
+                else if( prop.name == "reaMin"  ) AnalogClock::self()->setMinStep( prop.value.toULongLong() );
+                else if( prop.name == "reaMax"  ) AnalogClock::self()->setMaxStep( prop.value.toULongLong() );
+                else if( prop.name == "reaInteg") AnalogClock::self()->setIntegration( (integration_t)prop.value.toInt() );
+                else if( prop.name == "solver"  ) CircMatrix::self()->setSolver( (solver_t)prop.value.toInt() );
                 else if( prop.name == "animate" ) m_animateLogic = prop.value.toInt();
                 else if( prop.name == "anicurr" ) m_animateCurr = prop.value.toInt();
                 else if( prop.name == "ansi"    ) m_ansiSymbols = prop.value.toInt();
@@ -440,7 +451,14 @@ QString Circuit::circuitHeader()
     header += "stepSize=\""+ QString::number( m_simulator->stepSize() )+"\" ";
     header += "stepsPS=\"" + QString::number( m_simulator->stepsPerSec() )+"\" ";
     header += "NLsteps=\"" + QString::number( m_simulator->maxNlSteps() )+"\" ";
+    header += "NLabsTol=\""+ QString::number( m_simulator->nlAbsTol() )+"\" ";
+    header += "NLrelTol=\""+ QString::number( m_simulator->nlRelTol() )+"\" ";
+    header += "freeRun=\"" + QString::number( m_simulator->freeRun() ? 1 : 0 )+"\" ";
     header += "reaStep=\"" + QString::number( AnalogClock::self()->getPeriod() )+"\" ";
+    header += "reaMin=\""  + QString::number( AnalogClock::self()->minStep() )+"\" ";
+    header += "reaMax=\""  + QString::number( AnalogClock::self()->maxStep() )+"\" ";
+    header += "reaInteg=\""+ QString::number( AnalogClock::self()->integration() )+"\" ";
+    header += "solver=\""  + QString::number( CircMatrix::self()->solver() )+"\" ";
     header += "animate=\"" + QString::number( m_animateLogic ? 1 : 0 )+"\" ";
     header += "anicurr=\"" + QString::number( m_animateCurr ? 1 : 0 )+"\" ";
     header += "ansi=\""    + QString::number( m_ansiSymbols ? 1 : 0 )+"\" ";
@@ -85,7 +85,7 @@ class Circuit : public QGraphicsScene
         Pin* findPin( int x, int y, QString id );
         Pin* findPin( QString id );
 
-        void loadCircuit( QString filePath );
+        bool loadCircuit( QString filePath ); // false if not loaded
         bool saveCircuit( QString filePath );
 
         QString newSceneId() { return QString::number(++m_seqNumber); }
@@ -327,19 +327,19 @@ void CircuitWidget::openCirc()
     loadCirc( fileName );
 }
 
-void CircuitWidget::loadCirc( QString path )
+bool CircuitWidget::loadCirc( QString path )
 {
     if( path.isEmpty() || !(path.endsWith(".sim2") || path.endsWith(".sim1")) )
-        return;
+        return false;
 
-    if( !newCircuit() ) return;
-    Circuit::self()->loadCircuit( path );
+    if( !newCircuit() ) return false;
+    if( !Circuit::self()->loadCircuit( path ) ) return false;
 
     m_curCirc = path;
     m_lastCircDir = path;
     MainWindow::self()->setFile(path.split("/").last());
 
-    if( m_hideGui ) return;
+    if( m_hideGui ) return true;
 
     QSettings* settings = MainWindow::self()->settings();
     settings->setValue( "lastCircDir", m_lastCircDir );
@@ -347,6 +347,7 @@ void CircuitWidget::loadCirc( QString path )
     updateRecentFiles();
 
     m_infoWidget->setCircTime( 0 );
+    return true;
 }
 
 void CircuitWidget::saveCirc()
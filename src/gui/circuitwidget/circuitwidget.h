@@ -53,7 +53,7 @@ class CircuitWidget : public QWidget
         bool newCircuit();
         void openRecentFile();
         void openCirc();
-        void loadCirc( QString path );
+        bool loadCirc( QString path ); // false if not loaded
         void saveCirc( QString file );
         void saveCirc();
         void saveCircAs();
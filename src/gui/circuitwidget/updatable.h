@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 class Updatable
 {
     public:
@@ -12,4 +15,49 @@ class Updatable
         ~Updatable();
 
         virtual void updateStep(){;}
+
+        // Concurrent Updatables don't need the simulation stopped at updateStep():
+        // publish() is called from the simulation thread at the end of each frame
+        // (or from GUI thread when simulation is not running) and stores display
+        // state in a Published<T>, updateStep() only reads that state.
+        // publish() is called once per frame: pin outputs go in simulation events.
+        virtual void publish(){;}
+        bool concurrent() { return m_concurrent; }
+
+    protected:
+        bool m_concurrent;
+};
+
+// Sequence lock: one writer never waits, readers retry if writer was in the middle.
+// T must be trivially copyable.
+template <class T>
+class Published
+{
+    public:
+        Published() { m_seq = 0; m_data = T(); }
+
+        void write( const T& data ) // Simulation thread
+        {
+            uint32_t seq = m_seq.load( std::memory_order_relaxed );
+            m_seq.store( seq+1, std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_release );
+            m_data = data;
+            m_seq.store( seq+2, std::memory_order_release );
+        }
+        T read() const              // GUI thread
+        {
+            T data;
+            uint32_t seq0, seq1;
+            do{
+                seq0 = m_seq.load( std::memory_order_acquire );
+                data = m_data;
+                std::atomic_thread_fence( std::memory_order_acquire );
+                seq1 = m_seq.load( std::memory_order_relaxed );
+            }while( (seq0 & 1) || seq0 != seq1 );
+            return data;
+        }
+
+    private:
+        std::atomic<uint32_t> m_seq;
+        T m_data;
 };
@@ -225,6 +225,25 @@ void BaseDebugger::pause()
     EditorWindow::self()->pauseAt( m_prevLine );
 }
 
+bool BaseDebugger::stepBack() // Restore Mcu state saved before last step
+{
+    Simulator::self()->holdSim();  // Mcu state only accessed while simulation thread is stopped
+    bool ok = eMcu::self()->rewind();
+    Simulator::self()->releaseSim();
+    if( !ok ) return false;
+
+    m_debugStep = false;
+    m_exitPC = 0;
+
+    int PC = eMcu::self()->cpu()->getPC();
+    if( m_flashToSource.contains( PC ) )
+    {
+        m_prevLine = m_flashToSource.value( PC );
+        EditorWindow::self()->pauseAt( m_prevLine );
+    }
+    return true;
+}
+
 bool BaseDebugger::stepFromLine( bool over )
 {
     bool ok = true;
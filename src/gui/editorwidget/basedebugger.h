@@ -32,6 +32,7 @@ class BaseDebugger : public Compiler    // Base Class for all debuggers
         void pause();
         bool stepFromLine( bool over=false );
         void stepDebug();
+        bool stepBack();
 
         void setLstType( int type ) { m_lstType = type; }
         void setLangLevel( int level ) { m_langLevel = level; }
@@ -46,6 +47,8 @@ class BaseDebugger : public Compiler    // Base Class for all debuggers
         static QString getValueInFile( QString line, QString word );
 
         int flashToSourceSize() { return m_flashToSource.size(); }
+        QMap<int, codeLine_t>* flashToSource() { return &m_flashToSource; }
+        QMap<QString, int>*    functions() { return &m_functions; }
         
         bool m_stepOver;
 
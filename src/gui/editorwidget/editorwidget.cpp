@@ -619,6 +619,7 @@ void EditorWidget::enableDebugActs( bool enable )
     runAct->setEnabled( enable );
     stepAct->setEnabled( enable );
     stepOverAct->setEnabled( enable );
+    stepBackAct->setEnabled( enable );
     pauseAct->setEnabled( enable );
     resetAct->setEnabled( enable );
     stopAct->setEnabled( enable );
@@ -631,6 +632,7 @@ void EditorWidget::setStepActs( bool s )
     runAct->setEnabled( s );
     stepAct->setEnabled( s );
     stepOverAct->setEnabled( s );
+    stepBackAct->setEnabled( s );
     resetAct->setEnabled( s );
     pauseAct->setEnabled( !s );
 }
@@ -764,6 +766,11 @@ void EditorWidget::createActions()
     stepOverAct->setVisible(false);
     connect( stepOverAct, SIGNAL(triggered()), this, SLOT(stepOver()), Qt::UniqueConnection );
 
+    stepBackAct = new QAction(QIcon(":/rotateccw.svg"),tr("Step Back"), this);
+    stepBackAct->setStatusTip(tr("Go back to previous step"));
+    stepBackAct->setEnabled(false);
+    connect( stepBackAct, SIGNAL(triggered()), this, SLOT(stepBack()), Qt::UniqueConnection );
+
     pauseAct = new QAction(QIcon(":/pause.svg"),tr("Pause"), this);
     pauseAct->setStatusTip(tr("Pause debugger"));
     pauseAct->setEnabled(false);
@@ -798,6 +805,29 @@ void EditorWidget::createActions()
     debugAct->setStatusTip(tr("Start Debugger"));
     debugAct->setEnabled(false);
     connect(debugAct, SIGNAL(triggered()), this, SLOT(debug()), Qt::UniqueConnection);
+
+    profileAct = new QAction(QIcon(":/blank.png"), tr("Profile Firmware"), this);
+    profileAct->setStatusTip(tr("Count Mcu cycles by address and function"));
+    profileAct->setCheckable( true );
+    connect( profileAct, SIGNAL(triggered()), this, SLOT(profile()), Qt::UniqueConnection );
+
+    profReportAct = new QAction(QIcon(":/blank.png"), tr("Profile Report"), this);
+    profReportAct->setStatusTip(tr("Show profile in output panel"));
+    connect( profReportAct, SIGNAL(triggered()), this, SLOT(profileReport()), Qt::UniqueConnection );
+
+    profSaveAct = new QAction(QIcon(":/blank.png"), tr("Save Flame Graph..."), this);
+    profSaveAct->setStatusTip(tr("Save profile as collapsed stacks"));
+    connect( profSaveAct, SIGNAL(triggered()), this, SLOT(saveProfile()), Qt::UniqueConnection );
+}
+
+QToolButton* EditorWidget::profileButton()
+{
+    QToolButton* profButton = new QToolButton( this );
+    profButton->setToolTip( tr("Profiler") );
+    profButton->setMenu( &m_profileMenu );
+    profButton->setIcon( QIcon(":/list.svg") );
+    profButton->setPopupMode( QToolButton::InstantPopup );
+    return profButton;
 }
 
 void EditorWidget::createToolBars()
@@ -845,16 +875,23 @@ void EditorWidget::createToolBars()
     m_compileToolBar->setIconSize( QSize( fs, fs ) );
     m_compileToolBar->addAction(compileAct);
     m_compileToolBar->addAction(loadAct);
+    m_profileMenu.addAction( profileAct );
+    m_profileMenu.addAction( profReportAct );
+    m_profileMenu.addAction( profSaveAct );
+
     m_compileToolBar->addSeparator();
     m_compileToolBar->addAction(debugAct);
+    m_compileToolBar->addWidget( profileButton() );
 
     m_debuggerToolBar = new QToolBar( this );
     m_debuggerToolBar->setIconSize( QSize( fs, fs ) );
     m_debuggerToolBar->addAction(stepAct);
     m_debuggerToolBar->addAction(stepOverAct);
+    m_debuggerToolBar->addAction(stepBackAct);
     m_debuggerToolBar->addAction(runAct);
     m_debuggerToolBar->addAction(pauseAct);
     m_debuggerToolBar->addAction(resetAct);
+    m_debuggerToolBar->addWidget( profileButton() );
     m_debuggerToolBar->addSeparator();
     m_debuggerToolBar->addAction(stopAct);
     m_debuggerToolBar->setVisible( false );
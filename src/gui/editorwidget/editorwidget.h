@@ -7,6 +7,7 @@
 
 #include <QWidget>
 #include <QMenu>
+#include <QToolButton>
 
 #include "compbase.h"
 #include "codeeditor.h"
@@ -94,11 +95,16 @@ class EditorWidget : public QWidget, public CompBase
         virtual void debug(){;}
         virtual void step(){;}
         virtual void stepOver(){;}
+        virtual void stepBack(){;}
         virtual void reset() {;}
         void compile() { getCodeEditor()->compile(); } /// m_compiler.compile( getCodeEditor()->getFilePath() );
 
         virtual bool upload() {return false;}
 
+        virtual void profile(){;}
+        virtual void profileReport(){;}
+        virtual void saveProfile(){;}
+
     protected:
         void docShowSpaces( CodeEditor* ce );
 
@@ -113,6 +119,7 @@ class EditorWidget : public QWidget, public CompBase
         void createWidgets();
         void createActions();
         void createToolBars();
+        QToolButton* profileButton();
 
         void readSettings();
         void writeSettings();
@@ -151,6 +158,7 @@ class EditorWidget : public QWidget, public CompBase
 
         QMenu m_settingsMenu;
         QMenu m_fileMenu;
+        QMenu m_profileMenu;
 
         QToolBar* m_editorToolBar;
         QToolBar* m_findToolBar;
@@ -179,6 +187,7 @@ class EditorWidget : public QWidget, public CompBase
         
         QAction* stepAct;
         QAction* stepOverAct;
+        QAction* stepBackAct;
         QAction* runAct;
         QAction* pauseAct;
         QAction* resetAct;
@@ -186,4 +195,7 @@ class EditorWidget : public QWidget, public CompBase
         QAction* compileAct;
         QAction* loadAct;
         QAction* findQtAct;
+        QAction* profileAct;
+        QAction* profReportAct;
+        QAction* profSaveAct;
 };
@@ -6,11 +6,14 @@
 #include <QDomDocument>
 #include <QSettings>
 #include <QTimer>
+#include <QFileDialog>
+#include <QFileInfo>
 
 #include "editorwindow.h"
 #include "circuitwidget.h"
 #include "mainwindow.h"
 #include "mcu.h"
+#include "mcuprofiler.h"
 #include "simulator.h"
 #include "compiler.h"
 #include "utils.h"
@@ -22,6 +25,8 @@
 #include "sdccdebugger.h"
 #include "asdebugger.h"
 
+#define DEBUG_HISTORY 256 // Steps that can be undone
+
 
 EditorWindow* EditorWindow::m_pSelf = nullptr;
 
@@ -89,10 +94,127 @@ bool EditorWindow::uploadFirmware( bool debug )
 
     bool ok = ce->compile( debug );
     if( ok ) ok = ce->getCompiler()->upload();
+    if( ok && profileAct->isChecked() )
+    {
+        Simulator::self()->holdSim();
+        setProfileFunctions();
+        Simulator::self()->releaseSim();
+    }
 
     return ok;
 }
 
+void EditorWindow::profile()
+{
+    eMcu* mcu = eMcu::self();
+    if( !mcu )
+    {
+        profileAct->setChecked( false );
+        m_outPane.appendLine( "\n"+tr("Error: No Mcu in Simulator... ")+"\n" );
+        return;
+    }
+    bool profiling = profileAct->isChecked();
+
+    Simulator::self()->holdSim();  // Profiler only accessed while simulation thread is stopped
+    mcu->setProfiling( profiling );
+    if( profiling ) setProfileFunctions();
+    Simulator::self()->releaseSim();
+
+    if( !profiling ) return;
+    m_outPane.appendLine( "\n"+tr("Profiling ")+mcu->getId()+"\n" );
+}
+
+void EditorWindow::setProfileFunctions() // Simulation thread must be stopped
+{
+    McuProfiler* profiler = eMcu::self() ? eMcu::self()->profiler() : nullptr;
+    if( !profiler ) return;
+
+    BaseDebugger* debugger = m_debugger;
+    if( !debugger && getCodeEditor() ) debugger = getCodeEditor()->getCompiler();
+    if( !debugger ) return;
+
+    QMap<int, QString> functions;
+    QMap<QString, int>* funcMap = debugger->functions();
+    for( QString name : funcMap->keys() )
+    {
+        int address = funcMap->value( name );
+        if( address >= 0 ) functions[address] = name;
+    }
+    profiler->setFunctions( functions );
+}
+
+void EditorWindow::profileReport()
+{
+    McuProfiler* profiler = eMcu::self() ? eMcu::self()->profiler() : nullptr;
+    if( !profiler )
+    {
+        m_outPane.appendLine( "\n"+tr("Profiler not active")+"\n" );
+        return;
+    }
+    Simulator::self()->holdSim();  // Copy profile data while simulation thread is stopped
+    QString report = profiler->report();
+    std::vector<uint64_t> pcCycles = profiler->pcCycles();
+    uint64_t total = profiler->totalCycles();
+    Simulator::self()->releaseSim();
+
+    m_outPane.appendLine( "-------------------------------------------------------\n" );
+    m_outPane.appendLine( report );
+
+    BaseDebugger* debugger = m_debugger;
+    if( !debugger && getCodeEditor() ) debugger = getCodeEditor()->getCompiler();
+    if( !debugger || !debugger->flashToSourceSize() ) return;
+
+    QMap<int, codeLine_t>* flashToSource = debugger->flashToSource();
+    QMap<QString, uint64_t> lineCycles;          // "file:line" -> cycles
+
+    for( uint32_t pc=0; pc<pcCycles.size(); ++pc )
+    {
+        if( !pcCycles[pc] ) continue;
+        auto it = flashToSource->upperBound( pc );
+        if( it == flashToSource->begin() ) continue;
+        --it;
+        codeLine_t line = it.value();
+        QString key = QFileInfo( line.file ).fileName()+":"+QString::number( line.lineNumber );
+        lineCycles[key] += pcCycles[pc];
+    }
+    QMultiMap<uint64_t, QString> sorted;
+    for( QString key : lineCycles.keys() ) sorted.insert( lineCycles.value( key ), key );
+
+    m_outPane.appendLine( tr("Source lines:") );
+    int n = 0;
+    for( auto it = sorted.end(); it != sorted.begin() && n<20; ++n )
+    {
+        --it;
+        double pct = total ? 100.0*it.key()/total : 0;
+        m_outPane.appendLine( "  "+it.value().leftJustified( 30 )
+                            +QString::number( it.key() ).rightJustified( 14 )
+                            +QString::number( pct, 'f', 1 ).rightJustified( 7 )+" %" );
+    }
+    m_outPane.appendLine( "" );
+}
+
+void EditorWindow::saveProfile()
+{
+    McuProfiler* profiler = eMcu::self() ? eMcu::self()->profiler() : nullptr;
+    if( !profiler )
+    {
+        m_outPane.appendLine( "\n"+tr("Profiler not active")+"\n" );
+        return;
+    }
+    QString fileName = QFileDialog::getSaveFileName( MainWindow::self(), tr("Save Flame Graph")
+                                                   , m_lastDir, tr("Collapsed Stacks")+" (*.folded)" );
+    if( fileName.isEmpty() ) return;
+    if( !fileName.endsWith(".folded") ) fileName.append(".folded");
+
+    Simulator::self()->holdSim();
+    profiler = eMcu::self() ? eMcu::self()->profiler() : nullptr; // Could change while in dialog
+    bool saved = profiler && profiler->saveCollapsed( fileName );
+    Simulator::self()->releaseSim();
+
+    if( saved ) m_outPane.appendLine( tr("Profile saved to ")+fileName+"\n" );
+    else m_outPane.appendLine( tr("Error: could not save ")+fileName+"\n" );
+}
+
 void EditorWindow::debug()
 {
     m_outPane.appendLine( "-------------------------------------------------------\n" );
@@ -119,6 +241,20 @@ void EditorWindow::stepOver()
     stepDebug( true );
 }
 
+void EditorWindow::stepBack()
+{
+    if( m_state != DBG_PAUSED ) return;
+
+    if( !m_debugger->stepBack() )
+    {
+        m_outPane.appendLine( tr("No previous step to go back to")+"\n" );
+        return;
+    }
+    m_lastCycle = eMcu::self()->cycle();
+    m_lastTime  = Simulator::self()->circTime()/1e6;
+    updateStep();
+}
+
 void EditorWindow:: pause()
 {
     if( m_state < DBG_STEPING ) return;
@@ -169,6 +305,7 @@ void EditorWindow::initDebbuger()
 
         stepOverAct->setVisible( true /*m_stepOver*/ );
         eMcu::self()->setDebugging( true );
+        eMcu::self()->setHistorySize( DEBUG_HISTORY );
         reset();
 
         m_outPane.appendLine("\n"+tr("Debugger Started")+"\n");
@@ -179,6 +316,7 @@ void EditorWindow::initDebbuger()
         runAct->setEnabled( true );
         stepAct->setEnabled( true );
         stepOverAct->setEnabled( true );
+        stepBackAct->setEnabled( true );
         resetAct->setEnabled( true );
         pauseAct->setEnabled( false );
 
@@ -193,6 +331,10 @@ void EditorWindow::stepDebug( bool over )
 {
     if( m_state == DBG_RUNNING ) return;
 
+    Simulator::self()->holdSim();  // Mcu state only accessed while simulation thread is stopped
+    eMcu::self()->saveHistory();
+    Simulator::self()->releaseSim();
+
     if( m_debugger->stepFromLine( over ) )
     {
         setStepActs( false );
@@ -226,7 +368,11 @@ void EditorWindow::stopDebbuger()
     if( m_state > DBG_STOPPED )
     {
         CircuitWidget::self()->powerCircOff();
-        if( eMcu::self() ) eMcu::self()->setDebugging( false );
+        if( eMcu::self() )
+        {
+            eMcu::self()->setDebugging( false );
+            eMcu::self()->setHistorySize( 0 );
+        }
 
         m_state = DBG_STOPPED;
         m_debugDoc->stopDebug();
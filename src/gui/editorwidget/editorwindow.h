@@ -60,9 +60,14 @@ class EditorWindow : public EditorWidget, public Updatable
         virtual void debug() override;
         virtual void step() override;
         virtual void stepOver() override;
+        virtual void stepBack() override;
         virtual void reset() override;
         virtual bool upload() override;
 
+        virtual void profile() override;
+        virtual void profileReport() override;
+        virtual void saveProfile() override;
+
         void initDebbuger();
 
     private:
@@ -70,6 +75,7 @@ class EditorWindow : public EditorWidget, public Updatable
  static EditorWindow*  m_pSelf;
 
         bool uploadFirmware( bool debug );
+        void setProfileFunctions();
         void stepDebug( bool over=false );
         void stopDebbuger();
 
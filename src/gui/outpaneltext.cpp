@@ -35,7 +35,10 @@ OutPanelText::~OutPanelText(){}
 
 void OutPanelText::appendLine( const QString text )
 {
+    m_bufferMutex.lock();
     m_textBuffer.append( text+"\n" );
+    m_bufferMutex.unlock();
+
     if( !Simulator::self() || !Simulator::self()->isRunning() )
     {
         updateStep();
@@ -43,13 +46,23 @@ void OutPanelText::appendLine( const QString text )
     }
 }
 
+void OutPanelText::appendText( const QString text )
+{
+    QMutexLocker locker( &m_bufferMutex );
+    m_textBuffer.append( text );
+}
+
 void OutPanelText::updateStep()
 {
-    if( m_textBuffer.isEmpty() ) return;
+    m_bufferMutex.lock();
+    QString text = m_textBuffer;
+    m_textBuffer.clear();
+    m_bufferMutex.unlock();
+
+    if( text.isEmpty() ) return;
 
     moveCursor( QTextCursor::End );
-    insertPlainText( m_textBuffer );
-    m_textBuffer.clear();
+    insertPlainText( text );
 
     if( this->document()->characterCount() > 100000 )
         setPlainText( this->toPlainText().right( 90000 ) );
@@ -9,6 +9,7 @@
 #include <QSyntaxHighlighter>
 #include <QRegularExpression>
 #include <QObject>
+#include <QMutex>
 
 #include "updatable.h"
 
@@ -23,11 +24,12 @@ class OutPanelText : public QPlainTextEdit, public Updatable
 
         void updateStep() override;
 
-        void appendText( const QString text ) { m_textBuffer.append( text ); }
+        void appendText( const QString text );
         void appendLine( const QString text );
 
     private:
         QString m_textBuffer;
+        QMutex  m_bufferMutex; // Text can be appended from simulation thread
  
         OutHighlighter* m_highlighter;
 };
@@ -4,11 +4,23 @@
  ***( see copyright.txt file at root folder )*******************************/
 
 #include <QTimer>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QProcess>
+#include <QEventLoop>
+#include <QThread>
+#include <QTextStream>
+#include <QCoreApplication>
 #include <QDebug>
 
 #include "batchtest.h"
 #include "component.h"
 #include "circuitwidget.h"
+#include "simulator.h"
+#include "circuit.h"
+#include "mcu.h"
+#include "cpu8bits.h"
+#include "mcusnapshot.h"
 
 bool BatchTest::m_running = false;
 QString BatchTest::m_currentFile;
@@ -16,6 +28,19 @@ QStringList BatchTest::m_failedTests;
 QStringList BatchTest::m_circFiles;
 QList<Component*> BatchTest::m_testUnits;
 
+QList<BatchTest::testJob_t> BatchTest::m_jobs;
+QEventLoop* BatchTest::m_loop = nullptr;
+QString BatchTest::m_simTime;
+QString BatchTest::m_junitFile;
+int  BatchTest::m_maxJobs = 0;
+int  BatchTest::m_nextJob = 0;
+int  BatchTest::m_runningJobs = 0;
+int  BatchTest::m_timeout = 0;
+bool BatchTest::m_failFast = false;
+bool BatchTest::m_stop = false;
+uint64_t BatchTest::m_checkTime = 0;
+QHash<Mcu*, McuSnapshot*> BatchTest::m_checkpoint;
+
 void BatchTest::doBatchTest( QString folder )
 {
     QDir dir = QDir(folder);
@@ -69,7 +94,13 @@ void BatchTest::runNextCircuit()
     m_currentFile = m_circFiles.takeFirst();
 
     qDebug() << "Testing" << m_currentFile;
-    CircuitWidget::self()->loadCirc( m_currentFile );
+    if( !CircuitWidget::self()->loadCirc( m_currentFile ) || Circuit::self()->compList()->isEmpty() )
+    {
+        qDebug() <<"ERROR: can't load circuit:" << m_currentFile;
+        m_failedTests.append( m_currentFile );
+        runNextCircuit();
+        return;
+    }
 
     m_testUnits.clear();
     CircuitWidget::self()->powerCircOn();
@@ -97,3 +128,375 @@ void BatchTest::testCompleted( Component* c, bool ok ) // A test unit completed
     if( m_testUnits.isEmpty() ) m_running = false; // All test units in this Circuit finished
 }
 
+
+int BatchTest::runCircuit( QString file, uint64_t simTime )
+{
+    QFileInfo info( file );
+    if( !info.exists() || !(file.endsWith(".sim2") || file.endsWith(".sim1")) )
+    {
+        qDebug() <<"ERROR: can't load circuit:" << file;
+        return Run_LoadError;
+    }
+    file = info.absoluteFilePath();
+    m_failedTests.clear();
+    m_testUnits.clear();
+    m_currentFile = file;
+    m_running = true;                // Test Units start testing at stamp()
+
+    qDebug() << "Running" << file;
+    if( !CircuitWidget::self()->loadCirc( file ) || Circuit::self()->compList()->isEmpty() )
+    {
+        qDebug() <<"ERROR: can't load circuit:" << file;
+        m_running = false;
+        return Run_LoadError;
+    }
+
+    Simulator* sim = Simulator::self();
+    sim->setHeadless( true );
+    CircuitWidget::self()->powerCircOn();
+
+    bool hasTests = !m_testUnits.isEmpty();
+    int result = Run_Ok;
+
+    if( !simTime && !hasTests )
+    {
+        qDebug() << "ERROR: no simulation time and no Test Unit in circuit";
+        result = Run_LoadError;
+    }else{
+        QElapsedTimer timer;
+        timer.start();
+
+        uint64_t endTime = simTime ? sim->circTime()+simTime : 0;
+        uint64_t checkTime = 0;
+        int checkMcus = 0;
+
+        bool mcuOnly = true;  // Checkpoint saves Mcus only: nodes, reactive and events are not restored
+        for( Component* comp : *Circuit::self()->compList() )
+            if( !dynamic_cast<Mcu*>( comp ) ){ mcuOnly = false; break; }
+
+        if( m_checkTime && mcuOnly )
+        {
+            if( m_checkTime < simTime ) // Run upto checkpoint and save Mcus
+            {
+                checkTime = sim->circTime()+m_checkTime;
+                sim->runHeadless( checkTime );
+                if( sim->isRunning() ) checkMcus = checkpoint();
+            }
+            else qDebug() << "ERROR: checkpoint needs a simulation time longer than checkpoint time";
+        }
+
+        sim->runHeadless( endTime );
+
+        double wallTime = timer.nsecsElapsed()/1e9;
+        double circTime = (sim->circTime()-1)/1e12;   // Circuit time starts at 1 ps
+
+        qDebug() << "    Wall time:      " << wallTime << "s";
+        qDebug() << "    Simulated time: " << circTime << "s";
+        qDebug() << "    Events:         " << sim->eventCount();
+        qDebug() << "    Matrix solves:  " << sim->solveCount();
+
+        AnalogClock* clock = AnalogClock::self();
+        if( clock->reactSteps() )
+            qDebug() << "    Reactive steps: " << clock->reactSteps() << "," << clock->stepChanges() << "step changes";
+
+        const nlStats_t& nl = sim->nlStats();
+        if( nl.steps || nl.failures )
+            qDebug() << "    NonLinear:      " << nl.steps << "solutions," << nl.iterations << "iterations, max"
+                     << nl.maxIter << "," << nl.gminSteps << "gmin stepping," << nl.failures << "not converged";
+
+        DiodeBatch* diodes = DiodeBatch::self();
+        if( diodes->batches() )
+            qDebug() << "    Diode batches:  " << diodes->batches() << "," << (double)diodes->diodes()/diodes->batches() << "diodes per batch";
+
+        for( Component* comp : *Circuit::self()->compList() )
+        {
+            Mcu* mcu = dynamic_cast<Mcu*>( comp );
+            if( !mcu ) continue;
+            uint64_t insts = mcu->instCount();
+            qDebug() << "    MCU" << mcu->getUid() << insts << "instructions,"
+                     << (wallTime > 0 ? insts/wallTime/1e6 : 0) << "MIPS,"
+                     << mcu->avgBurst() << "instructions per event,"
+                     << mcu->skipCycles() << "cycles skipped in wait loops";
+        }
+
+        if     ( sim->error() )           result = Run_SimError;
+        else if( !m_failedTests.isEmpty() ) result = Run_TestFailed;
+        else if( !m_testUnits.isEmpty() ) result = Run_Timeout;
+
+        if( m_checkTime && !mcuOnly ) qDebug() << "    Checkpoint:      not replayed, only circuits with nothing but MCUs (other state is not saved)";
+        else if( checkMcus < 0 ) qDebug() << "    Checkpoint:      Mcu state can't be saved";
+        else if( checkMcus && !sim->isRunning() ) qDebug() << "    Checkpoint:      not replayed, simulation stopped before end time";
+        else if( checkMcus && result == Run_Ok ) // Restore checkpoint and run again: Mcus must end in the same state
+        {
+            QHash<Mcu*, QPair<uint64_t, uint> > endState;
+            for( Mcu* mcu : m_checkpoint.keys() ) endState[mcu] = qMakePair( mcu->instCount(), mcu->cpu()->getPC() );
+
+            if( !restore() )
+            {
+                qDebug() << "    Checkpoint:      ERROR: Mcu state can't be restored";
+                result = Run_TestFailed;
+            }else{
+                sim->runHeadless( sim->circTime()+endTime-checkTime ); // Simulation time is not restored
+
+                int failed = 0;
+                for( Mcu* mcu : m_checkpoint.keys() )
+                {
+                    if( endState[mcu] == qMakePair( mcu->instCount(), mcu->cpu()->getPC() ) ) continue;
+                    qDebug() << "    Checkpoint:     MCU" << mcu->getUid() << "replay mismatch";
+                    failed++;
+                }
+                qDebug() << "    Checkpoint:     " << checkMcus << "MCUs replayed," << failed << "mismatch";
+                if( failed ) result = Run_TestFailed;
+        }   }
+        for( McuSnapshot* snap : m_checkpoint ) delete snap;
+        m_checkpoint.clear();
+    }
+    CircuitWidget::self()->powerCircOff();
+    sim->setHeadless( false );
+    m_running = false;
+
+    switch( result ){
+        case Run_Ok:         qDebug() << (hasTests ? "Tests passed" : "Simulation completed"); break;
+        case Run_TestFailed: qDebug() << "Tests failed"; break;
+        case Run_SimError:   qDebug() << "Simulation error:" << sim->error(); break;
+        case Run_Timeout:    qDebug() << "Tests not finished"; break;
+        default: break;
+    }
+    return result;
+}
+
+int BatchTest::checkpoint()
+{
+    for( McuSnapshot* snap : m_checkpoint ) delete snap;
+    m_checkpoint.clear();
+
+    for( Component* comp : *Circuit::self()->compList() )
+    {
+        Mcu* mcu = dynamic_cast<Mcu*>( comp );
+        if( !mcu ) continue;
+        McuSnapshot* snap = mcu->saveSnapshot();
+        if( !snap ) return -1;
+        m_checkpoint[mcu] = snap;
+    }
+    return m_checkpoint.size();
+}
+
+bool BatchTest::restore()
+{
+    bool ok = !m_checkpoint.isEmpty();
+    for( Mcu* mcu : m_checkpoint.keys() ) ok &= mcu->loadSnapshot( m_checkpoint.value( mcu ) );
+    return ok;
+}
+
+uint64_t BatchTest::parseTime( QString time )
+{
+    time = time.trimmed().toLower();
+
+    double mult = 1e12;               // Seconds by default
+    QStringList units = { "ps", "ns", "us", "ms", "s" };
+    double mults[] = { 1, 1e3, 1e6, 1e9, 1e12 };
+    for( int i=0; i<units.size(); ++i )
+    {
+        if( !time.endsWith( units.at(i) ) ) continue;
+        time.chop( units.at(i).size() );
+        mult = mults[i];
+        break;
+    }
+    bool ok = false;
+    double value = time.toDouble( &ok );
+    if( !ok || value <= 0 ) return 0;
+
+    return value*mult;
+}
+
+int BatchTest::runParallel( QString folder, int jobs )
+{
+    QDir dir = QDir( folder );
+    if( !dir.exists() )
+    {
+        qDebug() <<"Folder doesn't exist:" << Qt::endl << folder;
+        return Run_LoadError;
+    }
+    m_circFiles.clear();
+    prepareTest( dir );
+
+    m_jobs.clear();
+    for( QString file : m_circFiles )
+    {
+        testJob_t job;
+        job.file    = file;
+        job.process = nullptr;
+        job.time    = 0;
+        job.result  = Run_Skipped;
+        m_jobs.append( job );
+    }
+    if( jobs < 1 ) jobs = QThread::idealThreadCount();
+    m_maxJobs = jobs;
+    m_nextJob = 0;
+    m_runningJobs = 0;
+    m_stop = false;
+
+    qDebug() << "Testing" << m_jobs.size() << "circuits in" << jobs << "processes";
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QEventLoop loop;
+    m_loop = &loop;
+
+    QTimer timeoutTimer;
+    QObject::connect( &timeoutTimer, &QTimer::timeout, BatchTest::checkTimeouts );
+    if( m_timeout ) timeoutTimer.start( 100 );
+
+    for( int i=0; i<m_maxJobs; ++i ) startNextJob();
+    if( m_runningJobs ) loop.exec();
+
+    timeoutTimer.stop();
+    m_loop = nullptr;
+    double totalTime = timer.nsecsElapsed()/1e9;
+
+    int failed = 0;
+    for( const testJob_t& job : m_jobs ) if( job.result != Run_Ok ) failed++;
+
+    if( failed == 0 ) qDebug() << "All tests passed in" << totalTime << "s";
+    else{
+        qDebug() << failed << "Tests failed:";
+        for( const testJob_t& job : m_jobs )
+            if( job.result != Run_Ok ) qDebug() << resultName( job.result ) << job.file;
+    }
+    if( !m_junitFile.isEmpty() ) writeJUnit( folder, totalTime );
+
+    return failed ? Run_TestFailed : Run_Ok;
+}
+
+void BatchTest::startNextJob()
+{
+    if( m_stop || m_nextJob >= m_jobs.size() )
+    {
+        if( m_runningJobs == 0 && m_loop ) m_loop->quit();
+        return;
+    }
+    int index = m_nextJob++;
+    testJob_t& job = m_jobs[index];
+
+    QStringList args = { "-run", job.file };
+    if( !m_simTime.isEmpty() ) args << "-time" << m_simTime;
+
+    QProcess* process = new QProcess();
+    process->setProcessChannelMode( QProcess::MergedChannels );
+    QObject::connect( process, QOverload<int, QProcess::ExitStatus>::of( &QProcess::finished ),
+                      [index]( int code, QProcess::ExitStatus status )
+                      { jobFinished( index, code, status == QProcess::CrashExit ); } );
+    job.process = process;
+    job.result  = Run_Ok;
+    job.timer.start();
+    m_runningJobs++;
+
+    process->start( QCoreApplication::applicationFilePath(), args );
+    if( !process->waitForStarted() ) jobFinished( index, Run_LoadError, false );
+}
+
+void BatchTest::jobFinished( int index, int code, bool crashed )
+{
+    testJob_t& job = m_jobs[index];
+    if( !job.process ) return;
+
+    job.time   = job.timer.nsecsElapsed()/1e9;
+    job.output = QString::fromLocal8Bit( job.process->readAll() );
+    if( job.result != Run_Killed && job.result != Run_Skipped ) job.result = crashed ? Run_Crashed : code;
+
+    job.process->deleteLater();
+    job.process = nullptr;
+    m_runningJobs--;
+
+    qDebug() << resultName( job.result ) << QString::number( job.time, 'f', 2 )+"s" << job.file;
+
+    if( job.result != Run_Ok && m_failFast && !m_stop )
+    {
+        m_stop = true;
+        for( testJob_t& other : m_jobs ) // Stop jobs still running
+        {
+            if( !other.process || other.result == Run_Killed ) continue;
+            other.result = Run_Skipped;
+            other.process->kill();       // finished() will call jobFinished()
+        }
+    }
+    startNextJob();
+}
+
+void BatchTest::checkTimeouts()
+{
+    for( testJob_t& job : m_jobs )
+    {
+        if( !job.process || job.result == Run_Killed ) continue;
+        if( job.timer.elapsed() < m_timeout ) continue;
+
+        job.result = Run_Killed;
+        job.process->kill();       // finished() will call jobFinished()
+    }
+}
+
+QString BatchTest::resultName( int result )
+{
+    switch( result ){
+        case Run_Ok:         return "PASS";
+        case Run_TestFailed: return "FAIL";
+        case Run_SimError:   return "ERROR";
+        case Run_Timeout:    return "NOT FINISHED";
+        case Run_LoadError:  return "LOAD ERROR";
+        case Run_Crashed:    return "CRASHED";
+        case Run_Killed:     return "TIMEOUT";
+        case Run_Skipped:    return "SKIPPED";
+    }
+    return "EXIT "+QString::number( result );
+}
+
+void BatchTest::writeJUnit( QString folder, double time )
+{
+    QFile file( m_junitFile );
+    if( !file.open( QFile::WriteOnly | QFile::Text ) )
+    {
+        qDebug() << "ERROR: can't write JUnit report:" << m_junitFile;
+        return;
+    }
+    int failures = 0, errors = 0, skipped = 0;
+    for( const testJob_t& job : m_jobs )
+    {
+        if     ( job.result == Run_Ok ) continue;
+        else if( job.result == Run_Skipped ) skipped++;
+        else if( job.result == Run_TestFailed || job.result == Run_Timeout ) failures++;
+        else errors++;
+    }
+    QDir dir( folder );
+
+    QTextStream out( &file );
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    out << "<testsuites>\n";
+    out << "  <testsuite name=\"" << dir.dirName().toHtmlEscaped() << "\" tests=\"" << m_jobs.size()
+        << "\" failures=\"" << failures << "\" errors=\"" << errors << "\" skipped=\"" << skipped
+        << "\" time=\"" << time << "\">\n";
+
+    for( const testJob_t& job : m_jobs )
+    {
+        QFileInfo info( dir.relativeFilePath( job.file ) );
+        QString className = info.path() == "." ? dir.dirName() : info.path();
+
+        out << "    <testcase classname=\"" << className.toHtmlEscaped() << "\" name=\""
+            << info.fileName().toHtmlEscaped() << "\" time=\"" << job.time << "\"";
+
+        if( job.result == Run_Ok ) { out << "/>\n"; continue; }
+        out << ">\n";
+
+        QString message = resultName( job.result );
+        if     ( job.result == Run_Skipped ) out << "      <skipped/>\n";
+        else if( job.result == Run_TestFailed || job.result == Run_Timeout )
+             out << "      <failure message=\"" << message << "\"/>\n";
+        else out << "      <error message=\"" << message << "\"/>\n";
+
+        if( !job.output.isEmpty() )
+            out << "      <system-out>" << job.output.toHtmlEscaped() << "</system-out>\n";
+        out << "    </testcase>\n";
+    }
+    out << "  </testsuite>\n";
+    out << "</testsuites>\n";
+}
@@ -6,8 +6,25 @@
 #pragma once
 
 #include <QDir>
+#include <QElapsedTimer>
+#include <QHash>
 
 class Component;
+class Mcu;
+class McuSnapshot;
+class QProcess;
+class QEventLoop;
+
+enum runResult_t{      // Headless run exit codes
+    Run_Ok=0,
+    Run_TestFailed,
+    Run_SimError,
+    Run_Timeout,     // Test Units not finished at end time
+    Run_LoadError,
+    Run_Crashed,     // Parallel batch test only
+    Run_Killed,      // Wall time limit reached
+    Run_Skipped,     // Not run or stopped: fail fast
+};
 
 class BatchTest
 {
@@ -20,10 +37,42 @@ class BatchTest
 
         static void checkFinished();
 
+        static int runCircuit( QString file, uint64_t simTime ); // Headless run, returns runResult_t
+        static uint64_t parseTime( QString time ); // "10ms", "2.5s"... to ps, 0 if not valid
+
+        // Checkpoint: Mcus saved at this time, at end restored and run again to check replay
+        // Only in circuits with nothing but Mcus: other components state is not saved
+        static void setCheckpoint( uint64_t t ) { m_checkTime = t; }
+        static int  checkpoint(); // Save all Mcus, returns number saved, -1 if any not supported
+        static bool restore();    // Restore Mcus saved by checkpoint()
+
+        // Parallel batch test: each circuit runs headless in it's own process
+        static int runParallel( QString folder, int jobs ); // jobs = 0: one per CPU core
+        static void setSimTime( QString t ) { m_simTime = t; }
+        static void setTimeout( double s ) { m_timeout = s*1000; }
+        static void setFailFast( bool f ) { m_failFast = f; }
+        static void setJUnitFile( QString f ) { m_junitFile = f; }
+
     private:
+        struct testJob_t
+        {
+            QString file;
+            QString output;
+            QProcess* process;
+            QElapsedTimer timer;
+            double time;   // Wall time in seconds
+            int result;    // runResult_t
+        };
+
         static void prepareTest( QDir dir );
         static void runNextCircuit();
 
+        static void startNextJob();
+        static void jobFinished( int index, int code, bool crashed );
+        static void checkTimeouts();
+        static void writeJUnit( QString folder, double time );
+        static QString resultName( int result );
+
         static bool m_running;
 
         static QString m_currentFile;
@@ -31,4 +80,18 @@ class BatchTest
         static QStringList m_failedTests;
         static QStringList m_circFiles;
         static QList<Component*> m_testUnits;
+
+        static QList<testJob_t> m_jobs;
+        static QEventLoop* m_loop;
+        static QString m_simTime;
+        static QString m_junitFile;
+        static int  m_maxJobs;
+        static int  m_nextJob;
+        static int  m_runningJobs;
+        static int  m_timeout;   // ms, 0 = no limit
+        static bool m_failFast;
+        static bool m_stop;
+
+        static uint64_t m_checkTime;
+        static QHash<Mcu*, McuSnapshot*> m_checkpoint;
 };
@@ -12,6 +12,7 @@
 #include "circuitwidget.h"
 #include "editorwindow.h"
 #include "batchtest.h"
+#include "lukernel.h"
 
 void myMessageOutput( QtMsgType type, const QMessageLogContext &context, const QString &msg )
 {
@@ -58,8 +59,44 @@ int main( int argc, char *argv[] )
     }
 #endif
 
+    QString runFile;     // Headless run: simulide -run circuit.sim1 [-time 10ms] [-checkpoint 5ms]
+    QString runTime;
+    QString checkTime;
+    QString testFolder;  // Parallel test: simulide -test folder -jobs 4 [-timeout 60] [-failfast] [-junit report.xml]
+    int testJobs = -1;
+
+    for( int i=1; i<argc; ++i )
+    {
+        QString arg = QString( argv[i] );
+
+        if( arg == "-benchmatrix" ) // Benchmark matrix kernels and exit
+        {
+            LuKernel::init();
+            LuKernel::benchmark();
+            return 0;
+        }
+        else if( arg == "-run"  && i+1 < argc ) runFile = QString( argv[++i] );
+        else if( arg == "-time" && i+1 < argc ) runTime = QString( argv[++i] );
+        else if( arg == "-checkpoint" && i+1 < argc ) checkTime = QString( argv[++i] );
+        else if( arg == "-test" && i+1 < argc ) testFolder = QString( argv[++i] );
+        else if( arg == "-jobs" && i+1 < argc ) testJobs = QString( argv[++i] ).toInt();
+        else if( arg == "-junit"   && i+1 < argc ) BatchTest::setJUnitFile( QString( argv[++i] ) );
+        else if( arg == "-timeout" && i+1 < argc ) BatchTest::setTimeout( QString( argv[++i] ).toDouble() );
+        else if( arg == "-failfast" ) BatchTest::setFailFast( true );
+    }
+    bool parallelTest = !testFolder.isEmpty() && testJobs >= 0;
+
+    if( (!runFile.isEmpty() || parallelTest) && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM") )
+        qputenv("QT_QPA_PLATFORM", "offscreen"); // No display needed
+
     QApplication app( argc, argv );
 
+    if( parallelTest )   // Circuits run in child processes, no GUI here
+    {
+        BatchTest::setSimTime( runTime );
+        return BatchTest::runParallel( testFolder, testJobs );
+    }
+
     QSettings settings( QStandardPaths::standardLocations( QStandardPaths::AppDataLocation).first()+"/simulide.ini",  QSettings::IniFormat, 0l );
 
     QString locale = QLocale::system().name();
@@ -81,6 +118,29 @@ int main( int argc, char *argv[] )
 
     MainWindow window;
     window.setLoc( locale );
+
+    if( !runFile.isEmpty() )
+    {
+        uint64_t simTime = 0;
+        if( !runTime.isEmpty() )
+        {
+            simTime = BatchTest::parseTime( runTime );
+            if( !simTime ){
+                qDebug() <<"ERROR: wrong simulation time"<< runTime;
+                return Run_LoadError;
+        }   }
+        if( !checkTime.isEmpty() )
+        {
+            uint64_t cpTime = BatchTest::parseTime( checkTime );
+            if( !cpTime ){
+                qDebug() <<"ERROR: wrong checkpoint time"<< checkTime;
+                return Run_LoadError;
+            }
+            BatchTest::setCheckpoint( cpTime );
+        }
+        window.hideGui();
+        return BatchTest::runCircuit( runFile, simTime );
+    }
     window.show();
 
     for( int i=1; i<argc; ++i )
@@ -24,6 +24,7 @@
 #include "componentlist.h"
 #include "editorwindow.h"
 #include "circuitwidget.h"
+#include "circmatrix.h"
 #include "filewidget.h"
 #include "installer.h"
 #include "utils.h"
@@ -149,12 +150,17 @@ void MainWindow::readSettings()
 
     m_autoUpdt = 1;
     if( m_settings->contains("autoUpdt") ) m_autoUpdt = m_settings->value("autoUpdt").toInt();
+
+    if( m_settings->contains("matrixThreads") )   CircMatrix::self()->setThreads( m_settings->value("matrixThreads").toInt() );
+    if( m_settings->contains("matrixThreadMin") ) CircMatrix::self()->setThreadMin( m_settings->value("matrixThreadMin").toInt() );
 }
 
 void MainWindow::writeSettings()
 {
     m_settings->setValue("autoUpdt",  m_autoUpdt );
     m_settings->setValue("autoBck",   m_autoBck );
+    m_settings->setValue("matrixThreads",   CircMatrix::self()->threads() );
+    m_settings->setValue("matrixThreadMin", CircMatrix::self()->threadMin() );
     m_settings->setValue("fontName",  m_fontName );
     m_settings->setValue("fontScale", m_fontScale );
     m_settings->setValue("geometry",  saveGeometry() );
@@ -10,6 +10,7 @@
 #include "mcucomparator.h"
 #include "mcupin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "datautils.h"
 #include "simulator.h"
 
@@ -155,6 +156,31 @@ void AvrAdc::endConversion()
     if( m_autoTrigger && m_freeRunning ) startConversion();
 }
 
+bool AvrAdc::saveState( StateStream* s )
+{
+    s->put( m_acme );
+    s->put( m_autoTrigger );
+    s->put( m_freeRunning );
+    s->put( m_initCycles );
+    s->put( m_refSelect );
+    s->put( m_trigger );
+    return McuAdc::saveState( s );
+}
+
+void AvrAdc::loadState( StateStream* s )
+{
+    s->get( m_acme );
+    s->get( m_autoTrigger );
+    s->get( m_freeRunning );
+    s->get( m_initCycles );
+    s->get( m_refSelect );
+    s->get( m_trigger );
+    McuAdc::loadState( s );
+
+    autotriggerConf(); // Interrupt callbacks
+    toAdcMux();
+}
+
 //------------------------------------------------------
 //-- AVR ADC Type 0 ------------------------------------
 
@@ -32,6 +32,9 @@ class AvrAdc : public McuAdc
         virtual void setChannel( uint8_t newADMUX ) override;
         virtual void callBack() override { if( !m_converting ) startConversion(); }
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         void updateAcme( uint8_t newVal );
         virtual void autotriggerConf(){;}
@@ -7,6 +7,7 @@
 #include "datautils.h"
 #include "regwatcher.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcupin.h"
 
 AvrComp::AvrComp( eMcu* mcu, QString name )
@@ -127,3 +128,19 @@ void AvrComp::changeCallbacks()
     m_pinP->changeCallBack( this, m_enabled && (m_acie || m_acoe) );
     m_pinN->changeCallBack( this, m_enabled && (m_acie || m_acoe) );
 }
+
+bool AvrComp::saveState( StateStream* s )
+{
+    s->put( m_acie );
+    s->put( m_acoe );
+    return McuComp::saveState( s );
+}
+
+void AvrComp::loadState( StateStream* s )
+{
+    s->get( m_acie );
+    s->get( m_acoe );
+    McuComp::loadState( s );
+
+    changeCallbacks();
+}
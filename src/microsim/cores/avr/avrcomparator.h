@@ -22,6 +22,9 @@ class AvrComp : public McuComp
         virtual void configureB( uint8_t newAIND ) override;
         virtual void configureC( uint8_t newACOE ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
         virtual void setPinN( McuPin* pin ) override;
 
         void readACO( uint8_t );
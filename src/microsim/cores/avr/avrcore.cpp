@@ -13,6 +13,7 @@
 #include "avr_defines.h"
 #include "avrsleep.h"
 #include "simulator.h"
+#include "mcusnapshot.h"
 #include "datautils.h"
 
 AvrCore::AvrCore( eMcu* mcu )
@@ -40,6 +41,7 @@ AvrCore::AvrCore( eMcu* mcu )
     m_PGERS = getRegBits("PGERS", mcu );
     m_PGWRT = getRegBits("PGWRT", mcu );
 
+    m_decoded.resize( m_progSize );
 }
 AvrCore::~AvrCore() {}
 
@@ -52,105 +54,93 @@ void AvrCore::reset()
     if( m_sph ) *m_sph = ramEnd >> 8;
 }
 
+// Flags are calculated in a local copy of SREG and written once
+
+#define F_HCV  (1<<S_H | 1<<S_C | 1<<S_V)
+#define F_NS   (1<<S_N | 1<<S_S)
+#define F_ZNS  (1<<S_Z | 1<<S_N | 1<<S_S)
+
+static inline uint8_t nsBits( uint8_t res, uint8_t sv ) // N and S = N^V
+{
+    uint8_t sn = res>>7;
+    return sn<<S_N | (sn^sv)<<S_S;
+}
+static inline uint8_t subBits( uint8_t res, uint8_t rd, uint8_t rr ) // H, C and V of rd-rr
+{
+    uint8_t sub_carry = (~rd & rr) | (rr & res) | (res & ~rd);
+    uint8_t overflow  = (rd & ~rr & ~res) | (~rd & rr & res);
+    return ((sub_carry>>3) & 1)<<S_H | (sub_carry>>7)<<S_C | (overflow>>7)<<S_V;
+}
+static inline uint8_t addBits( uint8_t res, uint8_t rd, uint8_t rr ) // H, C and V of rd+rr
+{
+    uint8_t add_carry = (rd & rr) | (rr & ~res) | (~res & rd);
+    uint8_t overflow  = (rd & rr & ~res) | (~rd & ~rr & res);
+    return ((add_carry>>3) & 1)<<S_H | (add_carry>>7)<<S_C | (overflow>>7)<<S_V;
+}
+
 inline void AvrCore::flags_ns( uint8_t res )
 {
-    bool sn = res & (1<<7);
-    write_S_Bit( S_N, sn );
-    write_S_Bit( S_S, sn != (bool)STATUS(S_V) );
+    uint8_t sreg = *m_STATUS;
+    *m_STATUS = (sreg & ~F_NS) | nsBits( res, (sreg>>S_V) & 1 );
 }
 inline void AvrCore::flags_zns( uint8_t res )
 {
-    write_S_Bit( S_Z, (res == 0) );
-    flags_ns( res );
+    uint8_t sreg = *m_STATUS;
+    *m_STATUS = (sreg & ~F_ZNS) | (res == 0)<<S_Z | nsBits( res, (sreg>>S_V) & 1 );
 }
 inline void AvrCore::flags_Rzns( uint8_t res )
 {
-    if( res ) clear_S_Bit( S_Z );
-    flags_ns( res );
+    uint8_t sreg = *m_STATUS;
+    if( res ) sreg &= ~(1<<S_Z);
+    *m_STATUS = (sreg & ~F_NS) | nsBits( res, (sreg>>S_V) & 1 );
 }
 inline void AvrCore::flags_sub( uint8_t res, uint8_t rd, uint8_t rr )
 {
-    /* carry & half carry */
-    uint8_t sub_carry = (~rd & rr) | (rr & res) | (res & ~rd);
-
-    write_S_Bit( S_H, sub_carry & (1<<3) );
-    write_S_Bit( S_C, sub_carry & (1<<7) );
-
-    /* overflow */
-    /// SREG[S_V] = ( ((rd & ~rr & ~res) | (~rd & rr & res) ) >> 7) & 1;
-    write_S_Bit( S_V, ((rd & ~rr & ~res) | (~rd & rr & res)) & (1<<7) );
+    *m_STATUS = (*m_STATUS & ~F_HCV) | subBits( res, rd, rr );
 }
 inline void AvrCore::flags_sub_Rzns( uint8_t res, uint8_t rd, uint8_t rr )
 {
-    flags_sub( res, rd, rr );
-    flags_Rzns( res );
+    uint8_t hcv  = subBits( res, rd, rr );
+    uint8_t sreg = (*m_STATUS & ~(F_HCV | F_NS)) | hcv;
+    if( res ) sreg &= ~(1<<S_Z);
+    *m_STATUS = sreg | nsBits( res, (hcv>>S_V) & 1 );
 }
 inline void AvrCore::flags_add_zns( uint8_t res, uint8_t rd, uint8_t rr )
 {
-    /* carry & half carry */
-    uint8_t add_carry = (rd & rr) | (rr & ~res) | (~res & rd);
-
-    write_S_Bit( S_H, add_carry & (1<<3) );
-    write_S_Bit( S_C, add_carry & (1<<7) );
-
-    /// SREG[S_V] = (((rd & rr & ~res) | (~rd & ~rr & res)) >> 7) & 1; //overflow
-    write_S_Bit( S_V, ((rd & rr & ~res) | (~rd & ~rr & res)) & (1<<7) );
-
-    flags_zns( res ); //zns
+    uint8_t hcv = addBits( res, rd, rr );
+    *m_STATUS = (*m_STATUS & ~(F_HCV | F_ZNS)) | hcv | (res == 0)<<S_Z | nsBits( res, (hcv>>S_V) & 1 );
 }
 inline void AvrCore::flags_sub_zns( uint8_t res, uint8_t rd, uint8_t rr )
 {
-    flags_sub( res, rd, rr );
-    flags_zns( res ); //zns
+    uint8_t hcv = subBits( res, rd, rr );
+    *m_STATUS = (*m_STATUS & ~(F_HCV | F_ZNS)) | hcv | (res == 0)<<S_Z | nsBits( res, (hcv>>S_V) & 1 );
 }
 inline void AvrCore::flags_znv0s( uint8_t res )
 {
-    clear_S_Bit( S_V );
-    flags_zns( res );
+    *m_STATUS = (*m_STATUS & ~(1<<S_V | F_ZNS)) | (res == 0)<<S_Z | nsBits( res, 0 );
 }
 inline void AvrCore::flags_zcnvs( uint8_t res, uint8_t vr )
 {
-    write_S_Bit( S_Z, (res == 0) );
-
-    bool sc = (vr & 1)  != 0 ;
-    write_S_Bit( S_C, sc );
-
-    bool sn = (res & (1<<7)) != 0;
-    write_S_Bit( S_N, sn );
-
-    /// SREG[S_V] = SREG[S_N] ^ SREG[S_C];
-    uint8_t sv = sn != sc;
-    write_S_Bit( S_V, sv );
-
-    /// SREG[S_S] = SREG[S_N] ^ SREG[S_V];
-    write_S_Bit( S_S, sn != sv );
+    uint8_t sc = vr & 1;
+    uint8_t sn = res>>7;
+    uint8_t sv = sn ^ sc;      // SREG[S_V] = SREG[S_N] ^ SREG[S_C]
+    *m_STATUS = (*m_STATUS & ~(1<<S_C | 1<<S_V | F_ZNS))
+              | (res == 0)<<S_Z | sc<<S_C | sn<<S_N | sv<<S_V | (sn^sv)<<S_S;
 }
 inline void AvrCore::flags_zcvs( uint8_t res, uint8_t vr )
 {
-    write_S_Bit( S_Z, (res == 0) );
-
-    bool sc = (vr & 1)  != 0 ;
-    write_S_Bit( S_C, sc );
-
-    bool sn = STATUS( S_N ) != 0;
-
-    /// SREG[S_V] = SREG[S_N] ^ SREG[S_C];
-    bool sv = sn != sc;
-    write_S_Bit( S_V, sv );
-
-    /// SREG[S_S] = SREG[S_N] ^ SREG[S_V];
-    write_S_Bit( S_S, sn != sv );
+    uint8_t sreg = *m_STATUS;
+    uint8_t sc = vr & 1;
+    uint8_t sn = (sreg>>S_N) & 1;
+    uint8_t sv = sn ^ sc;      // SREG[S_V] = SREG[S_N] ^ SREG[S_C]
+    *m_STATUS = (sreg & ~(1<<S_Z | 1<<S_C | 1<<S_V | 1<<S_S))
+              | (res == 0)<<S_Z | sc<<S_C | sv<<S_V | (sn^sv)<<S_S;
 }
 inline void AvrCore::flags_zns16( uint16_t res )
 {
-    write_S_Bit( S_Z, (res == 0) );
-
-    bool sn = (res & (1<<15)) != 0 ;
-    write_S_Bit( S_N, sn );
-
-    bool sv = STATUS(S_V) != 0;
-    /// SREG[S_S] = SREG[S_N] ^ SREG[S_V];
-    write_S_Bit( S_S, sn != sv );
+    uint8_t sreg = *m_STATUS;
+    uint8_t sn = res>>15;
+    *m_STATUS = (sreg & ~F_ZNS) | (res == 0)<<S_Z | sn<<S_N | (sn ^ ((sreg>>S_V) & 1))<<S_S;
 }
 inline int AvrCore::is_instr_32b( uint32_t pc )
 {
@@ -180,7 +170,10 @@ void AvrCore::writeFlash()
         z >>= 1;
         qDebug() <<"FLASH: Erasing page"<< z/m_pageSize << "at address" << z << "words:"<< m_pageSize;
         for( int i=0; i<m_pageSize; i++ )
-            m_progMem[z++] = 0xff;
+        {
+            m_progMem[z] = 0xff;
+            pgmChanged( z++ );
+        }
     }
     else if( getRegBitsBool( m_PGWRT ) )
     {
@@ -190,7 +183,8 @@ void AvrCore::writeFlash()
 
         for( int i=0; i<m_pageSize; i++)
         {
-            m_progMem[z++] = m_tmpPage[i];
+            m_progMem[z] = m_tmpPage[i];
+            pgmChanged( z++ );
             m_tmpPage[i] = 0;
             m_tmpUsed[i] = 0;
         }
@@ -221,665 +215,811 @@ void AvrCore::writeFlash()
     clearRegBits( m_SELFPRGEN );
 }
 
-void AvrCore::runStep()
+void AvrCore::pgmChanged( uint32_t addr ) // Decode again, also the previous word (2 word instructions)
 {
-    m_mcu->cyclesDone = 0;
-    uint16_t instruction = m_progMem[m_PC];
+    if( addr < m_decoded.size() ) m_decoded[addr].op = AVR_UNDECODED;
+    if( addr > 0 && addr <= m_decoded.size() ) m_decoded[addr-1].op = AVR_UNDECODED;
+}
 
-    uint32_t new_pc = m_PC + 1;    // future "default" pc
-    //m_RET_ADDR = -1; //new_pc;
-    int cycle = 1;
+bool AvrCore::saveState( StateStream* s ) // Registers and SP are in Ram
+{
+    s->put( m_PC );
+    s->put( m_RET_ADDR );
+    s->putVector( m_tmpUsed );    // SPM page buffer
+    s->putVector( m_tmpPage );
+    return true;
+}
+
+void AvrCore::loadState( StateStream* s )
+{
+    s->get( m_PC );
+    s->get( m_RET_ADDR );
+    s->getVector( m_tmpUsed );
+    s->getVector( m_tmpPage );
+}
+
+static inline void setInst( avrInst_t* inst, uint8_t op, uint8_t d, uint8_t r=0, uint8_t b=0, int32_t k=0 )
+{
+    inst->op = op;
+    inst->d  = d;
+    inst->r  = r;
+    inst->b  = b;
+    inst->k  = k;
+}
+
+void AvrCore::decode( uint32_t pc )
+{
+    uint16_t instruction = m_progMem[pc];
+    uint16_t next = (pc+1 < m_progSize) ? m_progMem[pc+1] : 0; // Second word of 32 bits instructions
+
+    avrInst_t* inst = &m_decoded[pc];
+    setInst( inst, AVR_NOP, 0 ); // NOP and invalid instructions
 
     switch( instruction & 0xf000 )
     {
-        case 0x0000:{
-            switch( instruction){
-                case 0x0000: {    // NOP
-                }    break;
-                default:
-                {
-                    switch( instruction & 0xfc00) {
-                        case 0x0400: {    // CPC -- Compare with carry -- 0000 01rd dddd rrrr
-                            get_vd5_vr5( instruction );
-                            uint8_t res = vd - vr - STATUS( S_C );
-                            flags_sub_Rzns( res, vd, vr );
-                        }    break;
-                        case 0x0c00: {    // ADD -- Add without carry -- 0000 11rd dddd rrrr
-                            get_vd5_vr5( instruction );
-                            uint8_t res = vd + vr;
-                            m_dataMem[d] = res;
-                            flags_add_zns( res, vd, vr);
-                        }    break;
-                        case 0x0800: {    // SBC -- Subtract with carry -- 0000 10rd dddd rrrr
-                            get_vd5_vr5( instruction );
-                            uint8_t res = vd - vr - STATUS( S_C );
-                            m_dataMem[d] = res;
-                            flags_sub_Rzns( res, vd, vr);
-                        }    break;
-                        default: {
-                            switch( instruction & 0xff00) {
-                                case 0x0100: {    // MOVW -- Copy Register Word -- 0000 0001 dddd rrrr
-                                    uint8_t d =( (instruction >> 4) & 0xf) << 1;
-                                    uint8_t r =( instruction & 0xf) << 1;
-                                    uint16_t vr = m_dataMem[r]|( m_dataMem[r+1] << 8);
-                                    SET_REG16_LH( d, vr );
-                                }    break;
-                                case 0x0200: {    // MULS -- Multiply Signed -- 0000 0010 dddd rrrr
-                                    int8_t r = 16 +( instruction & 0xf);
-                                    int8_t d = 16 +( (instruction >> 4) & 0xf);
-                                    int16_t res =( (int8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
-                                    SET_REG16_LH( 0, res);
-                                    /// SREG[S_C] =( res >> 15) & 1;
-                                    write_S_Bit( S_C, res & 1<<15 );
-                                    write_S_Bit( S_Z, res == 0 );
-                                    cycle++;
-                                }    break;
-                                case 0x0300: {    // MUL -- Multiply -- 0000 0011 fddd frrr
-                                    int8_t r = 16 +( instruction & 0x7);
-                                    int8_t d = 16 +( (instruction >> 4) & 0x7);
-                                    int16_t res = 0;
-                                    uint8_t c = 0;
-
-                                    switch( instruction & 0x88) {
-                                        case 0x00:     // MULSU -- Multiply Signed Unsigned -- 0000 0011 0ddd 0rrr
-                                            res =( (uint8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
-                                            c =( res >> 15) & 1;
-                                            break;
-                                        case 0x08:     // FMUL -- Fractional Multiply Unsigned -- 0000 0011 0ddd 1rrr
-                                            res =( (uint8_t)m_dataMem[r]) *( (uint8_t)m_dataMem[d]);
-                                            c =( res >> 15) & 1;
-                                            res <<= 1;
-                                            break;
-                                        case 0x80:     // FMULS -- Multiply Signed -- 0000 0011 1ddd 0rrr
-                                            res =( (int8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
-                                            c =( res >> 15) & 1;
-                                            res <<= 1;
-                                            break;
-                                        case 0x88:     // FMULSU -- Multiply Signed Unsigned -- 0000 0011 1ddd 1rrr
-                                            res =( (uint8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
-                                            c =( res >> 15) & 1;
-                                            res <<= 1;
-                                            break;
-                                    }
-                                    cycle++;
-                                    SET_REG16_LH( 0, res);
-                                    write_S_Bit( S_C, c );
-                                    write_S_Bit( S_Z, res == 0 );
-                                }    break;
-                                default: ;//_avr_invalid_instruction(avr);
-                            }
-                        }
+        case 0x0000: {
+            if( instruction == 0x0000 ) break; // NOP
+            get_d5( instruction );
+            get_r5( instruction );
+            switch( instruction & 0xfc00 ) {
+                case 0x0400: setInst( inst, AVR_CPC, d, r ); return; // CPC  -- 0000 01rd dddd rrrr
+                case 0x0c00: setInst( inst, AVR_ADD, d, r ); return; // ADD  -- 0000 11rd dddd rrrr
+                case 0x0800: setInst( inst, AVR_SBC, d, r ); return; // SBC  -- 0000 10rd dddd rrrr
+            }
+            switch( instruction & 0xff00 ) {
+                case 0x0100:                                         // MOVW -- 0000 0001 dddd rrrr
+                    setInst( inst, AVR_MOVW, ((instruction >> 4) & 0xf) << 1, (instruction & 0xf) << 1 );
+                    return;
+                case 0x0200:                                         // MULS -- 0000 0010 dddd rrrr
+                    setInst( inst, AVR_MULS, 16 + ((instruction >> 4) & 0xf), 16 + (instruction & 0xf) );
+                    return;
+                case 0x0300: {                                       // MUL  -- 0000 0011 fddd frrr
+                    uint8_t op = AVR_MULSU;                          // MULSU  -- 0000 0011 0ddd 0rrr
+                    switch( instruction & 0x88 ) {
+                        case 0x08: op = AVR_FMUL;   break;           // FMUL   -- 0000 0011 0ddd 1rrr
+                        case 0x80: op = AVR_FMULS;  break;           // FMULS  -- 0000 0011 1ddd 0rrr
+                        case 0x88: op = AVR_FMULSU; break;           // FMULSU -- 0000 0011 1ddd 1rrr
                     }
-                }
+                    setInst( inst, op, 16 + ((instruction >> 4) & 0x7), 16 + (instruction & 0x7) );
+                }   return;
             }
-        }    break;
+        } break;
 
         case 0x1000: {
-            switch( instruction & 0xfc00) {
-                case 0x1800: {    // SUB -- Subtract without carry -- 0001 10rd dddd rrrr
-                    get_vd5_vr5( instruction );
-                    uint8_t res = vd - vr;
-                    m_dataMem[d] = res;
-                    flags_sub_zns( res, vd, vr);
-                }    break;
-                case 0x1000: {    // CPSE -- Compare, skip if equal -- 0001 00rd dddd rrrr
-                    get_vd5_vr5( instruction );
-                    bool res = vd == vr;
-                    if( res )
+            get_d5( instruction );
+            get_r5( instruction );
+            switch( instruction & 0xfc00 ) {
+                case 0x1800: setInst( inst, AVR_SUB,  d, r ); return; // SUB  -- 0001 10rd dddd rrrr
+                case 0x1000: setInst( inst, AVR_CPSE, d, r ); return; // CPSE -- 0001 00rd dddd rrrr
+                case 0x1400: setInst( inst, AVR_CP,   d, r ); return; // CP   -- 0001 01rd dddd rrrr
+                case 0x1c00: setInst( inst, AVR_ADC,  d, r ); return; // ADC  -- 0001 11rd dddd rrrr
+            }
+        } break;
+
+        case 0x2000: {
+            get_d5( instruction );
+            get_r5( instruction );
+            switch( instruction & 0xfc00 ) {
+                case 0x2000: setInst( inst, AVR_AND, d, r ); return; // AND -- 0010 00rd dddd rrrr
+                case 0x2400: setInst( inst, AVR_EOR, d, r ); return; // EOR -- 0010 01rd dddd rrrr
+                case 0x2800: setInst( inst, AVR_OR,  d, r ); return; // OR  -- 0010 10rd dddd rrrr
+                case 0x2c00: setInst( inst, AVR_MOV, d, r ); return; // MOV -- 0010 11rd dddd rrrr
+            }
+        } break;
+
+        case 0x3000: { get_h4_k8( instruction ); setInst( inst, AVR_CPI,  h, 0, 0, k ); } return; // CPI  -- 0011 kkkk hhhh kkkk
+        case 0x4000: { get_h4_k8( instruction ); setInst( inst, AVR_SBCI, h, 0, 0, k ); } return; // SBCI -- 0100 kkkk hhhh kkkk
+        case 0x5000: { get_h4_k8( instruction ); setInst( inst, AVR_SUBI, h, 0, 0, k ); } return; // SUBI -- 0101 kkkk hhhh kkkk
+        case 0x6000: { get_h4_k8( instruction ); setInst( inst, AVR_ORI,  h, 0, 0, k ); } return; // ORI  -- 0110 kkkk hhhh kkkk
+        case 0x7000: { get_h4_k8( instruction ); setInst( inst, AVR_ANDI, h, 0, 0, k ); } return; // ANDI -- 0111 kkkk hhhh kkkk
+
+        case 0xa000:
+        case 0x8000: {    // LDD/STD -- 10q0 qqsd dddd yqqq
+            get_d5_q6( instruction );
+            bool y = instruction & 0x0008;
+            uint8_t op;
+            if( instruction & 0x0200 ) op = y ? AVR_STD_Y : AVR_STD_Z;
+            else                       op = y ? AVR_LDD_Y : AVR_LDD_Z;
+            setInst( inst, op, d, 0, 0, q );
+        } return;
+
+        case 0x9000: {
+            if( (instruction & 0xff0f) == 0x9408 ) // SEx/CLx -- 1001 0100 Bbbb 1000
+            {
+                setInst( inst, AVR_SREG, (instruction >> 4) & 7, 0, (instruction & 0x0080) == 0 );
+                return;
+            }
+            switch( instruction ) {
+                case 0x9588: setInst( inst, AVR_SLEEP,   0 ); return; // SLEEP -- 1001 0101 1000 1000
+                case 0x9598: setInst( inst, AVR_BREAK,   0 ); return; // BREAK -- 1001 0101 1001 1000
+                case 0x95a8: setInst( inst, AVR_WDR,     0 ); return; // WDR   -- 1001 0101 1010 1000
+                case 0x95e8: setInst( inst, AVR_SPM,     0 ); return; // SPM   -- 1001 0101 1110 1000
+                case 0x9518: setInst( inst, AVR_RETI,    0 ); return; // RETI  -- 1001 0101 0001 1000
+                case 0x9508: setInst( inst, AVR_RET,     0 ); return; // RET   -- 1001 0101 0000 1000
+                case 0x95c8: setInst( inst, AVR_LPM_R0,  0 ); return; // LPM   -- 1001 0101 1100 1000
+                case 0x95d8: setInst( inst, AVR_ELPM_R0, 0 ); return; // ELPM  -- 1001 0101 1101 1000
+                case 0x9409:   // IJMP   -- 1001 0100 0000 1001
+                case 0x9419:   // EIJMP  -- 1001 0100 0001 1001   bit 4 is "Extended"
+                case 0x9509:   // ICALL  -- 1001 0101 0000 1001
+                case 0x9519:   // EICALL -- 1001 0101 0001 1001   bit 8 is "Call: push pc"
+                    setInst( inst, AVR_IJMP, (instruction & 0x10) != 0, 0, (instruction & 0x100) != 0 );
+                    return;
+            }
+            get_d5( instruction );
+            uint8_t op = instruction & 3; // oo = 1) post increment, 2) pre-decrement
+            switch( instruction & 0xfe0f ) {
+                case 0x9000: setInst( inst, AVR_LDS, d, 0, 0, next ); return;  // LDS  -- 1001 000d dddd 0000 kkkk...
+                case 0x9200: setInst( inst, AVR_STS, d, 0, 0, next ); return;  // STS  -- 1001 001d dddd 0000 kkkk...
+                case 0x9004:
+                case 0x9005: setInst( inst, AVR_LPM,  d, 0, op & 1 ); return;  // LPM  -- 1001 000d dddd 010o
+                case 0x9006:
+                case 0x9007: setInst( inst, AVR_ELPM, d, 0, op & 1 ); return;  // ELPM -- 1001 000d dddd 011o
+                case 0x900c:
+                case 0x900d:
+                case 0x900e: setInst( inst, AVR_LD_X, d, 0, op ); return;      // LD   -- 1001 000d dddd 11oo
+                case 0x920c:
+                case 0x920d:
+                case 0x920e: setInst( inst, AVR_ST_X, d, 0, op ); return;      // ST   -- 1001 001d dddd 11oo
+                case 0x9009:
+                case 0x900a: setInst( inst, AVR_LD_Y, d, 0, op ); return;      // LD   -- 1001 000d dddd 10oo
+                case 0x9209:
+                case 0x920a: setInst( inst, AVR_ST_Y, d, 0, op ); return;      // ST   -- 1001 001d dddd 10oo
+                case 0x9001:
+                case 0x9002: setInst( inst, AVR_LD_Z, d, 0, op ); return;      // LD   -- 1001 000d dddd 00oo
+                case 0x9201:
+                case 0x9202: setInst( inst, AVR_ST_Z, d, 0, op ); return;      // ST   -- 1001 001d dddd 00oo
+                case 0x900f: setInst( inst, AVR_POP,  d ); return;             // POP  -- 1001 000d dddd 1111
+                case 0x920f: setInst( inst, AVR_PUSH, d ); return;             // PUSH -- 1001 001d dddd 1111
+                case 0x9400: setInst( inst, AVR_COM,  d ); return;             // COM  -- 1001 010d dddd 0000
+                case 0x9401: setInst( inst, AVR_NEG,  d ); return;             // NEG  -- 1001 010d dddd 0001
+                case 0x9402: setInst( inst, AVR_SWAP, d ); return;             // SWAP -- 1001 010d dddd 0010
+                case 0x9403: setInst( inst, AVR_INC,  d ); return;             // INC  -- 1001 010d dddd 0011
+                case 0x9405: setInst( inst, AVR_ASR,  d ); return;             // ASR  -- 1001 010d dddd 0101
+                case 0x9406: setInst( inst, AVR_LSR,  d ); return;             // LSR  -- 1001 010d dddd 0110
+                case 0x9407: setInst( inst, AVR_ROR,  d ); return;             // ROR  -- 1001 010d dddd 0111
+                case 0x940a: setInst( inst, AVR_DEC,  d ); return;             // DEC  -- 1001 010d dddd 1010
+                case 0x940c:
+                case 0x940d:
+                case 0x940e:
+                case 0x940f: {    // JMP/CALL -- 1001 010a aaaa 11ca kkkk...
+                    uint32_t a = ((instruction & 0x01f0) >> 3) | (instruction & 1);
+                    a = (a << 16) | next;
+                    setInst( inst, (instruction & 2) ? AVR_CALL : AVR_JMP, 0, 0, 0, a );
+                }   return;
+            }
+            switch( instruction & 0xff00 ) {
+                case 0x9600:
+                case 0x9700: {    // ADIW/SBIW -- 1001 011s KKpp KKKK
+                    const uint8_t p = 24 + ((instruction >> 3) & 0x6);
+                    const uint8_t k = ((instruction & 0x00c0) >> 2) | (instruction & 0xf);
+                    setInst( inst, (instruction & 0x0100) ? AVR_SBIW : AVR_ADIW, p, 0, 0, k );
+                }   return;
+                case 0x9800:
+                case 0x9900:
+                case 0x9a00:
+                case 0x9b00: {    // CBI/SBIC/SBI/SBIS -- 1001 10oo AAAA Abbb
+                    get_io5_b3mask( instruction );
+                    static const uint8_t ioOps[] = { AVR_CBI, AVR_SBIC, AVR_SBI, AVR_SBIS };
+                    setInst( inst, ioOps[(instruction >> 8) & 3], io, 0, mask );
+                }   return;
+            }
+            if( (instruction & 0xfc00) == 0x9c00 ) // MUL -- 1001 11rd dddd rrrr
+            {
+                get_r5( instruction );
+                setInst( inst, AVR_MUL, d, r );
+            }
+        } return;
+
+        case 0xb000: {    // IN/OUT -- 1011 sAAd dddd AAAA
+            get_d5_a6( instruction );
+            setInst( inst, (instruction & 0x0800) ? AVR_OUT : AVR_IN, d, 0, 0, A );
+        } return;
+
+        case 0xc000:
+        case 0xd000: {    // RJMP/RCALL -- 110c kkkk kkkk kkkk
+            const int16_t k = ((int16_t)((instruction << 4) & 0xFFFF)) >> 4;
+            setInst( inst, (instruction & 0x1000) ? AVR_RCALL : AVR_RJMP, 0, 0, 0, k );
+        } return;
+
+        case 0xe000: { get_h4_k8( instruction ); setInst( inst, AVR_LDI, h, 0, 0, k ); } return; // LDI -- 1110 kkkk hhhh kkkk
+
+        case 0xf000: {
+            switch( instruction & 0xfe00 )
+            {
+                case 0xf000:
+                case 0xf200:
+                case 0xf400:
+                case 0xf600: {    // BRBS/BRBC -- 1111 0Boo oooo osss
+                    int16_t o = ((int16_t)(instruction << 6)) >> 9; // offset
+                    bool set = (instruction & 0x0400) == 0;
+                    setInst( inst, set ? AVR_BRBS : AVR_BRBC, instruction & 7, 0, 0, o );
+                }   return;
+                case 0xf800:      // BLD -- 1111 100d dddd 0bbb
+                    setInst( inst, AVR_BLD, (instruction >> 4) & 0x1f, 0, 1 << (instruction & 7) );
+                    return;
+                case 0xfa00:      // BST -- 1111 101d dddd 0bbb
+                    setInst( inst, AVR_BST, (instruction >> 4) & 0x1f, 0, instruction & 7 );
+                    return;
+                case 0xfc00:
+                case 0xfe00: {    // SBRC/SBRS -- 1111 11sd dddd 0bbb
+                    bool set = (instruction & 0x0200) != 0;
+                    setInst( inst, set ? AVR_SBRS : AVR_SBRC, (instruction >> 4) & 0x1f, 0, 1 << (instruction & 7) );
+                }   return;
+            }
+        } return;
+    }
+}
+
+bool AvrCore::nextIsLocal() // Only Cpu registers, Ram or Flash accessed
+{
+    avrInst_t* inst = &m_decoded[m_PC];
+    if( inst->op == AVR_UNDECODED ) decode( m_PC );
+
+    uint16_t reg;
+    switch( inst->op )
+    {
+        case AVR_SREG:  case AVR_SLEEP: case AVR_BREAK: case AVR_WDR: case AVR_SPM:  case AVR_RETI:
+        case AVR_IN:    case AVR_OUT:   case AVR_CBI:   case AVR_SBI: case AVR_SBIC: case AVR_SBIS:
+            return false;
+
+        case AVR_LDS:   case AVR_STS:   return isPlainRam( inst->k );
+        case AVR_LDD_Y: case AVR_STD_Y: return isPlainRam( (uint16_t)(GET_REG16_LH( R_YL )+inst->k) );
+        case AVR_LDD_Z: case AVR_STD_Z: return isPlainRam( (uint16_t)(GET_REG16_LH( R_ZL )+inst->k) );
+
+        case AVR_LD_X:  case AVR_ST_X:  reg = R_XL; break;
+        case AVR_LD_Y:  case AVR_ST_Y:  reg = R_YL; break;
+        case AVR_LD_Z:  case AVR_ST_Z:  reg = R_ZL; break;
+
+        case AVR_IJMP:  if( !inst->b ) return true; // ICALL, EICALL: use stack
+        case AVR_PUSH:  case AVR_POP:   case AVR_CALL: case AVR_RCALL: case AVR_RET:
+            return GET_SP() > m_regEnd+4;
+
+        default: return true;
+    }
+    uint16_t addr = GET_REG16_LH( reg );
+    if( inst->b == 2 ) addr--;    // Pre-decrement
+    return isPlainRam( addr );
+}
+
+uint64_t AvrCore::skipLoop( uint64_t maxCycles ) // PC at backwards jump closing a wait or delay loop
+{
+    const avrInst_t* jump = getInst( m_PC );
+    const uint8_t op = jump->op;
+
+    if( op == AVR_BRBS || op == AVR_BRBC )
+    {
+        if( (STATUS( jump->d ) != 0) != (op == AVR_BRBS) ) return 0; // Not taken: loop ends
+    }
+    else if( op != AVR_RJMP ) return 0;
+
+    int32_t size = -1-jump->k;  // Loop body words before jump
+    if( size < 0 || size > 3 || (int32_t)m_PC < size ) return 0;
+    uint32_t start = m_PC-size;
+
+    uint64_t loopCycles = 2;    // Taken jump
+    uint64_t loops = maxCycles; // Wait loops only end by interrupt
+
+    uint8_t  reg[3];            // Delay loop counter registers, low byte first
+    int      bytes = 0;
+    uint32_t value = 0;
+    uint32_t dec   = 0;         // Counter decrement per iteration
+
+    if( size ) // Else jump to itself
+    {
+        const avrInst_t* inst = getInst( start );
+        switch( inst->op )
+        {
+            case AVR_SBIC: case AVR_SBIS: { // SBIS A,b ; RJMP .-4
+                if( size != 1 || !isStableRead( inst->d ) ) return 0;
+                bool set = m_dataMem[inst->d] & inst->b;
+                if( set == (inst->op == AVR_SBIS) ) return 0; // Jump skipped: loop ends
+                loopCycles += 1;
+            } break;
+            case AVR_IN: case AVR_LDS: {  // IN/LDS Rd,A ; SBRS Rd,b or TST Rd ; jump
+                const uint8_t  d = inst->d;
+                const uint32_t addr = inst->k;
+                const int32_t words = (inst->op == AVR_LDS) ? 2 : 1;
+                if( size != words+1 || addr > m_dataMemEnd || !isStableRead( addr ) ) return 0;
+                if( m_dataMem[d] != m_dataMem[addr] ) return 0; // Not loaded yet
+
+                const avrInst_t* test = getInst( start+words );
+                if( test->d != d ) return 0;
+                if( test->op == AVR_SBRC || test->op == AVR_SBRS )
+                {
+                    bool set = m_dataMem[d] & test->b;
+                    if( set == (test->op == AVR_SBRS) ) return 0;
+                }
+                else if( test->op == AVR_AND && test->r == d ) // TST: flags must be already set by it
+                {
+                    uint8_t sreg = *m_STATUS;
+                    flags_znv0s( m_dataMem[d] );
+                    bool same = (*m_STATUS == sreg);
+                    *m_STATUS = sreg;
+                    if( !same ) return 0;
+                }
+                else return 0;
+                loopCycles += words+1;
+            } break;
+            default: {                    // DEC Rd | SBIW Rd,K | SUBI Ra,K0 (SBCI Rb,K1...) ; BRNE
+                if( op != AVR_BRBC || jump->d != S_Z ) return 0;
+
+                reg[0] = inst->d;
+                dec = inst->k;
+                bytes = 1;
+                if     ( inst->op == AVR_DEC  && size == 1 ) dec = 1;
+                else if( inst->op == AVR_SBIW && size == 1 ) { reg[1] = inst->d+1; bytes = 2; loopCycles++; }
+                else if( inst->op == AVR_SUBI )
+                {
+                    for( ; bytes<size; ++bytes )
                     {
-                        if( is_instr_32b( new_pc ) ) { new_pc += 2; cycle += 2; }
-                        else                         { new_pc += 1; cycle++; }
+                        const avrInst_t* sbci = getInst( start+bytes );
+                        if( sbci->op != AVR_SBCI ) return 0;
+                        for( int i=0; i<bytes; ++i ) if( reg[i] == sbci->d ) return 0;
+                        reg[bytes] = sbci->d;
+                        dec |= (uint32_t)sbci->k << 8*bytes;
                     }
-                }    break;
-                case 0x1400: {    // CP -- Compare -- 0001 01rd dddd rrrr
-                    get_vd5_vr5( instruction );
-                    uint8_t res = vd - vr;
-                    flags_sub_zns( res, vd, vr);
-                }    break;
-                case 0x1c00: {    // ADC -- Add with carry -- 0001 11rd dddd rrrr
-                    get_vd5_vr5( instruction );
-                    uint8_t res = vd + vr + STATUS( S_C );
-                    m_dataMem[d] = res;
-                    flags_add_zns( res, vd, vr );
-                }    break;
-                default: ;//_avr_invalid_instruction(avr);
+                }
+                else return 0;
+                loopCycles += size;
+
+                for( int i=0; i<bytes; ++i ) value |= (uint32_t)m_dataMem[reg[i]] << 8*i;
+                if( dec == 0 || value <= dec ) return 0;
+                loops = (value-1)/dec; // Counter stays > 0, last iteration runs normally
             }
+        }
+    }
+    uint64_t n = maxCycles/loopCycles;
+    if( n > loops ) n = loops;
+    if( n == 0 ) return 0;
+
+    if( bytes ) // Set counter before last skipped iteration and run its body: exact flags
+    {
+        uint32_t v = value-(n-1)*dec;
+        for( int i=0; i<bytes; ++i ) m_dataMem[reg[i]] = v >> 8*i;
+
+        uint32_t pc = m_PC;
+        m_PC = start;
+        while( m_PC != pc ) runStep();
+    }
+    uint64_t cycles = n*loopCycles;
+    m_mcu->cyclesDone = cycles;
+    return cycles;
+}
+
+void AvrCore::runStep()
+{
+    m_mcu->cyclesDone = 0;
+
+    avrInst_t* inst = &m_decoded[m_PC];
+    if( inst->op == AVR_UNDECODED ) decode( m_PC );
+
+    const uint8_t op = inst->op; // SPM can invalidate it
+    const uint8_t d = inst->d;
+    const uint8_t r = inst->r;
+    const uint8_t b = inst->b;
+    const int32_t k = inst->k;
+
+    uint32_t new_pc = m_PC + 1;    // future "default" pc
+    int cycle = 1;
+
+    switch( op )
+    {
+        case AVR_NOP: break;
+
+        case AVR_CPC: {    // CPC -- Compare with carry
+            uint8_t vd = m_dataMem[d], vr = m_dataMem[r];
+            uint8_t res = vd - vr - STATUS( S_C );
+            flags_sub_Rzns( res, vd, vr );
+        }    break;
+        case AVR_ADD: {    // ADD -- Add without carry
+            uint8_t vd = m_dataMem[d], vr = m_dataMem[r];
+            uint8_t res = vd + vr;
+            m_dataMem[d] = res;
+            flags_add_zns( res, vd, vr);
+        }    break;
+        case AVR_SBC: {    // SBC -- Subtract with carry
+            uint8_t vd = m_dataMem[d], vr = m_dataMem[r];
+            uint8_t res = vd - vr - STATUS( S_C );
+            m_dataMem[d] = res;
+            flags_sub_Rzns( res, vd, vr);
+        }    break;
+        case AVR_MOVW: {    // MOVW -- Copy Register Word
+            uint16_t vr = m_dataMem[r]|( m_dataMem[r+1] << 8);
+            SET_REG16_LH( d, vr );
+        }    break;
+        case AVR_MULS: {    // MULS -- Multiply Signed
+            int16_t res =( (int8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
+            SET_REG16_LH( 0, res);
+            write_S_Bit( S_C, res & 1<<15 );
+            write_S_Bit( S_Z, res == 0 );
+            cycle++;
+        }    break;
+        case AVR_MULSU:     // MULSU -- Multiply Signed Unsigned
+        case AVR_FMUL:      // FMUL -- Fractional Multiply Unsigned
+        case AVR_FMULS:     // FMULS -- Multiply Signed
+        case AVR_FMULSU: {  // FMULSU -- Multiply Signed Unsigned
+            int16_t res;
+            if     ( op == AVR_FMUL  ) res =( (uint8_t)m_dataMem[r]) *( (uint8_t)m_dataMem[d]);
+            else if( op == AVR_FMULS ) res =( (int8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
+            else                             res =( (uint8_t)m_dataMem[r]) *( (int8_t)m_dataMem[d]);
+            uint8_t c =( res >> 15) & 1;
+            if( op != AVR_MULSU ) res <<= 1;
+            cycle++;
+            SET_REG16_LH( 0, res);
+            write_S_Bit( S_C, c );
+            write_S_Bit( S_Z, res == 0 );
         }    break;
 
-        case 0x2000:
-        {
-            get_vd5_vr5( instruction );
-            uint8_t res = vr;
-            bool znv = true;
-            switch( instruction & 0xfc00)
+        case AVR_SUB: {    // SUB -- Subtract without carry
+            uint8_t vd = m_dataMem[d], vr = m_dataMem[r];
+            uint8_t res = vd - vr;
+            m_dataMem[d] = res;
+            flags_sub_zns( res, vd, vr);
+        }    break;
+        case AVR_CPSE: {    // CPSE -- Compare, skip if equal
+            if( m_dataMem[d] == m_dataMem[r] )
             {
-                case 0x2000: {    // AND -- Logical AND -- 0010 00rd dddd rrrr
-                    res &= vd;
-                }    break;
-                case 0x2400: {    // EOR -- Logical Exclusive OR -- 0010 01rd dddd rrrr
-                    res ^= vd;
-                }    break;
-                case 0x2800: {    // OR -- Logical OR -- 0010 10rd dddd rrrr
-                    res |= vd;
-                }    break;
-                case 0x2c00: {    // MOV -- 0010 11rd dddd rrrr
-                    //res = vr;
-                    znv = false;
-                }    break;
-                default: ;//_avr_invalid_instruction(avr);
+                if( is_instr_32b( new_pc ) ) { new_pc += 2; cycle += 2; }
+                else                         { new_pc += 1; cycle++; }
             }
-            if( znv ) flags_znv0s( res);
+        }    break;
+        case AVR_CP: {    // CP -- Compare
+            uint8_t vd = m_dataMem[d], vr = m_dataMem[r];
+            uint8_t res = vd - vr;
+            flags_sub_zns( res, vd, vr);
+        }    break;
+        case AVR_ADC: {    // ADC -- Add with carry
+            uint8_t vd = m_dataMem[d], vr = m_dataMem[r];
+            uint8_t res = vd + vr + STATUS( S_C );
+            m_dataMem[d] = res;
+            flags_add_zns( res, vd, vr );
+        }    break;
+
+        case AVR_AND: {    // AND -- Logical AND
+            uint8_t res = m_dataMem[r] & m_dataMem[d];
+            flags_znv0s( res );
+            m_dataMem[d] = res;
+        }    break;
+        case AVR_EOR: {    // EOR -- Logical Exclusive OR
+            uint8_t res = m_dataMem[r] ^ m_dataMem[d];
+            flags_znv0s( res );
+            m_dataMem[d] = res;
+        }    break;
+        case AVR_OR: {    // OR -- Logical OR
+            uint8_t res = m_dataMem[r] | m_dataMem[d];
+            flags_znv0s( res );
             m_dataMem[d] = res;
         }    break;
+        case AVR_MOV: {    // MOV
+            m_dataMem[d] = m_dataMem[r];
+        }    break;
 
-        case 0x3000: {    // CPI -- Compare Immediate -- 0011 kkkk hhhh kkkk
-            get_vh4_k8( instruction );
+        case AVR_CPI: {    // CPI -- Compare Immediate
+            uint8_t vh = m_dataMem[d];
             uint8_t res = vh - k;
             flags_sub_zns( res, vh, k);
         }    break;
-
-        case 0x4000: {    // SBCI -- Subtract Immediate With Carry -- 0100 kkkk hhhh kkkk
-            get_vh4_k8( instruction );
+        case AVR_SBCI: {    // SBCI -- Subtract Immediate With Carry
+            uint8_t vh = m_dataMem[d];
             uint8_t res = vh - k - STATUS( S_C );
-            m_dataMem[h] = res;
+            m_dataMem[d] = res;
             flags_sub_Rzns( res, vh, k);
         }    break;
-
-        case 0x5000: {    // SUBI -- Subtract Immediate -- 0101 kkkk hhhh kkkk
-            get_vh4_k8( instruction );
+        case AVR_SUBI: {    // SUBI -- Subtract Immediate
+            uint8_t vh = m_dataMem[d];
             uint8_t res = vh - k;
-            m_dataMem[h] = res;
+            m_dataMem[d] = res;
             flags_sub_zns( res, vh, k);
         }    break;
-
-        case 0x6000: {    // ORI aka SBR -- Logical OR with Immediate -- 0110 kkkk hhhh kkkk
-            get_vh4_k8( instruction );
-            uint8_t res = vh | k;
-            m_dataMem[h] = res;
+        case AVR_ORI: {    // ORI aka SBR -- Logical OR with Immediate
+            uint8_t res = m_dataMem[d] | k;
+            m_dataMem[d] = res;
             flags_znv0s( res);
         }    break;
-
-        case 0x7000: {    // ANDI    -- Logical AND with Immediate -- 0111 kkkk hhhh kkkk
-            get_vh4_k8( instruction );
-            uint8_t res = vh & k;
-            m_dataMem[h] = res;
+        case AVR_ANDI: {    // ANDI -- Logical AND with Immediate
+            uint8_t res = m_dataMem[d] & k;
+            m_dataMem[d] = res;
             flags_znv0s( res );
         }    break;
 
-        case 0xa000:
-        case 0x8000: {
-            /*
-             * Load( LDD/STD) store instructions
-             *
-             * 10q0 qqsd dddd yqqq
-             * s = 0 = load, 1 = store
-             * y = 16 bits register index, 1 = Y, 0 = X
-             * q = 6 bit displacement
-             */
-            uint16_t v = 0;
-            switch( instruction & 0xd008 )
-            {
-                case 0xa000:
-                case 0x8000: {    // LD( LDD) -- Load Indirect using Z -- 10q0 qqsd dddd yqqq
-                    v = m_dataMem[R_ZL] | ( m_dataMem[R_ZH] << 8);
-                }    break;
-                case 0xa008:
-                case 0x8008: {    // LD( LDD) -- Load Indirect using Y -- 10q0 qqsd dddd yqqq
-                    v = m_dataMem[R_YL] | ( m_dataMem[R_YH] << 8);
-                }    break;
-                //default: ;//_avr_invalid_instruction(avr);
-            }
-            get_d5_q6( instruction );
-            if( instruction & 0x0200) SET_RAM( v+q, m_dataMem[d] );
-            else                      SET_RAM( d, GET_RAM(v+q) );
+        case AVR_LDD_Y:
+        case AVR_LDD_Z:
+        case AVR_STD_Y:
+        case AVR_STD_Z: {    // LD/ST (LDD/STD) -- Indirect using Y or Z with displacement
+            uint16_t v;
+            if( op == AVR_LDD_Y || op == AVR_STD_Y ) v = m_dataMem[R_YL] | ( m_dataMem[R_YH] << 8);
+            else                                                  v = m_dataMem[R_ZL] | ( m_dataMem[R_ZH] << 8);
+
+            if( op >= AVR_STD_Y ) SET_RAM( v+k, m_dataMem[d] );
+            else                        SET_RAM( d, GET_RAM(v+k) );
             cycle += 1; // 2 cycles, 3 for tinyavr
         }    break;
 
-        case 0x9000: {
-            // SREG set/clear instructions
-            // SEH,SEI,SEN,SES,SET,SEV,SEZ; CLH,CLI,CLN,CLS,CLT,CLV,CLZ
-            if( (instruction & 0xff0f) == 0x9408 )
-            {
-                uint8_t bit = (instruction >> 4) & 7;
-                bool set = (instruction & 0x0080) == 0;
-                write_S_Bit( bit, set );
-                if( bit == S_I ) m_mcu->enableInterrupts( set );
+        case AVR_SREG: {    // SEH,SEI,SEN,SES,SET,SEV,SEZ; CLH,CLI,CLN,CLS,CLT,CLV,CLZ
+            write_S_Bit( d, b );
+            if( d == S_I ) m_mcu->enableInterrupts( b );
+        }    break;
+        case AVR_SLEEP: {    // SLEEP
+            qDebug() <<"Warning: AVR SLEEP instruction not Fully implemented";
+            m_mcu->sleep( true );
+        }    break;
+        case AVR_BREAK: {    // BREAK
+            qDebug() <<"ERROR: AVR BREAK instruction not implemented";
+        }    break;
+        case AVR_WDR: {    // WDR -- Watchdog Reset
+            m_mcu->wdr();
+        }    break;
+        case AVR_SPM: {    // SPM -- Store Program Memory
+            if( m_PC >= m_bootStart ) writeFlash();
+            else{
+                qDebug() <<"ERROR: AVR SPM instruction from PGM address"<< m_PC;
+                qDebug() <<"Boot start:" << m_bootStart;
             }
-            switch( instruction )
-            {
-                case 0x9588: { // SLEEP -- 1001 0101 1000 1000
-                    /* Don't sleep if there are interrupts about to be serviced.
-                     * Without this check, it was possible to incorrectly enter a state
-                     * in which the cpu was sleeping and interrupts were disabled. For more
-                     * details, see the commit message. */
-                    qDebug() <<"Warning: AVR SLEEP instruction not Fully implemented";
-////////             if( !int_pending.empty() || !SREG[S_I]) state = cpu_Sleeping;
-
-                    m_mcu->sleep( true );
-                }    break;
-                case 0x9598: { // BREAK -- 1001 0101 1001 1000
-                    qDebug() <<"ERROR: AVR BREAK instruction not implemented";
-                }    break;
-                case 0x95a8: { // WDR -- Watchdog Reset -- 1001 0101 1010 1000
-                    m_mcu->wdr();
-                }    break;
-                case 0x95e8: { // SPM -- Store Program Memory -- 1001 0101 1110 1000
-                    //qDebug() <<"ERROR: AVR SPM instruction not implemented";
-                    if( m_PC >= m_bootStart ) writeFlash();
-                    else{
-                        qDebug() <<"ERROR: AVR SPM instruction from PGM address"<< m_PC;
-                        qDebug() <<"Boot start:" << m_bootStart;
-                    }
-                }    break;
-                case 0x9409:   // IJMP   -- Indirect jump -- 1001 0100 0000 1001
-                case 0x9419:   // EIJMP  -- Indirect jump -- 1001 0100 0001 1001   bit 4 is "Extended"
-                case 0x9509:   // ICALL  -- Indirect Call to Subroutine -- 1001 0101 0000 1001
-                case 0x9519: { // EICALL -- Indirect Call to Subroutine -- 1001 0101 0001 1001   bit 8 is "Call: push pc"
-                    int exte = instruction & 0x10;  // Extended
-                    int call = instruction & 0x100; // Call: push pc
-                    uint32_t z = m_dataMem[R_ZL] | (m_dataMem[R_ZH] << 8);
-                    if( exte ){
-                        if( !EIND ){
-                            qDebug() << "ERROR: AVR Invalid instruction: EICALL with no EIND";
-                            break;
-                        }
-                        z |= *EIND << 16;
-                    }
-                    if( call ){
-                        PUSH_STACK( new_pc );
-                        m_RET_ADDR = new_pc;
-                        cycle += m_progAddrSize-1;
-                    }
-                    new_pc = z;
-                    cycle++;
-                }    break;
-                case 0x9518:     // RETI -- Return from Interrupt -- 1001 0101 0001 1000
-                    m_mcu->interrupts()->retI();// SREG flag managed in AvrInterrupt
-                case 0x9508: {   // RET -- Return -- 1001 0101 0000 1000
-                    new_pc = POP_STACK();
-                    cycle += 1 + m_progAddrSize;
-                }    break;
-                case 0x95c8: {    // LPM -- Load Program Memory R0 <-( Z) -- 1001 0101 1100 1000
-                    uint16_t z = m_dataMem[R_ZL] |( m_dataMem[R_ZH] << 8);
-                    cycle += 2; // 3 cycles
-                    uint16_t prgData = m_progMem[z/2];
-                    if( z&1 ) prgData >>= 8;
-                    m_dataMem[0] = prgData & 0xFF;
-                }    break;
-                case 0x95d8: {    // ELPM -- Load Program Memory R0 <-( Z) -- 1001 0101 1101 1000
-                    if( !RAMPZ){
-                        qDebug() << "ERROR: AVR Invalid instruction: ELPM with no RAMPZ";
-                        break;
-                    }
-                    uint32_t z = m_dataMem[R_ZL] |( m_dataMem[R_ZH] << 8) | (*RAMPZ << 16);
-                    uint16_t prgData = m_progMem[z/2];
-                    if( z&1 ) prgData >>= 8;
-                    m_dataMem[0] = prgData & 0xFF;
-                    cycle += 2; // 3 cycles
-                }    break;
-                default:  {
-                    switch( instruction & 0xfe0f) {
-                        case 0x9000: {    // LDS -- Load Direct from Data Space, 32 bits -- 1001 0000 0000 0000
-                            get_d5( instruction );
-                            uint16_t x = m_progMem[new_pc];
-                            new_pc += 1;
-                            m_dataMem[d] = GET_RAM(x);
-                            cycle++; // 2 cycles
-                        }    break;
-                        case 0x9005:
-                        case 0x9004: {    // LPM -- Load Program Memory -- 1001 000d dddd 01oo
-                            get_d5( instruction );
-                            uint16_t z = m_dataMem[R_ZL] | (m_dataMem[R_ZH] << 8);
-                            int op = instruction & 1;
-                            uint16_t prgData = m_progMem[z/2];
-                            if( z&1 ) prgData >>= 8;
-                            m_dataMem[d] = prgData & 0xFF;
-                            if( op) SET_REG16_HL( R_ZL, ++z );
-                            cycle += 2; // 3 cycles
-                        }    break;
-                        case 0x9006:
-                        case 0x9007: {    // ELPM -- Extended Load Program Memory -- 1001 000d dddd 01oo
-                            if( !RAMPZ){
-                                qDebug() << "ERROR: AVR Invalid instruction: ELPM with no RAMPZ";
-                                break;
-                            }
-                            uint16_t z = m_dataMem[R_ZL] |( m_dataMem[R_ZH] << 8) | (*RAMPZ << 16);
-                            get_d5( instruction );
-                            int op = instruction & 1;
-                            uint16_t prgData = m_progMem[z/2];
-                            if( z&1 ) prgData >>= 8;
-                            m_dataMem[d] = prgData & 0xFF;
-                            if( op) {
-                                z++;
-                                m_dataMem[m_rampzAddr] = z >> 16;
-                                SET_REG16_HL( R_ZL, z );
-                            }
-                            cycle += 2; // 3 cycles
-                        }    break;
-                        /*
-                         * Load store instructions
-                         *
-                         * 1001 00sr rrrr iioo
-                         * s = 0 = load, 1 = store
-                         * ii = 16 bits register index, 11 = X, 10 = Y, 00 = Z
-                         * oo = 1) post increment, 2) pre-decrement
-                         */
-                        case 0x900c:
-                        case 0x900d:
-                        case 0x900e: {    // LD -- Load Indirect from Data using X -- 1001 000d dddd 11oo
-                            int op = instruction & 3;
-                            get_d5( instruction );
-                            uint16_t x = (m_dataMem[R_XH] << 8) | m_dataMem[R_XL];
-                            cycle++; // 2 cycles( 1 for tinyavr, except with inc/dec 2)
-                            if( op == 2) x--;
-                            uint8_t vd = GET_RAM(x);
-                            if( op == 1) x++;
-                            SET_REG16_HL( R_XL, x);
-                            m_dataMem[d] = vd;
-                        }    break;
-                        case 0x920c:
-                        case 0x920d:
-                        case 0x920e: {    // ST -- Store Indirect Data Space X -- 1001 001d dddd 11oo
-                            int op = instruction & 3;
-                            get_vd5( instruction );
-                            uint16_t x =( m_dataMem[R_XH] << 8) | m_dataMem[R_XL];
-                            cycle++; // 2 cycles, except tinyavr
-                            if( op == 2) x--;
-                            SET_RAM( x, vd );
-                            if( op == 1) x++;
-                            SET_REG16_HL( R_XL, x);
-                        }    break;
-                        case 0x9009:
-                        case 0x900a: {    // LD -- Load Indirect from Data using Y -- 1001 000d dddd 10oo
-                            int op = instruction & 3;
-                            get_d5( instruction );
-                            uint16_t y =( m_dataMem[R_YH] << 8) | m_dataMem[R_YL];
-                            cycle++; // 2 cycles, except tinyavr
-                            if( op == 2) y--;
-                            uint8_t vd = GET_RAM(y);
-                            if( op == 1) y++;
-                            SET_REG16_HL( R_YL, y);
-                            m_dataMem[d] = vd;
-                        }    break;
-                        case 0x9209:
-                        case 0x920a: {    // ST -- Store Indirect Data Space Y -- 1001 001d dddd 10oo
-                            int op = instruction & 3;
-                            get_vd5( instruction );
-                            uint16_t y =( m_dataMem[R_YH] << 8) | m_dataMem[R_YL];
-                             cycle++;
-                            if( op == 2) y--;
-                            SET_RAM( y, vd );
-                            if( op == 1) y++;
-                            SET_REG16_HL( R_YL, y);
-                        }    break;
-                        case 0x9200: {    // STS -- Store Direct to Data Space, 32 bits -- 1001 0010 0000 0000
-                            get_vd5( instruction );
-                            uint16_t x = m_progMem[new_pc];
-                            new_pc += 1;
-                            cycle++;
-                            SET_RAM( x, vd );
-                        }    break;
-                        case 0x9001:
-                        case 0x9002: {    // LD -- Load Indirect from Data using Z -- 1001 000d dddd 00oo
-                            int op = instruction & 3;
-                            get_d5( instruction );
-                            uint16_t z =( m_dataMem[R_ZH] << 8) | m_dataMem[R_ZL];
-                            cycle++;; // 2 cycles, except tinyavr
-                            if( op == 2) z--;
-                            uint8_t vd = GET_RAM(z);
-                            if( op == 1) z++;
-                            SET_REG16_HL( R_ZL, z);
-                            m_dataMem[d] = vd;
-                        }    break;
-                        case 0x9201:
-                        case 0x9202: {    // ST -- Store Indirect Data Space Z -- 1001 001d dddd 00oo
-                            int op = instruction & 3;
-                            get_vd5( instruction );
-                            uint16_t z =( m_dataMem[R_ZH] << 8) | m_dataMem[R_ZL];
-                             cycle++; // 2 cycles, except tinyavr
-                            if( op == 2) z--;
-                            SET_RAM( z, vd );
-                            if( op == 1 ) z++;
-                            SET_REG16_HL( R_ZL, z);
-                        }    break;
-                        case 0x900f: {    // POP -- 1001 000d dddd 1111
-                            get_d5( instruction );
-                            m_dataMem[d] = POP_STACK8();
-                            cycle++;
-                        }    break;
-                        case 0x920f: {    // PUSH -- 1001 001d dddd 1111
-                            get_vd5( instruction );
-                            PUSH_STACK8(vd);
-                            cycle++;
-                        }    break;
-                        case 0x9400: {    // COM -- One's Complement -- 1001 010d dddd 0000
-                            get_vd5( instruction );
-                            uint8_t res = 0xff - vd;
-                            m_dataMem[d] = res;
-                            flags_znv0s( res );
-                            set_S_Bit( S_C );
-                        }    break;
-                        case 0x9401: {    // NEG -- Two's Complement -- 1001 010d dddd 0001
-                            get_vd5( instruction );
-                            uint8_t res = 0x00 - vd;
-                            m_dataMem[d] = res;
-                            write_S_Bit( S_H, ((res >> 3)|( vd >> 3)) & 1 );
-                            write_S_Bit( S_V, res == 0x80 );
-                            write_S_Bit( S_C, res != 0 );
-                            flags_zns( res );
-                        }    break;
-                        case 0x9402: {    // SWAP -- Swap Nibbles -- 1001 010d dddd 0010
-                            get_vd5( instruction );
-                            uint8_t res =( vd >> 4) | ( vd << 4) ;
-                            m_dataMem[d] = res;
-                        }    break;
-                        case 0x9403: {    // INC -- Increment -- 1001 010d dddd 0011
-                            get_vd5( instruction );
-                            uint8_t res = vd + 1;
-                            m_dataMem[d] = res;
-                            write_S_Bit( S_V, res == 0x80 );
-                            flags_zns( res);
-                        }    break;
-                        case 0x9405: {    // ASR -- Arithmetic Shift Right -- 1001 010d dddd 0101
-                            get_vd5( instruction );
-                            uint8_t res = (vd >> 1) |(vd & 0x80);
-                            m_dataMem[d] = res;
-                            flags_zcnvs( res, vd );
-                        }    break;
-                        case 0x9406: {    // LSR -- Logical Shift Right -- 1001 010d dddd 0110
-                            get_vd5( instruction );
-                            uint8_t res = vd >> 1;
-                            m_dataMem[d] = res;
-                            clear_S_Bit( S_N );
-                            flags_zcvs( res, vd);
-                        }    break;
-                        case 0x9407: {    // ROR -- Rotate Right -- 1001 010d dddd 0111
-                            get_vd5( instruction );
-                            uint8_t res =( STATUS(S_C) ? 0x80 : 0) | vd >> 1;
-                            m_dataMem[d] = res;
-                            flags_zcnvs( res, vd);
-                        }    break;
-                        case 0x940a: {    // DEC -- Decrement -- 1001 010d dddd 1010
-                            get_vd5( instruction );
-                            uint8_t res = vd - 1;
-                            m_dataMem[d] = res;
-                            write_S_Bit( S_V, res == 0x7f );
-                            flags_zns( res );
-                        }    break;
-                        case 0x940c:
-                        case 0x940d: {    // JMP -- Long Call to sub, 32 bits -- 1001 010a aaaa 110a
-                            uint32_t a =( (instruction & 0x01f0) >> 3) |( instruction & 1);
-                            uint16_t x = m_progMem[new_pc];
-                            a =( a << 16) | x;
-                            new_pc = a;
-                            cycle += 2;
-                        }    break;
-                        case 0x940e:
-                        case 0x940f: {    // CALL -- Long Call to sub, 32 bits -- 1001 010a aaaa 111a
-                            uint32_t a =( (instruction & 0x01f0) >> 3) |( instruction & 1);
-                            uint16_t x = m_progMem[new_pc];
-                            a =( a << 16) | x;
-                            new_pc += 1;
-                            PUSH_STACK( new_pc );
-                            m_RET_ADDR = new_pc;
-                            cycle += 1+m_progAddrSize;
-                            new_pc = a;
-                        }    break;
-
-                        default: {
-                            switch( instruction & 0xff00) {
-                                case 0x9600: {    // ADIW -- Add Immediate to Word -- 1001 0110 KKpp KKKK
-                                    get_vp2_k6( instruction );
-                                    uint16_t res = vp + k;
-                                    SET_REG16_HL( p, res );
-                                    /// SREG[S_V] =( (~vp & res) >> 15) & 1;
-                                    write_S_Bit( S_V, (~vp & res) & (1<<15) );
-
-                                    ///SREG[S_C] =( (~res & vp) >> 15) & 1;
-                                    write_S_Bit( S_C, (~res & vp) & (1<<15) );
-
-                                    flags_zns16( res );
-                                    cycle++;
-                                }    break;
-                                case 0x9700: {    // SBIW -- Subtract Immediate from Word -- 1001 0111 KKpp KKKK
-                                    get_vp2_k6( instruction );
-                                    uint16_t res = vp - k;
-                                    SET_REG16_HL( p, res );
-                                    /// SREG[S_V] =( (vp & ~res) >> 15) & 1;
-                                    write_S_Bit( S_V, (vp & ~res) & (1<<15) );
-
-                                    ///SREG[S_C] =( (res & ~vp) >> 15) & 1;
-                                    write_S_Bit( S_C, (res & ~vp) & (1<<15) );
-
-                                    flags_zns16( res );
-                                    cycle++;
-                                }    break;
-                                case 0x9800: {    // CBI -- Clear Bit in I/O Register -- 1001 1000 AAAA Abbb
-                                    get_io5_b3mask( instruction );
-                                    uint8_t res = GET_RAM( io ) & ~mask;
-                                    SET_RAM( io, res );
-                                    cycle++;
-                                }    break;
-                                case 0x9900: {    // SBIC -- Skip if Bit in I/O Register is Cleared -- 1001 1001 AAAA Abbb
-                                    get_io5_b3mask( instruction );
-                                    uint8_t res = GET_RAM( io ) & mask;
-                                    if( !res)
-                                    {
-                                        if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2; }
-                                        else                       { new_pc += 1; cycle++; }
-                                    }
-                                }    break;
-                                case 0x9a00: {    // SBI -- Set Bit in I/O Register -- 1001 1010 AAAA Abbb
-                                    get_io5_b3mask( instruction );
-                                    uint8_t res = GET_RAM( io ) | mask;
-                                    SET_RAM( io, res );
-                                    cycle++;
-                                }    break;
-                                case 0x9b00: {    // SBIS -- Skip if Bit in I/O Register is Set -- 1001 1011 AAAA Abbb
-                                    get_io5_b3mask( instruction );
-                                    uint8_t res = GET_RAM( io ) & mask;
-                                    if( res )
-                                    {
-                                        if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2; }
-                                        else                       { new_pc += 1; cycle++; }
-                                    }
-                                }    break;
-                                default:
-                                    switch( instruction & 0xfc00) {
-                                        case 0x9c00: {    // MUL -- Multiply Unsigned -- 1001 11rd dddd rrrr
-                                            get_vd5_vr5( instruction );
-                                            uint16_t res = vd * vr;
-                                            cycle++;
-                                            SET_REG16_LH( 0, res );
-                                            write_S_Bit( S_Z, res == 0 );
-
-                                            /// SREG[S_C] =( res >> 15) & 1;
-                                            write_S_Bit( S_C, res & (1<<15) );
-                                        }    break;
-                                        default: ;//_avr_invalid_instruction(avr);
-                                    }
-                            }
-                        }    break;
-                    }
-                }    break;
+        }    break;
+        case AVR_IJMP: {    // IJMP, EIJMP, ICALL, EICALL -- Indirect jump/call
+            uint32_t z = m_dataMem[R_ZL] | (m_dataMem[R_ZH] << 8);
+            if( d ){        // Extended
+                if( !EIND ){
+                    qDebug() << "ERROR: AVR Invalid instruction: EICALL with no EIND";
+                    break;
+                }
+                z |= *EIND << 16;
+            }
+            if( b ){        // Call: push pc
+                PUSH_STACK( new_pc );
+                m_RET_ADDR = new_pc;
+                cycle += m_progAddrSize-1;
+            }
+            new_pc = z;
+            cycle++;
+        }    break;
+        case AVR_RETI:     // RETI -- Return from Interrupt
+            m_mcu->interrupts()->retI();// SREG flag managed in AvrInterrupt
+        case AVR_RET: {    // RET -- Return
+            new_pc = POP_STACK();
+            cycle += 1 + m_progAddrSize;
+        }    break;
+        case AVR_LPM_R0: {    // LPM -- Load Program Memory R0 <-( Z)
+            uint16_t z = m_dataMem[R_ZL] |( m_dataMem[R_ZH] << 8);
+            cycle += 2; // 3 cycles
+            uint16_t prgData = m_progMem[z/2];
+            if( z&1 ) prgData >>= 8;
+            m_dataMem[0] = prgData & 0xFF;
+        }    break;
+        case AVR_ELPM_R0: {    // ELPM -- Load Program Memory R0 <-( Z)
+            if( !RAMPZ){
+                qDebug() << "ERROR: AVR Invalid instruction: ELPM with no RAMPZ";
+                break;
             }
+            uint32_t z = m_dataMem[R_ZL] |( m_dataMem[R_ZH] << 8) | (*RAMPZ << 16);
+            uint16_t prgData = m_progMem[z/2];
+            if( z&1 ) prgData >>= 8;
+            m_dataMem[0] = prgData & 0xFF;
+            cycle += 2; // 3 cycles
         }    break;
 
-        case 0xb000: {
-            switch( instruction & 0xf800) {
-                case 0xb800: {    // OUT A,Rr -- 1011 1AAd dddd AAAA
-                    get_d5_a6( instruction );
-                    SET_RAM( A, m_dataMem[d] );
-                }    break;
-                case 0xb000: {    // IN Rd,A -- 1011 0AAd dddd AAAA
-                    get_d5_a6( instruction );
-                    m_dataMem[d] = GET_RAM(A);
-                }    break;
-                default: ;//_avr_invalid_instruction(avr);
+        case AVR_LDS: {    // LDS -- Load Direct from Data Space, 32 bits
+            new_pc += 1;
+            m_dataMem[d] = GET_RAM( k );
+            cycle++; // 2 cycles
+        }    break;
+        case AVR_STS: {    // STS -- Store Direct to Data Space, 32 bits
+            new_pc += 1;
+            cycle++;
+            SET_RAM( k, m_dataMem[d] );
+        }    break;
+        case AVR_LPM: {    // LPM -- Load Program Memory
+            uint16_t z = m_dataMem[R_ZL] | (m_dataMem[R_ZH] << 8);
+            uint16_t prgData = m_progMem[z/2];
+            if( z&1 ) prgData >>= 8;
+            m_dataMem[d] = prgData & 0xFF;
+            if( b ) SET_REG16_HL( R_ZL, ++z );
+            cycle += 2; // 3 cycles
+        }    break;
+        case AVR_ELPM: {    // ELPM -- Extended Load Program Memory
+            if( !RAMPZ){
+                qDebug() << "ERROR: AVR Invalid instruction: ELPM with no RAMPZ";
+                break;
+            }
+            uint16_t z = m_dataMem[R_ZL] |( m_dataMem[R_ZH] << 8) | (*RAMPZ << 16);
+            uint16_t prgData = m_progMem[z/2];
+            if( z&1 ) prgData >>= 8;
+            m_dataMem[d] = prgData & 0xFF;
+            if( b ) {
+                z++;
+                m_dataMem[m_rampzAddr] = z >> 16;
+                SET_REG16_HL( R_ZL, z );
             }
+            cycle += 2; // 3 cycles
         }    break;
 
-        case 0xc000: {    // RJMP -- 1100 kkkk kkkk kkkk
-            const int16_t k = ((int16_t)((instruction << 4) & 0xFFFF)) >> 4;
-            new_pc = (new_pc + k) % m_progSize;
+        // Load store instructions, b = 1) post increment, 2) pre-decrement
+        case AVR_LD_X:
+        case AVR_LD_Y:
+        case AVR_LD_Z: {    // LD -- Load Indirect from Data using X, Y or Z
+            uint16_t reg = (op == AVR_LD_X) ? R_XL : (op == AVR_LD_Y) ? R_YL : R_ZL;
+            uint16_t x = (m_dataMem[reg+1] << 8) | m_dataMem[reg];
+            cycle++; // 2 cycles( 1 for tinyavr, except with inc/dec 2)
+            if( b == 2) x--;
+            uint8_t vd = GET_RAM(x);
+            if( b == 1) x++;
+            SET_REG16_HL( reg, x);
+            m_dataMem[d] = vd;
+        }    break;
+        case AVR_ST_X:
+        case AVR_ST_Y:
+        case AVR_ST_Z: {    // ST -- Store Indirect Data Space X, Y or Z
+            uint16_t reg = (op == AVR_ST_X) ? R_XL : (op == AVR_ST_Y) ? R_YL : R_ZL;
+            uint8_t vd = m_dataMem[d];
+            uint16_t x =( m_dataMem[reg+1] << 8) | m_dataMem[reg];
+            cycle++; // 2 cycles, except tinyavr
+            if( b == 2) x--;
+            SET_RAM( x, vd );
+            if( b == 1) x++;
+            SET_REG16_HL( reg, x);
+        }    break;
+        case AVR_POP: {    // POP
+            m_dataMem[d] = POP_STACK8();
+            cycle++;
+        }    break;
+        case AVR_PUSH: {    // PUSH
+            PUSH_STACK8( m_dataMem[d] );
             cycle++;
         }    break;
 
-        case 0xd000: {    // RCALL -- 1101 kkkk kkkk kkkk
-            const int16_t k = ((int16_t)((instruction << 4) & 0xFFFF)) >> 4;
+        case AVR_COM: {    // COM -- One's Complement
+            uint8_t res = 0xff - m_dataMem[d];
+            m_dataMem[d] = res;
+            flags_znv0s( res );
+            set_S_Bit( S_C );
+        }    break;
+        case AVR_NEG: {    // NEG -- Two's Complement
+            uint8_t vd = m_dataMem[d];
+            uint8_t res = 0x00 - vd;
+            m_dataMem[d] = res;
+            write_S_Bit( S_H, ((res >> 3)|( vd >> 3)) & 1 );
+            write_S_Bit( S_V, res == 0x80 );
+            write_S_Bit( S_C, res != 0 );
+            flags_zns( res );
+        }    break;
+        case AVR_SWAP: {    // SWAP -- Swap Nibbles
+            uint8_t vd = m_dataMem[d];
+            m_dataMem[d] =( vd >> 4) | ( vd << 4);
+        }    break;
+        case AVR_INC: {    // INC -- Increment
+            uint8_t res = m_dataMem[d] + 1;
+            m_dataMem[d] = res;
+            write_S_Bit( S_V, res == 0x80 );
+            flags_zns( res);
+        }    break;
+        case AVR_ASR: {    // ASR -- Arithmetic Shift Right
+            uint8_t vd = m_dataMem[d];
+            uint8_t res = (vd >> 1) |(vd & 0x80);
+            m_dataMem[d] = res;
+            flags_zcnvs( res, vd );
+        }    break;
+        case AVR_LSR: {    // LSR -- Logical Shift Right
+            uint8_t vd = m_dataMem[d];
+            uint8_t res = vd >> 1;
+            m_dataMem[d] = res;
+            clear_S_Bit( S_N );
+            flags_zcvs( res, vd);
+        }    break;
+        case AVR_ROR: {    // ROR -- Rotate Right
+            uint8_t vd = m_dataMem[d];
+            uint8_t res =( STATUS(S_C) ? 0x80 : 0) | vd >> 1;
+            m_dataMem[d] = res;
+            flags_zcnvs( res, vd);
+        }    break;
+        case AVR_DEC: {    // DEC -- Decrement
+            uint8_t res = m_dataMem[d] - 1;
+            m_dataMem[d] = res;
+            write_S_Bit( S_V, res == 0x7f );
+            flags_zns( res );
+        }    break;
+
+        case AVR_JMP: {    // JMP -- Long Jump, 32 bits
+            new_pc = k;
+            cycle += 2;
+        }    break;
+        case AVR_CALL: {    // CALL -- Long Call to sub, 32 bits
+            new_pc += 1;
+            PUSH_STACK( new_pc );
+            m_RET_ADDR = new_pc;
+            cycle += 1+m_progAddrSize;
+            new_pc = k;
+        }    break;
+
+        case AVR_ADIW: {    // ADIW -- Add Immediate to Word
+            uint16_t vp = m_dataMem[d] | (m_dataMem[d + 1] << 8);
+            uint16_t res = vp + k;
+            m_dataMem[d]   = res;    // r24-r31: no watchers
+            m_dataMem[d+1] = res>>8;
+            write_S_Bit( S_V, (~vp & res) & (1<<15) );
+            write_S_Bit( S_C, (~res & vp) & (1<<15) );
+            flags_zns16( res );
+            cycle++;
+        }    break;
+        case AVR_SBIW: {    // SBIW -- Subtract Immediate from Word
+            uint16_t vp = m_dataMem[d] | (m_dataMem[d + 1] << 8);
+            uint16_t res = vp - k;
+            m_dataMem[d]   = res;    // r24-r31: no watchers
+            m_dataMem[d+1] = res>>8;
+            write_S_Bit( S_V, (vp & ~res) & (1<<15) );
+            write_S_Bit( S_C, (res & ~vp) & (1<<15) );
+            flags_zns16( res );
+            cycle++;
+        }    break;
+        case AVR_CBI: {    // CBI -- Clear Bit in I/O Register
+            SET_RAM( d, GET_RAM( d ) & ~b );
+            cycle++;
+        }    break;
+        case AVR_SBI: {    // SBI -- Set Bit in I/O Register
+            SET_RAM( d, GET_RAM( d ) | b );
+            cycle++;
+        }    break;
+        case AVR_SBIC:      // SBIC -- Skip if Bit in I/O Register is Cleared
+        case AVR_SBIS: {    // SBIS -- Skip if Bit in I/O Register is Set
+            bool set = GET_RAM( d ) & b;
+            if( set == (op == AVR_SBIS) )
+            {
+                if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2; }
+                else                       { new_pc += 1; cycle++; }
+            }
+        }    break;
+        case AVR_MUL: {    // MUL -- Multiply Unsigned
+            uint16_t res = m_dataMem[d] * m_dataMem[r];
+            cycle++;
+            SET_REG16_LH( 0, res );
+            write_S_Bit( S_Z, res == 0 );
+            write_S_Bit( S_C, res & (1<<15) );
+        }    break;
+
+        case AVR_OUT: {    // OUT A,Rr
+            SET_RAM( k, m_dataMem[d] );
+        }    break;
+        case AVR_IN: {    // IN Rd,A
+            m_dataMem[d] = GET_RAM( k );
+        }    break;
+
+        case AVR_RJMP: {    // RJMP
+            new_pc = (new_pc + k) % m_progSize;
+            cycle++;
+        }    break;
+        case AVR_RCALL: {    // RCALL
             cycle += m_progAddrSize;
             PUSH_STACK( new_pc );
             m_RET_ADDR = new_pc;
             new_pc = (new_pc + k) % m_progSize;
         }    break;
-
-        case 0xe000: {    // LDI Rd, K aka SER( LDI r, 0xff) -- 1110 kkkk dddd kkkk
-            get_h4_k8( instruction );
-            m_dataMem[h] = k;
+        case AVR_LDI: {    // LDI Rd, K aka SER( LDI r, 0xff)
+            m_dataMem[d] = k;
         }    break;
 
-        case 0xf000: {
-            switch( instruction & 0xfe00)
+        case AVR_BRBS:      // BRXS -- Branch if SREG bit set
+        case AVR_BRBC: {    // BRXC -- Branch if SREG bit cleared
+            bool set = STATUS( d );
+            if( set == (op == AVR_BRBS) )
             {
-                case 0xf000:
-                case 0xf200:
-                case 0xf400:
-                case 0xf600: {    // BRXC/BRXS -- All the SREG branches -- 1111 0Boo oooo osss
-                    int16_t o =( (int16_t)(instruction << 6)) >> 9; // offset
-                    uint8_t s = instruction & 7;
-                    bool set =( instruction & 0x0400) == 0;        // this bit means BRXC otherwise BRXS
-                    int branch =( STATUS(s) && set) ||( !STATUS(s) && !set);
-                    if( branch) {
-                        cycle++; // 2 cycles if taken, 1 otherwise
-                        new_pc = new_pc + o;
-                    }
-                }    break;
-                case 0xf800:
-                case 0xf900: {    // BLD -- Bit Store from T into a Bit in Register -- 1111 100d dddd 0bbb
-                    get_vd5_s3_mask( instruction );
-                    uint8_t v =( vd & ~mask) |( STATUS(S_T) ? mask : 0);
-                    m_dataMem[d] = v;
-                }    break;
-                case 0xfa00:
-                case 0xfb00:{    // BST -- Bit Store into T from bit in Register -- 1111 101d dddd 0bbb
-                    get_vd5_s3( instruction )
-                    write_S_Bit( S_T, ( vd >> s) & 1 );
-                }    break;
-                case 0xfc00:
-                case 0xfe00: {    // SBRS/SBRC -- Skip if Bit in Register is Set/Clear -- 1111 11sd dddd 0bbb
-                    get_vd5_s3_mask( instruction )
-                    int set =( instruction & 0x0200) != 0;
-                    int branch =( (vd & mask) && set) ||( !(vd & mask) && !set);
-                    if( branch)
-                    {
-                        if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2;}
-                        else                       { new_pc += 1; cycle++; }
-                    }   break;
-                }
-                default: ;//_avr_invalid_instruction(avr);
+                cycle++; // 2 cycles if taken, 1 otherwise
+                new_pc = new_pc + k;
+            }
+        }    break;
+        case AVR_BLD: {    // BLD -- Bit Store from T into a Bit in Register
+            m_dataMem[d] =( m_dataMem[d] & ~b) |( STATUS(S_T) ? b : 0);
+        }    break;
+        case AVR_BST: {    // BST -- Bit Store into T from bit in Register
+            write_S_Bit( S_T, ( m_dataMem[d] >> b) & 1 );
+        }    break;
+        case AVR_SBRC:      // SBRC -- Skip if Bit in Register is Clear
+        case AVR_SBRS: {    // SBRS -- Skip if Bit in Register is Set
+            bool set = m_dataMem[d] & b;
+            if( set == (op == AVR_SBRS) )
+            {
+                if( is_instr_32b(new_pc) ) { new_pc += 2; cycle += 2;}
+                else                       { new_pc += 1; cycle++; }
             }
         }    break;
-        default: ;//_avr_invalid_instruction(avr);
     }
     if( new_pc >= m_progSize ) new_pc = 0;
 
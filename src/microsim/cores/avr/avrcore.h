@@ -14,6 +14,30 @@
 #include "mcu8bits.h"
 #include "mcutypes.h"
 
+enum avrOp_t{       // Predecoded instruction handlers
+    AVR_UNDECODED=0,
+    AVR_NOP,        // Also invalid instructions
+    AVR_CPC, AVR_ADD, AVR_SBC, AVR_MOVW, AVR_MULS, AVR_MULSU, AVR_FMUL, AVR_FMULS, AVR_FMULSU,
+    AVR_SUB, AVR_CPSE, AVR_CP, AVR_ADC, AVR_AND, AVR_EOR, AVR_OR, AVR_MOV,
+    AVR_CPI, AVR_SBCI, AVR_SUBI, AVR_ORI, AVR_ANDI,
+    AVR_LDD_Y, AVR_LDD_Z, AVR_STD_Y, AVR_STD_Z,
+    AVR_SREG, AVR_SLEEP, AVR_BREAK, AVR_WDR, AVR_SPM, AVR_IJMP, AVR_RETI, AVR_RET,
+    AVR_LPM_R0, AVR_ELPM_R0, AVR_LDS, AVR_STS, AVR_LPM, AVR_ELPM,
+    AVR_LD_X, AVR_ST_X, AVR_LD_Y, AVR_ST_Y, AVR_LD_Z, AVR_ST_Z, AVR_POP, AVR_PUSH,
+    AVR_COM, AVR_NEG, AVR_SWAP, AVR_INC, AVR_ASR, AVR_LSR, AVR_ROR, AVR_DEC,
+    AVR_JMP, AVR_CALL, AVR_ADIW, AVR_SBIW, AVR_CBI, AVR_SBIC, AVR_SBI, AVR_SBIS, AVR_MUL,
+    AVR_OUT, AVR_IN, AVR_RJMP, AVR_RCALL, AVR_LDI,
+    AVR_BRBS, AVR_BRBC, AVR_BLD, AVR_BST, AVR_SBRC, AVR_SBRS
+};
+
+struct avrInst_t{   // Predecoded instruction
+    uint8_t op;     // avrOp_t
+    uint8_t d;      // Destination register, I/O address or SREG bit
+    uint8_t r;      // Source register
+    uint8_t b;      // Bit mask or mode
+    int32_t k;      // Constant, data address, jump address or offset
+};
+
 class AvrCore : public Mcu8bits
 {
     public:
@@ -23,9 +47,27 @@ class AvrCore : public Mcu8bits
         virtual void reset() override;
         virtual void runStep() override;
 
+        virtual void pgmChanged( uint32_t addr ) override;
+
+        virtual bool nextIsLocal() override;
+
+        virtual uint64_t skipLoop( uint64_t maxCycles ) override;
+
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     private:
+        void decode( uint32_t pc );
+        avrInst_t* getInst( uint32_t pc )
+        {
+            avrInst_t* inst = &m_decoded[pc];
+            if( inst->op == AVR_UNDECODED ) decode( pc );
+            return inst;
+        }
         void writeFlash();
 
+        std::vector<avrInst_t> m_decoded; // Flash decoded when first executed
+
         uint16_t m_bootStart;
 
         int m_pageSize;
@@ -11,6 +11,7 @@
 #include "avreeprom.h"
 #include "datautils.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "simulator.h"
 
 AvrEeprom::AvrEeprom( eMcu* mcu, QString name )
@@ -103,3 +104,14 @@ void AvrEeprom::writeEeprom()
     Simulator::self()->addEvent( time, this ); // Shedule Write cycle end
 }
 
+bool AvrEeprom::saveState( StateStream* s )
+{
+    s->put( m_mode );
+    return McuEeprom::saveState( s );
+}
+
+void AvrEeprom::loadState( StateStream* s )
+{
+    s->get( m_mode );
+    McuEeprom::loadState( s );
+}
@@ -23,6 +23,9 @@ class AvrEeprom : public McuEeprom
 
         virtual void writeEeprom() override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     private:
         uint64_t m_nextCycle;
 
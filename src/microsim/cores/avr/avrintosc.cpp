@@ -7,6 +7,7 @@
 
 #include "avrintosc.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcu.h"
 #include "datautils.h"
 
@@ -64,3 +65,15 @@ bool AvrIntOsc::freqChanged()
     m_mcu->setFreq( m_intOscFreq );
     return true;
 }
+
+bool AvrIntOsc::saveState( StateStream* s )
+{
+    s->put( m_prIndex );
+    return McuIntOsc::saveState( s );
+}
+
+void AvrIntOsc::loadState( StateStream* s )
+{
+    s->get( m_prIndex );
+    McuIntOsc::loadState( s );
+}
@@ -20,6 +20,9 @@ class AvrIntOsc : public McuIntOsc
 
         virtual bool freqChanged() override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     private:
         uint8_t m_prIndex;
 
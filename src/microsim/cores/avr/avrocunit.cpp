@@ -8,6 +8,7 @@
 #include "mcupin.h"
 #include "mcuocm.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 
 AvrOcUnit::AvrOcUnit( eMcu* mcu, QString name )
          : McuOcUnit( mcu, name )
@@ -66,3 +67,15 @@ void AvrOcUnit::setOcrMask( uint16_t mask )
     if( m_ocRegH ) m_comMatch |= (uint16_t)*m_ocRegH<<8;
     m_comMatch &= m_OCRXmask;
 }
+
+bool AvrOcUnit::saveState( StateStream* s )
+{
+    s->put( m_OCRXmask );
+    return McuOcUnit::saveState( s );
+}
+
+void AvrOcUnit::loadState( StateStream* s )
+{
+    s->get( m_OCRXmask );
+    McuOcUnit::loadState( s );
+}
@@ -22,6 +22,9 @@ class AvrOcUnit : public McuOcUnit
 
         void setOcrMask( uint16_t mask );
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         virtual void setPinSate( bool state, uint64_t time ) override;
 
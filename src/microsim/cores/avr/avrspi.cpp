@@ -7,6 +7,7 @@
 #include "datautils.h"
 #include "iopin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcuinterrupts.h"
 
 AvrSpi::AvrSpi( eMcu* mcu, QString name )
@@ -128,3 +129,15 @@ void AvrSpi::updateSpeed()
     uint64_t div = m_speed2x ? 4 : 2;
     m_clockPeriod = m_mcu->psInst()*m_prescaler/div;
 }
+
+bool AvrSpi::saveState( StateStream* s )
+{
+    s->put( m_speed2x );
+    return McuSpi::saveState( s );
+}
+
+void AvrSpi::loadState( StateStream* s )
+{
+    s->get( m_speed2x );
+    McuSpi::loadState( s );
+}
@@ -24,6 +24,9 @@ class AvrSpi : public McuSpi
         virtual void writeSpiReg( uint8_t newSPDR ) override;
         virtual void endTransaction() override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         void updateSpeed();
 
@@ -8,6 +8,7 @@
 #include "avrocunit.h"
 #include "avricunit.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcupin.h"
 #include "simulator.h"
 #include "regwatcher.h"
@@ -154,6 +155,22 @@ void AvrTimer::configureOcUnits( bool wgm3 )
     else            m_ovfPeriod = m_ovfMatch+1;
 }
 
+bool AvrTimer::saveState( StateStream* s )
+{
+    s->put( m_wgmMode );
+    s->put( m_wgm10Val );
+    s->put( m_wgm32Val );
+    return McuTimer::saveState( s );
+}
+
+void AvrTimer::loadState( StateStream* s )
+{
+    s->get( m_wgmMode );
+    s->get( m_wgm10Val );
+    s->get( m_wgm32Val );
+    McuTimer::loadState( s );
+}
+
 //--------------------------------------------------
 // TIMER 8 Bit--------------------------------------
 
@@ -499,6 +516,18 @@ void AvrTimer822::configureB( uint8_t newASSR )
     }
 }
 
+bool AvrTimer822::saveState( StateStream* s )
+{
+    s->put( m_async );
+    return AvrTimer821::saveState( s );
+}
+
+void AvrTimer822::loadState( StateStream* s )
+{
+    s->get( m_async );
+    AvrTimer821::loadState( s );
+}
+
 //--------------------------------------------------
 // TIMER 16 Bit-------------------------------------
 
@@ -636,3 +665,17 @@ void AvrTimer16bit::setICRX( QString reg )
     /// Low byte triggers red/write operations
     /// watchRegNames( reg, R_WRITE, this, &AvrTimer16bit::ICRXLchanged, m_mcu );
 }
+
+bool AvrTimer16bit::saveState( StateStream* s )
+{
+    s->put( m_useICR );
+    s->put( m_wgmVal );
+    return AvrTimer::saveState( s );
+}
+
+void AvrTimer16bit::loadState( StateStream* s )
+{
+    s->get( m_useICR );
+    s->get( m_wgmVal );
+    AvrTimer::loadState( s );
+}
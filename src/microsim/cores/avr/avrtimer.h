@@ -34,6 +34,9 @@ class AvrTimer : public McuTimer
         virtual void configureA( uint8_t newTCCRXA ) override;
         virtual void configureB( uint8_t newTCCRXB ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         virtual void updtWgm(){;}
         virtual void configureClock();
@@ -152,6 +155,9 @@ class AvrTimer822 : public AvrTimer821
 
         virtual void configureB( uint8_t newASSR ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     private:
         bool m_async;
 
@@ -169,6 +175,9 @@ class AvrTimer16bit : public AvrTimer
 
         virtual void configureC( uint8_t newTCCRXC ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
         virtual void topReg0Changed( uint8_t val ) override;
         void ICRXLchanged( uint8_t val );
         //void ICRXHchanged( uint8_t val );
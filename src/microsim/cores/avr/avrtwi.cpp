@@ -6,6 +6,7 @@
 #include "avrtwi.h"
 #include "mcupin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcuinterrupts.h"
 #include "datautils.h"
 
@@ -191,3 +192,15 @@ void AvrTwi::I2Cstop()
     if( m_mode != TWI_SLAVE ) return;
     if (m_addrMatch) setTwiState( TWI_SRX_STOP_RESTART );
 }
+
+bool AvrTwi::saveState( StateStream* s )
+{
+    s->put( m_bitRate );
+    return McuTwi::saveState( s );
+}
+
+void AvrTwi::loadState( StateStream* s )
+{
+    s->get( m_bitRate );
+    McuTwi::loadState( s );
+}
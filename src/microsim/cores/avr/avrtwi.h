@@ -31,6 +31,9 @@ class AvrTwi : public McuTwi
 
         virtual void I2Cstop() override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         virtual void setTwiState( twiState_t state ) override;
         uint8_t getStaus() { return *m_statReg &= 0b11111000; }
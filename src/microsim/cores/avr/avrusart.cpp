@@ -7,6 +7,7 @@
 #include "usarttx.h"
 #include "usartrx.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "iopin.h"
 #include "serialmon.h"
 #include "datautils.h"
@@ -188,3 +189,19 @@ void AvrUsart::setRxFlags( uint16_t frame )
     writeRegBits( m_DOR, frame & dataOverrun ); // overrun error
     writeRegBits( m_UPE, frame & parityError ); // parityError
 }
+
+bool AvrUsart::saveState( StateStream* s )
+{
+    s->put( m_UBRRHval );
+    s->put( m_ucsz01 );
+    s->put( m_ucsz2 );
+    return McuUsart::saveState( s );
+}
+
+void AvrUsart::loadState( StateStream* s )
+{
+    s->get( m_UBRRHval );
+    s->get( m_ucsz01 );
+    s->get( m_ucsz2 );
+    McuUsart::loadState( s );
+}
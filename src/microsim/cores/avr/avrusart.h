@@ -29,6 +29,9 @@ class AvrUsart : public McuUsart
 
         void setBaurrate( uint8_t ubrr=0 );
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     private:
         void setUBRRnL( uint8_t v );
         void setUBRRnH( uint8_t v );
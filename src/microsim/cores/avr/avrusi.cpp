@@ -7,6 +7,7 @@
 
 #include "avrusi.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcupin.h"
 #include "avrtimer.h"
 #include "mcuocunit.h"
@@ -238,3 +239,46 @@ void AvrUsi::setPins( QString pinStr ) // "DO,DI,USCK"
     m_DIbit = getRegBits( DIpin, m_mcu );
     m_CKbit = getRegBits( CKpin, m_mcu );
 }
+
+bool AvrUsi::saveState( StateStream* s )
+{
+    s->put( m_twi );
+    s->put( m_spi );
+    s->put( m_timer );
+    s->put( m_extClk );
+    s->put( m_usiClk );
+    s->put( m_clkEdge );
+    s->put( m_clkState );
+    s->put( m_sdaState );
+    s->put( m_DoState );
+    s->put( m_mode );
+    s->put( m_clockMode );
+    s->put( m_counter );
+    return true;
+}
+
+void AvrUsi::loadState( StateStream* s )
+{
+    s->get( m_twi );
+    s->get( m_spi );
+    s->get( m_timer );
+    s->get( m_extClk );
+    s->get( m_usiClk );
+    s->get( m_clkEdge );
+    s->get( m_clkState );
+    s->get( m_sdaState );
+    s->get( m_DoState );
+    s->get( m_mode );
+    s->get( m_clockMode );
+    s->get( m_counter );
+
+    if( m_DIpin ){
+        m_DIpin->changeCallBack( this, m_twi );
+        m_DIpin->setOpenColl( m_twi );
+    }
+    if( m_CKpin ){
+        m_CKpin->changeCallBack( this, m_extClk );
+        m_CKpin->setOpenColl( m_twi );
+    }
+    m_t0OCA->getInterrupt()->callBack( this, m_timer );
+}
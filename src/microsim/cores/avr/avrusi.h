@@ -30,6 +30,9 @@ class AvrUsi : public McuModule, public eElement
 
         void setPins( QString pinStr );
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     private:
         inline void stepCounter();
         inline void shiftData();
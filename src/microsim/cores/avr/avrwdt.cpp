@@ -5,6 +5,7 @@
 
 #include "avrwdt.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "cpu8bits.h"
 #include "simulator.h"
 #include "datautils.h"
@@ -113,6 +114,22 @@ void AvrWdt::reset()
     if( m_wdtFuse || !m_disabled ) Simulator::self()->addEvent( m_ovfPeriod, this );
 }
 
+bool AvrWdt::saveState( StateStream* s )
+{
+    s->put( m_allowChanges );
+    s->put( m_disabled );
+    return McuWdt::saveState( s );
+}
+
+void AvrWdt::loadState( StateStream* s )
+{
+    s->get( m_allowChanges );
+    s->get( m_disabled );
+    McuWdt::loadState( s );
+
+    if( m_interrupt ) m_interrupt->exitCallBack( this, !m_disabled && m_ovfInter && m_ovfReset );
+}
+
 //------------------------------------------------------
 //-- AVR WDT Type 00 -----------------------------------
 
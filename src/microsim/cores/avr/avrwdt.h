@@ -27,6 +27,9 @@ class AvrWdt : public McuWdt
 
         virtual void callBack() override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         void wdtEnable();
         virtual void updtPrescaler( uint8_t newWDTCSR ){;}
@@ -8,6 +8,8 @@
 #include "e_mcu.h"
 #include "watched.h"
 
+class StateStream;
+
 #define REG_SPL      m_spl[0]
 #define REG_SPH      m_sph[0]
 #define STATUS(bit) (*m_STATUS & (1<<bit))
@@ -35,6 +37,15 @@ class Cpu8bits : public Watched
 
         virtual void exitSleep() {;}
 
+        virtual void pgmChanged( uint32_t addr ){;} // Program memory word changed: discard decoded instruction
+
+        virtual bool nextIsLocal() { return false; } // Next instruction has no effects outside the Cpu
+
+        virtual uint64_t skipLoop( uint64_t maxCycles ) { return 0; } // Jump over wait loop iterations, returns Clock cycles skipped
+
+        virtual bool saveState( StateStream* ) { return false; } // Cpu variables not in Ram, false if snapshots not supported
+        virtual void loadState( StateStream* ){;}
+
     protected:
         eMcu* m_mcu;
 
@@ -180,6 +180,50 @@ void I51Core::runStep()  // Machine cycle: 1/6 frequency
     if( !extPGM && m_readPC >= m_progSize ) m_readPC -= m_progSize;
 }
 
+uint64_t I51Core::skipLoop( uint64_t maxCycles ) // Last instruction jumped to itself: SJMP $, JNB bit,$, DJNZ Rx,$
+{
+    if( m_cpuState != cpu_FETCH || m_extPGM || m_readPC != m_PC ) return 0;
+
+    uint8_t opcode = m_progMem[m_PC];
+    if( opcode != m_opcode ) return 0;
+
+    uint32_t size;              // Instruction bytes
+    uint64_t loops = maxCycles; // Wait loops only end by interrupt
+    int      counter = -1;      // Delay loop counter address
+
+    switch( opcode ) {
+        case 0x80: size = 2; break;                          // SJMP $
+        case 0x20:                                           // JB  bit,$
+        case 0x30: {                                         // JNB bit,$
+            size = 3;
+            if( !isStableRead( m_bitAddr ) ) return 0;
+            bool set = m_dataMem[m_bitAddr] & m_bitMask;
+            if( set != (opcode == 0x20) ) return 0;          // Not taken: loop ends
+        } break;
+        case 0xD5: size = 3; counter = m_op0; break;         // DJNZ Dir,$
+        default:
+            if( (opcode & 0xF8) != 0xD8 ) return 0;
+            size = 2; counter = m_op0;                       // DJNZ Rx,$
+    }
+    if( m_lastPC != m_PC+size || m_lastPC > m_progSize ) return 0; // Not executed yet at this PC
+    if( (int8_t)m_progMem[m_PC+size-1] != -(int8_t)size ) return 0; // Not jumping to itself
+
+    if( counter >= 0 )
+    {
+        if( !isPlainRam( counter ) || counter > m_lowDataMemEnd ) return 0;
+        uint8_t value = m_dataMem[counter];
+        loops = (value ? value : 256)-1; // Counter stays > 0, last iteration runs normally
+    }
+    uint64_t n = maxCycles/4;   // 4 Read cycles per iteration
+    if( n > loops ) n = loops;
+    if( n == 0 ) return 0;
+
+    if( counter >= 0 ) m_dataMem[counter] -= n;
+
+    m_mcu->cyclesDone = 2*n;    // 2 Machine cycles per iteration
+    return 4*n;
+}
+
 void I51Core::readOperand()
 {
     m_readPC++;
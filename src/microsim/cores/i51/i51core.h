@@ -61,6 +61,8 @@ class I51Core : public Mcu8bits, public eElement
 
         virtual void INTERRUPT( uint32_t addr ) override;
 
+        virtual uint64_t skipLoop( uint64_t maxCycles ) override;
+
     protected:
 
         uint64_t m_psStep;  // Half Clock cycle ps = 1/24 Machine cycle, = 1/12 Read cycle.
@@ -32,6 +32,9 @@ class Mcu8bits : public Cpu8bits
 
         virtual void setPC( uint32_t pc ) { m_PC = pc; }
 
+        bool isPlainRam( uint32_t addr ) { return addr < m_mcu->m_regStart || addr > m_regEnd; } // No Register watchers
+        bool isStableRead( uint32_t addr ) { return isPlainRam( addr ) || !m_mcu->isReadWatched( addr ); } // Value only changes when written
+
         void RETI()
         {
             m_mcu->m_interrupts.retI();
@@ -8,6 +8,10 @@
 
 #include "picmrcore.h"
 
+enum{
+    PIC_TRIS = PIC_CORE_OP
+};
+
 class Pic12Core : public PicMrCore
 {
     public:
@@ -18,7 +22,10 @@ class Pic12Core : public PicMrCore
 
     protected:
         virtual void setBank( uint8_t bank ) override { PicMrCore::setBank( bank ); }
-        virtual void decode( uint16_t instr ) override;
+        virtual void decode( uint16_t instr, picInst_t* inst ) override;
+        virtual void execute( const picInst_t* inst ) override;
+
+        virtual uint16_t directAddr( uint8_t f ) override { return f; } // No banks, INDF = 0
 
         void TRIS();
 
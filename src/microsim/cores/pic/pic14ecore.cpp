@@ -219,57 +219,103 @@ inline void Pic14eCore::MOVWI( uint8_t n, uint8_t k )
     }
 }
 
-void Pic14eCore::decode( uint16_t instr )
+void Pic14eCore::runStep()
+{
+    picInst_t* inst = getInst( m_PC );
+
+    m_mcu->cyclesDone = 0;
+    incDefault();
+    m_RET_ADDR = m_PC;
+
+    Pic14eCore::execute( inst ); // Not virtual: one switch per instruction
+}
+
+void Pic14eCore::execute( const picInst_t* inst )
+{
+    const uint8_t  f = inst->f;
+    const uint16_t k = inst->k;
+
+    switch( inst->op )
+    {
+        case PIC_RESET:    reset();         break;
+        case PIC_CALLW:    CALLW();         break;
+        case PIC_BRW:      BRW();           break;
+        case PIC_MOVIW_iF: MOVIW_iF( f );   break;
+        case PIC_MOVIW_dF: MOVIW_dF( f );   break;
+        case PIC_MOVIW_Fi: MOVIW_Fi( f );   break;
+        case PIC_MOVIW_Fd: MOVIW_Fd( f );   break;
+        case PIC_MOVWI_iF: MOVWI_iF( f );   break;
+        case PIC_MOVWI_dF: MOVWI_dF( f );   break;
+        case PIC_MOVWI_Fi: MOVWI_Fi( f );   break;
+        case PIC_MOVWI_Fd: MOVWI_Fd( f );   break;
+        case PIC_MOVLB:    MOVLB( k );      break;
+
+        case PIC_LSLF:     LSLF( f, k );    break;
+        case PIC_LSRF:     LSRF( f, k );    break;
+        case PIC_ASRF:     ASRF( f, k );    break;
+        case PIC_SUBWFB:   SUBWFB( f, k );  break;
+        case PIC_ADDWFC:   ADDWFC( f, k );  break;
+
+        case PIC_ADDFSR:   ADDFSR( f, k );  break;
+        case PIC_MOVLP:    MOVLP( k );      break;
+        case PIC_BRA:      BRA( k );        break;
+        case PIC_MOVIW:    MOVIW( f, k );   break;
+        case PIC_MOVWI:    MOVWI( f, k );   break;
+
+        PIC_MR_CASES
+    }
+}
+
+void Pic14eCore::decode( uint16_t instr, picInst_t* inst )
 {
     if( (instr & 0x3FC0) == 0 )  // Miscellaneous instrs
     {
         if( (instr & 0x0030) == 0 ){
-            if     ( instr == 0x0001 ) reset(); // RESET 00 0000 0000 0001
-            else if( instr == 0x000A ) CALLW(); // CALLW 00 0000 0000 1010
-            else if( instr == 0x000B ) BRW();   // BRW   00 0000 0000 1011
+            if     ( instr == 0x0001 ) { setInst( inst, PIC_RESET ); return; } // RESET 00 0000 0000 0001
+            else if( instr == 0x000A ) { setInst( inst, PIC_CALLW ); return; } // CALLW 00 0000 0000 1010
+            else if( instr == 0x000B ) { setInst( inst, PIC_BRW );   return; } // BRW   00 0000 0000 1011
         }
         else if( (instr & 0x0030) == 0x10 )
         {
             uint8_t n = instr & 1<<2;
             if( (instr & 0x0008) == 0 ){
                 switch( instr & 0x0003) {
-                    case 0: MOVIW_iF( n ); return; // MOVIW ++FSRn 00 0000 0001 0n00
-                    case 1: MOVIW_dF( n ); return; // MOVIW −−FSRn 00 0000 0001 0n01
-                    case 2: MOVIW_Fi( n ); return; // MOVIW FSRn++ 00 0000 0001 0n10
-                    case 3: MOVIW_Fd( n ); return; // MOVIW FSRn−− 00 0000 0001 0n11
+                    case 0: setInst( inst, PIC_MOVIW_iF, n ); return; // MOVIW ++FSRn 00 0000 0001 0n00
+                    case 1: setInst( inst, PIC_MOVIW_dF, n ); return; // MOVIW −−FSRn 00 0000 0001 0n01
+                    case 2: setInst( inst, PIC_MOVIW_Fi, n ); return; // MOVIW FSRn++ 00 0000 0001 0n10
+                    case 3: setInst( inst, PIC_MOVIW_Fd, n ); return; // MOVIW FSRn−− 00 0000 0001 0n11
                 }
             }else{
                 switch( instr & 0x0003) {
-                    case 0: MOVWI_iF( n ); return; // MOVWI ++FSRn 00 0000 0001 1n00
-                    case 1: MOVWI_dF( n ); return; // MOVWI −−FSRn 00 0000 0001 1n01
-                    case 2: MOVWI_Fi( n ); return; // MOVWI FSRn++ 00 0000 0001 1n10
-                    case 3: MOVWI_Fd( n ); return; // MOVWI FSRn−− 00 0000 0001 1n11
+                    case 0: setInst( inst, PIC_MOVWI_iF, n ); return; // MOVWI ++FSRn 00 0000 0001 1n00
+                    case 1: setInst( inst, PIC_MOVWI_dF, n ); return; // MOVWI −−FSRn 00 0000 0001 1n01
+                    case 2: setInst( inst, PIC_MOVWI_Fi, n ); return; // MOVWI FSRn++ 00 0000 0001 1n10
+                    case 3: setInst( inst, PIC_MOVWI_Fd, n ); return; // MOVWI FSRn−− 00 0000 0001 1n11
                 }
             }
         }
-        else if( (instr & 0x0020) > 0 ) MOVLB( instr & 0x1F ); // MOVLB k 00 0000 001k kkkk
+        else if( (instr & 0x0020) > 0 ) { setInst( inst, PIC_MOVLB, 0, instr & 0x1F ); return; } // MOVLB k 00 0000 001k kkkk
     }
     else if( (instr & 0x3000) == 0x3000 ){
         uint8_t d = instr & 1<<7;
         uint8_t f = instr & 0x007F;
         // ALU operations: dest ← OP(f,W)
         switch( instr & 0x3F00 ) {
-            case 0x3500: LSLF( f, d );   return; // LSLF   f,d 11 0101 dfff ffff
-            case 0x3600: LSRF( f, d );   return; // LSRF   f,d 11 0110 dfff ffff
-            case 0x3700: ASRF( f, d );   return; // ASRF   f,d 11 0111 dfff ffff
-            case 0x3B00: SUBWFB( f, d ); return; // SUBWFB f,d 11 1011 dfff ffff
-            case 0x3D00: ADDWFC( f, d ); return; // ADDWFC f,d 11 1101 dfff ffff
+            case 0x3500: setInst( inst, PIC_LSLF, f, d );   return; // LSLF   f,d 11 0101 dfff ffff
+            case 0x3600: setInst( inst, PIC_LSRF, f, d );   return; // LSRF   f,d 11 0110 dfff ffff
+            case 0x3700: setInst( inst, PIC_ASRF, f, d );   return; // ASRF   f,d 11 0111 dfff ffff
+            case 0x3B00: setInst( inst, PIC_SUBWFB, f, d ); return; // SUBWFB f,d 11 1011 dfff ffff
+            case 0x3D00: setInst( inst, PIC_ADDWFC, f, d ); return; // ADDWFC f,d 11 1101 dfff ffff
         }
         uint8_t n = instr & 1<<6;
         // Operations with literal k
         switch( instr & 0x3F80 ) {
-            case 0x3100: ADDFSR( n, instr & 0x7F ); return; // ADDFSR FSRn,k 11 0001 0nkk kkkk
-            case 0x3180: MOVLP( instr & 0x1F );     return; // MOVLP       k 11 0001 1kkk kkkk
-            case 0x3F00: MOVIW( n, instr & 0x7F );  return; // MOVIW k[FSRn] 11 1111 0nkk kkkk
-            case 0x3F80: MOVWI( n, instr & 0x7F );  return; // MOVWI k[FSRn] 11 1111 1nkk kkkk
+            case 0x3100: setInst( inst, PIC_ADDFSR, n, instr & 0x7F ); return; // ADDFSR FSRn,k 11 0001 0nkk kkkk
+            case 0x3180: setInst( inst, PIC_MOVLP, 0, instr & 0x1F );  return; // MOVLP       k 11 0001 1kkk kkkk
+            case 0x3F00: setInst( inst, PIC_MOVIW, n, instr & 0x7F );  return; // MOVIW k[FSRn] 11 1111 0nkk kkkk
+            case 0x3F80: setInst( inst, PIC_MOVWI, n, instr & 0x7F );  return; // MOVWI k[FSRn] 11 1111 1nkk kkkk
         }
-        if( (instr & 0x3C00) == 0x3200 ){ BRA( instr & 0x1FF); return; }// BRA k 11 001k kkkk kkkk
+        if( (instr & 0x3C00) == 0x3200 ){ setInst( inst, PIC_BRA, 0, instr & 0x1FF ); return; }// BRA k 11 001k kkkk kkkk
     }
-    PicMrCore::decode( instr );
+    PicMrCore::decode( instr, inst );
 }
-
@@ -7,6 +7,14 @@
 
 #include "picmrcore.h"
 
+enum{
+    PIC_RESET = PIC_CORE_OP, PIC_CALLW, PIC_BRW,
+    PIC_MOVIW_iF, PIC_MOVIW_dF, PIC_MOVIW_Fi, PIC_MOVIW_Fd,
+    PIC_MOVWI_iF, PIC_MOVWI_dF, PIC_MOVWI_Fi, PIC_MOVWI_Fd, PIC_MOVLB,
+    PIC_LSLF, PIC_LSRF, PIC_ASRF, PIC_SUBWFB, PIC_ADDWFC,
+    PIC_ADDFSR, PIC_MOVLP, PIC_BRA, PIC_MOVIW, PIC_MOVWI
+};
+
 class Pic14eCore : public PicMrCore
 {
     public:
@@ -15,8 +23,11 @@ class Pic14eCore : public PicMrCore
 
         //virtual void reset();
 
+        virtual void runStep() override;
+
     protected:
-        virtual void decode( uint16_t instr ) override;
+        virtual void decode( uint16_t instr, picInst_t* inst ) override;
+        virtual void execute( const picInst_t* inst ) override;
         virtual void setBank( uint8_t bank ) override { PicMrCore::setBank( bank ); }
 
         uint8_t* m_FSR0L;
@@ -7,6 +7,7 @@
 #include "picvref.h"
 #include "mcupin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "datautils.h"
 #include "regwatcher.h"
 #include "simulator.h"
@@ -80,6 +81,18 @@ void PicAdc::sleep( int mode )
     else             resumeEvents();
 }
 
+bool PicAdc::saveState( StateStream* s )
+{
+    s->put( m_mode );
+    return McuAdc::saveState( s );
+}
+
+void PicAdc::loadState( StateStream* s )
+{
+    s->get( m_mode );
+    McuAdc::loadState( s );
+}
+
 //------------------------------------------------------
 //-- PIC ADC Type 00 -----------------------------------
 
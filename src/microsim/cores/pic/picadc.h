@@ -31,6 +31,9 @@ class PicAdc : public McuAdc
 
         virtual void sleep( int mode ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         virtual void endConversion() override;
         void setAdcClock( uint8_t prs );
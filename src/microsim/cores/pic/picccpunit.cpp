@@ -9,6 +9,7 @@
 #include "datautils.h"
 #include "mcupin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "simulator.h"
 
 PicCcpUnit::PicCcpUnit( eMcu* mcu, QString name, int type )
@@ -96,3 +97,17 @@ void PicCcpUnit::setPin( McuPin* pin )
     m_comUnit->m_ocPin = pin;
     m_pwmUnit->m_ocPin = pin;
 }
+
+bool PicCcpUnit::saveState( StateStream* s )
+{
+    s->put( m_mode );
+    s->put( m_ccpMode );
+    return m_capUnit->saveState( s );
+}
+
+void PicCcpUnit::loadState( StateStream* s )
+{
+    s->get( m_mode );
+    s->get( m_ccpMode );
+    m_capUnit->loadState( s ); // Compare and PWM units saved by Timers
+}
@@ -40,6 +40,9 @@ class PicCcpUnit : public McuModule, public eElement
 
         void setPin( McuPin* pin );
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         uint8_t m_mode;
         ccpMode_t m_ccpMode;
@@ -6,6 +6,7 @@
 #include "piccomparator.h"
 #include "datautils.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcupin.h"
 #include "mcuvref.h"
 
@@ -85,6 +86,21 @@ void PicComp::connect( McuPin* pinN, McuPin* pinP, McuPin* pinOut )
     if( m_pinN ) voltChanged(); // Update Comparator state
 }
 
+bool PicComp::saveState( StateStream* s )
+{
+    s->put( m_inv );
+    return McuComp::saveState( s );
+}
+
+void PicComp::loadState( StateStream* s )
+{
+    s->get( m_inv );
+    McuComp::loadState( s );
+
+    if( m_pinN ) m_pinN->changeCallBack( this, true );
+    if( m_pinP ) m_pinP->changeCallBack( this, true );
+}
+
 //-------------------------------------------------------------
 // Type 0: 16f627 comparators  --------------------------------
 
@@ -118,6 +134,18 @@ void PicComp0::configureA( uint8_t newCMCON )
     voltChanged();
 }
 
+bool PicComp0::saveState( StateStream* s )
+{
+    s->put( m_cis );
+    return PicComp::saveState( s );
+}
+
+void PicComp0::loadState( StateStream* s )
+{
+    s->get( m_cis );
+    PicComp::loadState( s );
+}
+
 //-------------------------------------------------------------
 // Type 01: 16f627 comparator 1 -------------------------------
 
@@ -18,6 +18,9 @@ class PicComp : public McuComp
         virtual void initialize() override;
         virtual void voltChanged() override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
  static PicComp* createComparator( eMcu* mcu, QString name, int type );
 
     protected:
@@ -39,6 +42,9 @@ class PicComp0 : public PicComp
 
         virtual void configureA( uint8_t newCMCON ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         bool m_cis;
 
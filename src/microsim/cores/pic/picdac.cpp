@@ -7,6 +7,7 @@
 
 #include "picdac.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcupin.h"
 #include "picvref.h"
 #include "datautils.h"
@@ -109,3 +110,25 @@ void PicDac::callBack() // Called by FVR
 {
     updtOutVolt();
 }
+
+bool PicDac::saveState( StateStream* s )
+{
+    s->put( m_useFVR );
+    s->put( m_usePinP );
+    s->put( m_usePinN );
+    s->put( m_daclps );
+    return McuDac::saveState( s );
+}
+
+void PicDac::loadState( StateStream* s )
+{
+    s->get( m_useFVR );
+    s->get( m_usePinP );
+    s->get( m_usePinN );
+    s->get( m_daclps );
+    McuDac::loadState( s );
+
+    if( m_pRefPin ) m_pRefPin->changeCallBack( this, m_usePinP );
+    if( m_nRefPin ) m_nRefPin->changeCallBack( this, m_usePinN );
+    updtOutVolt();
+}
@@ -27,6 +27,9 @@ class PicDac:  public McuDac
 
         virtual void callBack() override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         void updtOutVolt();
 
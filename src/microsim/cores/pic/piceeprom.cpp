@@ -6,6 +6,7 @@
 #include "piceeprom.h"
 #include "datautils.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "simulator.h"
 
 PicEeprom::PicEeprom( eMcu* mcu, QString name )
@@ -106,3 +107,18 @@ void PicEeprom::configureB( uint8_t newEECON2 )
     Simulator::self()->addEvent( time, this ); // Shedule Write cycle end
 }*/
 
+bool PicEeprom::saveState( StateStream* s )
+{
+    s->put( m_nextCycle );
+    s->put( m_writeEnable );
+    s->put( m_wrMask );
+    return McuEeprom::saveState( s );
+}
+
+void PicEeprom::loadState( StateStream* s )
+{
+    s->get( m_nextCycle );
+    s->get( m_writeEnable );
+    s->get( m_wrMask );
+    McuEeprom::loadState( s );
+}
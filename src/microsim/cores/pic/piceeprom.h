@@ -22,6 +22,9 @@ class PicEeprom : public McuEeprom
         virtual void configureA( uint8_t newEECON1 ) override;
         virtual void configureB( uint8_t newEECON2 ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     private:
         uint64_t m_nextCycle;
         bool m_writeEnable;
@@ -6,6 +6,7 @@
 #include "picmrcore.h"
 #include "datautils.h"
 #include "regwatcher.h"
+#include "mcusnapshot.h"
 
 PicMrCore::PicMrCore( eMcu* mcu )
          : Mcu8bits( mcu )
@@ -15,6 +16,9 @@ PicMrCore::PicMrCore( eMcu* mcu )
 
     m_PCLaddr = mcu->getRegAddress("PCL");
     m_PCHaddr = mcu->getRegAddress("PCLATH");
+
+    m_decoded.resize( m_progSize );
+    m_wordMask = 0x3FFF;
 }
 PicMrCore::~PicMrCore() {}
 
@@ -265,33 +269,143 @@ void PicMrCore::ADDLW( uint8_t k ) //// C,DC,Z
     *m_Wreg = add( k, *m_Wreg );
 }
 
+void PicMrCore::pgmChanged( uint32_t addr )
+{
+    if( addr < m_decoded.size() ) m_decoded[addr].op = PIC_UNDECODED;
+}
+
+bool PicMrCore::saveState( StateStream* s ) // Hardware Stack is not in Ram
+{
+    s->put( m_PC );
+    s->put( m_RET_ADDR );
+    s->put( m_stack );
+    s->put( m_sp );
+    s->put( m_WregHidden );
+    s->put( m_bank );
+    return true;
+}
+
+void PicMrCore::loadState( StateStream* s )
+{
+    s->get( m_PC );
+    s->get( m_RET_ADDR );
+    s->get( m_stack );
+    s->get( m_sp );
+    s->get( m_WregHidden );
+    s->get( m_bank );
+}
+
+bool PicMrCore::nextIsLocal()
+{
+    const picInst_t* inst = getInst( m_PC );
+
+    switch( inst->op )
+    {
+        case PIC_NOP:   case PIC_RETURN: case PIC_RETLW: case PIC_CALL:  case PIC_GOTO:
+        case PIC_MOVLW: case PIC_IORLW:  case PIC_ANDLW: case PIC_XORLW: case PIC_SUBLW: case PIC_ADDLW:
+            return true;
+
+        case PIC_MOVWF: case PIC_CLR:    case PIC_SUBWF: case PIC_DECF:  case PIC_IORWF: case PIC_ANDWF:
+        case PIC_XORWF: case PIC_ADDWF:  case PIC_MOVF:  case PIC_COMF:  case PIC_INCF:  case PIC_DECFSZ:
+        case PIC_RRF:   case PIC_RLF:    case PIC_SWAPF: case PIC_INCFSZ:
+        case PIC_BCF:   case PIC_BSF:    case PIC_BTFSC: case PIC_BTFSS:
+            return isLocalReg( inst->f );
+    }
+    return false;
+}
+
+uint64_t PicMrCore::skipLoop( uint64_t maxCycles ) // PC at GOTO closing a wait or delay loop
+{
+    const picInst_t* jump = getInst( m_PC );
+    if( jump->op != PIC_GOTO ) return 0;
+
+    uint32_t target = (jump->k | ((uint16_t)(m_dataMem[m_PCHaddr] & 0b00011000)<<8)) & 0x1FFF;
+
+    uint64_t loopCycles = 2;    // GOTO
+    uint64_t loops = maxCycles; // Wait loops only end by interrupt
+    uint16_t counter = 0;       // Delay loop counter address
+
+    if( target != m_PC )        // Else GOTO $
+    {
+        if( target+1 != m_PC ) return 0;
+
+        const picInst_t* inst = getInst( target );
+        uint16_t addr = directAddr( inst->f );
+        if( !addr || addr == m_PCLaddr ) return 0;
+        uint8_t value = m_dataMem[addr];
+
+        switch( inst->op )
+        {
+            case PIC_BTFSC: case PIC_BTFSS: { // BTFSS f,b ; GOTO $-1
+                if( !isStableRead( addr ) ) return 0;
+                bool set = value & 1<<inst->k;
+                if( set == (inst->op == PIC_BTFSS) ) return 0; // GOTO skipped: loop ends
+            } break;
+            case PIC_DECFSZ: case PIC_INCFSZ: { // DECFSZ f,1 ; GOTO $-1
+                if( !inst->k || !isPlainRam( addr ) ) return 0;
+                if( inst->op == PIC_DECFSZ ) loops = (value ? value : 256)-1; // f stays > 0, last iteration runs normally
+                else                         loops = 255-value;
+                counter = addr;
+            } break;
+            default: return 0;
+        }
+        loopCycles += 1;
+    }
+    uint64_t n = maxCycles/loopCycles;
+    if( n > loops ) n = loops;
+    if( n == 0 ) return 0;
+
+    if( counter )
+    {
+        const picInst_t* inst = getInst( target );
+        if( inst->op == PIC_DECFSZ ) m_dataMem[counter] -= n;
+        else                         m_dataMem[counter] += n;
+    }
+    uint64_t cycles = n*loopCycles;
+    m_mcu->cyclesDone = cycles;
+    return cycles;
+}
+
 void PicMrCore::runStep()
 {
-    uint16_t instr = m_progMem[m_PC] & 0x3FFF;
+    picInst_t* inst = getInst( m_PC );
 
     m_mcu->cyclesDone = 0;
     incDefault();
     m_RET_ADDR = m_PC;
 
-    decode( instr );
+    execute( inst );
 }
 
-void PicMrCore::decode( uint16_t instr )
+void PicMrCore::execute( const picInst_t* inst )
 {
+    const uint8_t  f = inst->f;
+    const uint16_t k = inst->k;
+
+    switch( inst->op )
+    {
+        PIC_MR_CASES
+    }
+}
+
+void PicMrCore::decode( uint16_t instr, picInst_t* inst )
+{
+    setInst( inst, PIC_NOP );
+
     if( (instr & 0x3F80) == 0 )  // Miscellaneous instrs
     {
         switch( instr & 0x000C)
         {
             case 0x0008: {
-                if     ( instr == 0x0008 ) RETURN(); // RETURN 00 0000 0000 1000
-                else if( instr == 0x0009 ) RETFIE(); // RETFIE 00 0000 0000 1001
+                if     ( instr == 0x0008 ) setInst( inst, PIC_RETURN ); // RETURN 00 0000 0000 1000
+                else if( instr == 0x0009 ) setInst( inst, PIC_RETFIE ); // RETFIE 00 0000 0000 1001
             } return;
             case 0x0000: {
-                if     ( instr == 0x0062 ) OPTION(); // OPTION 00 0000 0110 0010
-                else if( instr == 0x0063 ) SLEEP();  // SLEEP  00 0000 0110 0011
+                if     ( instr == 0x0062 ) setInst( inst, PIC_OPTION ); // OPTION 00 0000 0110 0010
+                else if( instr == 0x0063 ) setInst( inst, PIC_SLEEP );  // SLEEP  00 0000 0110 0011
             } return;
             case 0x0004: {
-                if     ( instr == 0x0064 ) CLRWDT(); // CLRWDT 00 0000 0110 0100
+                if     ( instr == 0x0064 ) setInst( inst, PIC_CLRWDT ); // CLRWDT 00 0000 0110 0100
             } return;
         }
     }
@@ -302,25 +416,25 @@ void PicMrCore::decode( uint16_t instr )
 
         if( (instr & 0x3800) == 0 ) {
             switch( instr & 0x0700) {
-                case 0x0000: MOVWF( f );    return; // MOVWF f   00 0000 1fff ffff
-                case 0x0100: CLR( f, d );   return; // CLR   f   00 0001 dfff ffff
-                case 0x0200: SUBWF( f, d ); return; // SUBWF f,d 00 0010 dfff ffff
-                case 0x0300: DECF( f, d );  return; // DECF  f,d 00 0011 dfff ffff
-                case 0x0400: IORWF( f, d ); return; // IORWF f,d 00 0100 dfff ffff
-                case 0x0500: ANDWF( f, d ); return; // ANDWF f,d 00 0101 dfff ffff
-                case 0x0600: XORWF( f, d ); return; // XORWF f,d 00 0110 dfff ffff
-                case 0x0700: ADDWF( f, d ); return; // ADDWF f,d 00 0111 dfff ffff
+                case 0x0000: setInst( inst, PIC_MOVWF, f );    return; // MOVWF f   00 0000 1fff ffff
+                case 0x0100: setInst( inst, PIC_CLR, f, d );   return; // CLR   f   00 0001 dfff ffff
+                case 0x0200: setInst( inst, PIC_SUBWF, f, d ); return; // SUBWF f,d 00 0010 dfff ffff
+                case 0x0300: setInst( inst, PIC_DECF, f, d );  return; // DECF  f,d 00 0011 dfff ffff
+                case 0x0400: setInst( inst, PIC_IORWF, f, d ); return; // IORWF f,d 00 0100 dfff ffff
+                case 0x0500: setInst( inst, PIC_ANDWF, f, d ); return; // ANDWF f,d 00 0101 dfff ffff
+                case 0x0600: setInst( inst, PIC_XORWF, f, d ); return; // XORWF f,d 00 0110 dfff ffff
+                case 0x0700: setInst( inst, PIC_ADDWF, f, d ); return; // ADDWF f,d 00 0111 dfff ffff
            }
         } else {
             switch( instr & 0x0700) {
-                case 0x0000: MOVF( f, d );   return; // MOVF   f,d 00 1000 dfff ffff
-                case 0x0100: COMF( f, d );   return; // COMF   f,d 00 0001 dfff ffff
-                case 0x0200: INCF( f, d );   return; // INCF   f,d 00 0010 dfff ffff
-                case 0x0300: DECFSZ( f, d ); return; // DECFSZ f,d 00 0011 dfff ffff
-                case 0x0400: RRF( f, d );    return; // RRF    f,d 00 0100 dfff ffff
-                case 0x0500: RLF( f, d );    return; // RLF    f,d 00 0101 dfff ffff
-                case 0x0600: SWAPF( f, d );  return; // SWAPF  f,d 00 0110 dfff ffff
-                case 0x0700: INCFSZ( f, d ); return; // INCFSZ f,d 00 0111 dfff ffff
+                case 0x0000: setInst( inst, PIC_MOVF, f, d );   return; // MOVF   f,d 00 1000 dfff ffff
+                case 0x0100: setInst( inst, PIC_COMF, f, d );   return; // COMF   f,d 00 0001 dfff ffff
+                case 0x0200: setInst( inst, PIC_INCF, f, d );   return; // INCF   f,d 00 0010 dfff ffff
+                case 0x0300: setInst( inst, PIC_DECFSZ, f, d ); return; // DECFSZ f,d 00 0011 dfff ffff
+                case 0x0400: setInst( inst, PIC_RRF, f, d );    return; // RRF    f,d 00 0100 dfff ffff
+                case 0x0500: setInst( inst, PIC_RLF, f, d );    return; // RLF    f,d 00 0101 dfff ffff
+                case 0x0600: setInst( inst, PIC_SWAPF, f, d );  return; // SWAPF  f,d 00 0110 dfff ffff
+                case 0x0700: setInst( inst, PIC_INCFSZ, f, d ); return; // INCFSZ f,d 00 0111 dfff ffff
             }
         }
     } else {
@@ -330,36 +444,36 @@ void PicMrCore::decode( uint16_t instr )
             uint8_t b = instr>>7 & 7;
 
             switch( instr & 0x3C00){
-                case 0x1000: BCF( f, b );   return; // BCF   f,b 01 00bb bkkk kkkk
-                case 0x1400: BSF( f, b );   return; // BSF   f,b 01 01bb bkkk kkkk
-                case 0x1800: BTFSC( f, b ); return; // BTFSC f,b 01 10bb bkkk kkkk
-                case 0x1C00: BTFSS( f, b ); return; // BTFSS f,b 01 11bb bkkk kkkk
+                case 0x1000: setInst( inst, PIC_BCF, f, b );   return; // BCF   f,b 01 00bb bkkk kkkk
+                case 0x1400: setInst( inst, PIC_BSF, f, b );   return; // BSF   f,b 01 01bb bkkk kkkk
+                case 0x1800: setInst( inst, PIC_BTFSC, f, b ); return; // BTFSC f,b 01 10bb bkkk kkkk
+                case 0x1C00: setInst( inst, PIC_BTFSS, f, b ); return; // BTFSS f,b 01 11bb bkkk kkkk
             }
         }
         else if( (instr & 0x3000) == 0x2000 ) // Control transfers
         {
             uint16_t k = instr & 0x07FF;
 
-            if( (instr & 0x0800) == 0 ) CALL( k ); // CALL k 10 0kkk kkkk kkkk
-            else                        GOTO( k ); // GOTO k 10 1kkk kkkk kkkk
+            if( (instr & 0x0800) == 0 ) setInst( inst, PIC_CALL, 0, k ); // CALL k 10 0kkk kkkk kkkk
+            else                        setInst( inst, PIC_GOTO, 0, k ); // GOTO k 10 1kkk kkkk kkkk
         }
         else if( (instr & 0x3000) == 0x3000 ) // Operations with W and 8-bit literal: W ← OP(k,W)
         {
             uint8_t k = instr & 0xFF;
 
             switch( instr & 0x3C00){
-                case 0x3000: MOVLW( k ); return; // MOVLW k 11 00xx kkkk kkkk
-                case 0x3400: RETLW( k ); return; // RETLW k 11 01xx kkkk kkkk
+                case 0x3000: setInst( inst, PIC_MOVLW, 0, k ); return; // MOVLW k 11 00xx kkkk kkkk
+                case 0x3400: setInst( inst, PIC_RETLW, 0, k ); return; // RETLW k 11 01xx kkkk kkkk
                 case 0x3800: {
                     switch( instr & 0x3F00) {
-                        case 0x3800: IORLW( k ); return; // IORLW k 11 1000 kkkk kkkk
-                        case 0x3900: ANDLW( k ); return; // ANDLW k 11 1001 kkkk kkkk
-                        case 0x3A00: XORLW( k ); return; // XORLW k 11 1010 kkkk kkkk
+                        case 0x3800: setInst( inst, PIC_IORLW, 0, k ); return; // IORLW k 11 1000 kkkk kkkk
+                        case 0x3900: setInst( inst, PIC_ANDLW, 0, k ); return; // ANDLW k 11 1001 kkkk kkkk
+                        case 0x3A00: setInst( inst, PIC_XORLW, 0, k ); return; // XORLW k 11 1010 kkkk kkkk
                     }
                 } return;
                 case 0x3C00: {
-                    if((instr & 0x0200)==0 ) SUBLW( k ); // SUBLW k 11 110x kkkk kkkk
-                    else                     ADDLW( k ); // ADDLW k 11 111x kkkk kkkk
+                    if((instr & 0x0200)==0 ) setInst( inst, PIC_SUBLW, 0, k ); // SUBLW k 11 110x kkkk kkkk
+                    else                     setInst( inst, PIC_ADDLW, 0, k ); // ADDLW k 11 111x kkkk kkkk
                 }
             }
         }
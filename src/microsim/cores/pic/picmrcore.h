@@ -11,6 +11,65 @@ enum {
     C=0,DC,Z,PD,TO,RP0,RP1,IRP
 };
 
+enum picOp_t{       // Predecoded instruction handlers
+    PIC_UNDECODED=0,
+    PIC_NOP,
+    PIC_RETURN, PIC_RETFIE, PIC_OPTION, PIC_SLEEP, PIC_CLRWDT,
+    PIC_MOVWF, PIC_CLR, PIC_SUBWF, PIC_DECF, PIC_IORWF, PIC_ANDWF, PIC_XORWF, PIC_ADDWF,
+    PIC_MOVF, PIC_COMF, PIC_INCF, PIC_DECFSZ, PIC_RRF, PIC_RLF, PIC_SWAPF, PIC_INCFSZ,
+    PIC_BCF, PIC_BSF, PIC_BTFSC, PIC_BTFSS,
+    PIC_CALL, PIC_GOTO,
+    PIC_MOVLW, PIC_RETLW, PIC_IORLW, PIC_ANDLW, PIC_XORLW, PIC_SUBLW, PIC_ADDLW,
+    PIC_CORE_OP     // First core specific handler
+};
+
+// Dispatch of base handlers, shared by core specific execute() switches
+#define PIC_MR_CASES \
+        case PIC_RETURN: RETURN(); break;       \
+        case PIC_RETFIE: RETFIE(); break;       \
+        case PIC_OPTION: OPTION(); break;       \
+        case PIC_SLEEP:  SLEEP();  break;       \
+        case PIC_CLRWDT: CLRWDT(); break;       \
+                                                \
+        case PIC_MOVWF:  MOVWF( f );     break; \
+        case PIC_CLR:    CLR( f, k );    break; \
+        case PIC_SUBWF:  SUBWF( f, k );  break; \
+        case PIC_DECF:   DECF( f, k );   break; \
+        case PIC_IORWF:  IORWF( f, k );  break; \
+        case PIC_ANDWF:  ANDWF( f, k );  break; \
+        case PIC_XORWF:  XORWF( f, k );  break; \
+        case PIC_ADDWF:  ADDWF( f, k );  break; \
+        case PIC_MOVF:   MOVF( f, k );   break; \
+        case PIC_COMF:   COMF( f, k );   break; \
+        case PIC_INCF:   INCF( f, k );   break; \
+        case PIC_DECFSZ: DECFSZ( f, k ); break; \
+        case PIC_RRF:    RRF( f, k );    break; \
+        case PIC_RLF:    RLF( f, k );    break; \
+        case PIC_SWAPF:  SWAPF( f, k );  break; \
+        case PIC_INCFSZ: INCFSZ( f, k ); break; \
+                                                \
+        case PIC_BCF:    BCF( f, k );    break; \
+        case PIC_BSF:    BSF( f, k );    break; \
+        case PIC_BTFSC:  BTFSC( f, k );  break; \
+        case PIC_BTFSS:  BTFSS( f, k );  break; \
+                                                \
+        case PIC_CALL:   CALL( k );      break; \
+        case PIC_GOTO:   GOTO( k );      break; \
+                                                \
+        case PIC_MOVLW:  MOVLW( k );     break; \
+        case PIC_RETLW:  RETLW( k );     break; \
+        case PIC_IORLW:  IORLW( k );     break; \
+        case PIC_ANDLW:  ANDLW( k );     break; \
+        case PIC_XORLW:  XORLW( k );     break; \
+        case PIC_SUBLW:  SUBLW( k );     break; \
+        case PIC_ADDLW:  ADDLW( k );     break;
+
+struct picInst_t{   // Predecoded instruction
+    uint8_t  op;    // picOp_t or core specific
+    uint8_t  f;     // File register or FSRn
+    uint16_t k;     // Destination, bit or literal
+};
+
 class PicMrCore : public Mcu8bits
 {
     public:
@@ -22,8 +81,47 @@ class PicMrCore : public Mcu8bits
 
         virtual uint RET_ADDR() override { return m_stack[m_sp]; }
 
+        virtual void pgmChanged( uint32_t addr ) override;
+
+        virtual bool nextIsLocal() override;
+
+        virtual uint64_t skipLoop( uint64_t maxCycles ) override;
+
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
-        virtual void decode( uint16_t instr );
+        virtual void decode( uint16_t instr, picInst_t* inst );
+        virtual void execute( const picInst_t* inst );
+
+        virtual uint16_t directAddr( uint8_t f ) // Data address of f, 0 if indirect (INDF)
+        {
+            uint16_t addr = m_mcu->getMapperAddr( f+m_bank );
+            return addr > 1 ? addr : 0;
+        }
+        bool isLocalReg( uint8_t f ) // Access to f has no effects outside the Cpu
+        {
+            uint16_t addr = directAddr( f );
+            return addr && addr != m_PCLaddr && isPlainRam( addr );
+        }
+
+        picInst_t* getInst( uint32_t pc ) // Decoded instruction at pc
+        {
+            picInst_t* inst = &m_decoded[pc];
+            if( inst->op == PIC_UNDECODED ) decode( m_progMem[pc] & m_wordMask, inst );
+            return inst;
+        }
+
+        void setInst( picInst_t* inst, uint8_t op, uint8_t f=0, uint16_t k=0 )
+        {
+            inst->op = op;
+            inst->f  = f;
+            inst->k  = k;
+        }
+
+        std::vector<picInst_t> m_decoded; // Flash decoded when first executed
+        uint16_t m_wordMask;
+
         uint8_t* m_Wreg;
         uint8_t* m_OPTION;
 
@@ -7,6 +7,7 @@
 #include "picspi.h"
 #include "pictwi.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "datautils.h"
 
 PicMssp::PicMssp( eMcu* mcu, QString name, int type )
@@ -78,3 +79,15 @@ void PicMssp::configureA( uint8_t SSPCON )
     }
 }
 
+bool PicMssp::saveState( StateStream* s )
+{
+    s->put( m_mode );
+    s->put( m_enabled );
+    return true;
+}
+
+void PicMssp::loadState( StateStream* s )
+{
+    s->get( m_mode );
+    s->get( m_enabled );
+}
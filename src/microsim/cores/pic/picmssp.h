@@ -25,6 +25,9 @@ class PicMssp : public McuModule, public eElement
 
         virtual void configureA( uint8_t SSPCON ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
         //virtual void setInterrupt( Interrupt* i ) override;
 
     protected:
@@ -7,6 +7,7 @@
 #include "datautils.h"
 #include "mcupin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "simulator.h"
 
 PicPwmUnit* PicOcUnit::createPwmUnit( eMcu* mcu, QString name, int type ) // Static
@@ -84,6 +85,20 @@ void PicOcUnit::ocrWriteH( uint8_t val )
     if( m_enabled ) sheduleEvents( m_timer->ovfMatch(), m_timer->getCount() );
 }
 
+bool PicOcUnit::saveState( StateStream* s )
+{
+    s->put( m_specEvent );
+    s->put( m_resetTimer );
+    return McuOcUnit::saveState( s );
+}
+
+void PicOcUnit::loadState( StateStream* s )
+{
+    s->get( m_specEvent );
+    s->get( m_resetTimer );
+    McuOcUnit::loadState( s );
+}
+
 //------------------------------------------------------
 //-- PIC PWM Unit --------------------------------------
 
@@ -147,6 +162,20 @@ void PicPwmUnit::ocrWriteL( uint8_t val ) // CCPRxL
     sheduleEvents( m_timer->ovfMatch(), m_timer->getCount() );
 }
 
+bool PicPwmUnit::saveState( StateStream* s )
+{
+    s->put( m_cLow );
+    s->put( m_CCPRxL );
+    return McuOcUnit::saveState( s );
+}
+
+void PicPwmUnit::loadState( StateStream* s )
+{
+    s->get( m_cLow );
+    s->get( m_CCPRxL );
+    McuOcUnit::loadState( s );
+}
+
 //------------------------------------------------------
 //-- PIC 16f88x PWM Unit -------------------------------
 
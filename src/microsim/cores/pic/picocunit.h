@@ -27,6 +27,9 @@ static PicPwmUnit* createPwmUnit( eMcu* mcu, QString name, int type );
         virtual void ocrWriteL( uint8_t val ) override;
         virtual void ocrWriteH( uint8_t val ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         bool m_enhanced;
         bool m_specEvent;
@@ -52,6 +55,9 @@ class PicPwmUnit : public McuOcUnit
 
         virtual void ocrWriteL( uint8_t val ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         bool m_enhanced;
 
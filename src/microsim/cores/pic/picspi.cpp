@@ -7,6 +7,7 @@
 #include "datautils.h"
 #include "iopin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcuinterrupts.h"
 #include "simulator.h"
 
@@ -102,3 +103,16 @@ void PicSpi::sleep( int mode )
     else             resumeEvents();
 }
 
+bool PicSpi::saveState( StateStream* s )
+{
+    s->put( m_clkPol );
+    s->put( m_clkPha );
+    return McuSpi::saveState( s );
+}
+
+void PicSpi::loadState( StateStream* s )
+{
+    s->get( m_clkPol );
+    s->get( m_clkPha );
+    McuSpi::loadState( s );
+}
@@ -27,6 +27,9 @@ class PicSpi : public McuSpi
         virtual void endTransaction() override;
         virtual void sleep( int mode ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
 
         bool m_clkPol;
@@ -5,6 +5,7 @@
 
 #include "pictimer.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "simulator.h"
 #include "datautils.h"
 
@@ -155,6 +156,18 @@ void PicTimer2::configureB( uint8_t NewPR2 )
     m_ovfMatch  = NewPR2;
 }
 
+bool PicTimer2::saveState( StateStream* s )
+{
+    s->put( m_ps );
+    return PicTimer8bit::saveState( s );
+}
+
+void PicTimer2::loadState( StateStream* s )
+{
+    s->get( m_ps );
+    PicTimer8bit::loadState( s );
+}
+
 //--------------------------------------------------
 // TIMER 16 Bit-------------------------------------
 
@@ -223,6 +236,20 @@ void PicTimer16bit::sleep( int mode )
     McuTimer::sleep( mode );
 }
 
+bool PicTimer16bit::saveState( StateStream* s )
+{
+    s->put( m_t1Osc );
+    s->put( m_t1sync );
+    return PicTimer::saveState( s );
+}
+
+void PicTimer16bit::loadState( StateStream* s )
+{
+    s->get( m_t1Osc );
+    s->get( m_t1sync );
+    PicTimer::loadState( s );
+}
+
 //--------------------------------------------------
 // TIMER 1 -----------------------------------------
 
@@ -64,6 +64,9 @@ class PicTimer2 : public PicTimer8bit
         virtual void configureA( uint8_t NewT2CON ) override;
         virtual void configureB( uint8_t NewPR2 ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         uint8_t m_ps;
         //uint8_t* m_PR2;
@@ -86,6 +89,9 @@ class PicTimer16bit : public PicTimer
 
         virtual void sleep( int mode ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         virtual void configureClock(){;}
         virtual void sheduleEvents() override;
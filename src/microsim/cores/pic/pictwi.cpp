@@ -6,6 +6,7 @@
 #include "pictwi.h"
 #include "mcupin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcuinterrupts.h"
 #include "datautils.h"
 #include "simulator.h"
@@ -236,3 +237,15 @@ void PicTwi::sleep( int mode )
     if( m_sleeping ) pauseEvents();
     else             resumeEvents();
 }
+
+bool PicTwi::saveState( StateStream* s )
+{
+    s->put( m_bitRate );
+    return McuTwi::saveState( s );
+}
+
+void PicTwi::loadState( StateStream* s )
+{
+    s->get( m_bitRate );
+    McuTwi::loadState( s );
+}
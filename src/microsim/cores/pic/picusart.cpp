@@ -7,6 +7,7 @@
 #include "usarttx.h"
 #include "usartrx.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "iopin.h"
 #include "serialmon.h"
 #include "datautils.h"
@@ -164,3 +165,17 @@ void PicUsart::sleep( int mode )
     if( m_sleeping ) m_sender->pauseEvents();
     else             m_sender->resumeEvents();
 }
+
+bool PicUsart::saveState( StateStream* s )
+{
+    s->put( m_enabled );
+    s->put( m_speedx2 );
+    return McuUsart::saveState( s );
+}
+
+void PicUsart::loadState( StateStream* s )
+{
+    s->get( m_enabled );
+    s->get( m_speedx2 );
+    McuUsart::loadState( s );
+}
@@ -33,6 +33,9 @@ class PicUsart : public McuUsart
 
         virtual void sleep( int mode ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     private:
         bool m_enabled;
 
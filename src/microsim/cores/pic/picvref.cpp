@@ -6,6 +6,7 @@
 #include "picvref.h"
 #include "datautils.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcupin.h"
 
 PicVref::PicVref( eMcu* mcu, QString name )
@@ -72,6 +73,22 @@ void PicVref::configureA( uint8_t newVRCON )
     { for( McuModule* mod : m_callBacks ) mod->callBackDoub( m_vref ); }
 }
 
+bool PicVref::saveState( StateStream* s )
+{
+    s->put( m_vrr );
+    s->put( m_vroe );
+    return McuVref::saveState( s );
+}
+
+void PicVref::loadState( StateStream* s )
+{
+    s->get( m_vrr );
+    s->get( m_vroe );
+    McuVref::loadState( s );
+
+    if( m_VREN.reg ) configureA( *m_VREN.reg ); // Restore Pin ladder and callbacks
+}
+
 /*void PicVref::setMode( uint8_t mode )
 {
     m_mode = mode;
@@ -131,3 +148,19 @@ double PicVrefE::getDacVref()
     if( m_enabled ) return m_dacVref;
     else            return 0;
 }
+
+bool PicVrefE::saveState( StateStream* s )
+{
+    s->put( m_adcVref );
+    s->put( m_dacVref );
+    return McuVref::saveState( s );
+}
+
+void PicVrefE::loadState( StateStream* s )
+{
+    s->get( m_adcVref );
+    s->get( m_dacVref );
+    McuVref::loadState( s );
+
+    if( m_FVREN.reg ) configureA( *m_FVREN.reg ); // Update modules using FVR
+}
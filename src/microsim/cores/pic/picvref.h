@@ -18,6 +18,9 @@ class PicVref : public McuVref
 
         virtual void configureA( uint8_t newVRCON ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         //virtual void setMode( uint8_t mode ) override;
 
@@ -40,6 +43,9 @@ class PicVrefE : public McuVref
 
         virtual void configureA( uint8_t newFVRCON ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
         double getAdcVref();
         double getDacVref();
 
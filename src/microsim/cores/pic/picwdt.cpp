@@ -5,6 +5,7 @@
 
 #include "picwdt.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "cpu8bits.h"
 #include "simulator.h"
 #include "datautils.h"
@@ -72,6 +73,18 @@ void PicWdt::sleep( int mode )
     reset();
 }
 
+bool PicWdt::saveState( StateStream* s )
+{
+    s->put( m_wdtSoft );
+    return McuWdt::saveState( s );
+}
+
+void PicWdt::loadState( StateStream* s )
+{
+    s->get( m_wdtSoft );
+    McuWdt::loadState( s );
+}
+
 //------------------------------------------------------
 //-- PIC Wdt Type 00 -----------------------------------
 
@@ -22,6 +22,9 @@ class PicWdt : public McuWdt
 
         virtual void sleep( int mode ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         bool m_wdtSoft;
 };
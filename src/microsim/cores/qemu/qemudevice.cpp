@@ -9,6 +9,7 @@
 #include <QFileInfo>
 #include <QMessageBox>
 #include <QDir>
+#include <QThread>
 
 #include <stdlib.h>
 #include <fcntl.h>
@@ -38,15 +39,20 @@
 
 #define tr(str) simulideTr("QemuDevice",str)
 
-QemuDevice* QemuDevice::m_pSelf = nullptr;
+class QemuWorker : public QThread  // Waits for Qemu while Simulator waits other devices
+{
+    public:
+        QemuWorker( QemuDevice* device ) { m_device = device; }
+
+    protected:
+        void run() override { m_device->workerLoop(); }
+
+    private:
+        QemuDevice* m_device;
+};
 
 Component* QemuDevice::construct( QString type, QString id )
 {
-    //if( QemuDevice::self() )
-    //{
-    //    qDebug() << "\nQemuDevice::construct ERROR: only one QemuDevice allowed\n";
-    //    return nullptr;
-    //}
     QString device = Chip::getDevice( id );
 
     QemuDevice* qdev = nullptr;
@@ -69,8 +75,10 @@ LibraryItem* QemuDevice::libraryItem()
 QemuDevice::QemuDevice( QString type, QString id )
           : Chip( type, id )
 {
-    m_pSelf = this;
     m_rstPin = nullptr;
+    m_worker = nullptr;
+    m_workState = WORK_IDLE;
+    m_workOk = false;
 
     //m_fullSynch = false; //true;
 
@@ -82,15 +90,16 @@ QemuDevice::QemuDevice( QString type, QString id )
 
     // create the shared memory object
 #ifdef __linux__
-    const char* charMemKey = m_shMemKey.toLocal8Bit().data();
-    m_shMemId = shm_open( charMemKey, O_CREAT | O_RDWR, 0666);
+    QByteArray memKey = m_shMemKey.toLocal8Bit(); // One arena per device
+    m_shMemId = shm_open( memKey.constData(), O_CREAT | O_RDWR, 0666);
     if( m_shMemId != -1 )
     {
         int t = ftruncate( m_shMemId, shMemSize );
         arena = mmap( 0, shMemSize, PROT_WRITE, MAP_SHARED, m_shMemId, 0 );
     }
 #elif defined(_WIN32)
-    const wchar_t* charMemKey = m_shMemKey.toStdWString().c_str();
+    std::wstring memKey = m_shMemKey.toStdWString();
+    const wchar_t* charMemKey = memKey.c_str();
     // Create a file mapping object
     HANDLE hMapFile = CreateFileMapping(
         INVALID_HANDLE_VALUE, // Use paging file
@@ -139,14 +148,18 @@ QemuDevice::~QemuDevice()
         CloseHandle( (HANDLE)m_wHandle );
     }
 #endif
-    m_pSelf = nullptr;
 }
 
 void QemuDevice::initialize()
 {
     if( m_shMemId == -1 ) return;
 
+    stopWorker();
     m_arena->running = 0;
+    m_sync.notify( &m_arena->qemuSeq, &m_arena->qemuWaiting );
+
+    if( m_sync.stats().waits ) qDebug() << "QemuDevice: Sync" << m_sync.statsString();
+    m_sync.reset();
 
     m_qemuProcess.waitForFinished( 500 );
     if( m_qemuProcess.state() != QProcess::NotRunning )
@@ -178,6 +191,12 @@ void QemuDevice::stamp()
     m_arena->loop_timeout_ns = 0;
     m_arena->running = 0;
     m_arena->ps_per_inst = 0;
+    m_arena->simuSeq = 0;
+    m_arena->simuWaiting = 0;
+    m_arena->qemuSeq = 0;
+    m_arena->qemuWaiting = 0;
+
+    m_sync.reset();
 
     //for( IoPin* pin : m_ioPin ) // Qemu calls us to read input
     //{
@@ -199,36 +218,35 @@ void QemuDevice::stamp()
         }
         m_qemuProcess.start( executable, m_arguments );
 
-        uint64_t timeout = 0;
-        while( !m_arena->running )   // Wait for Qemu running
+        // Wait for Qemu running, don't wait forever
+        if( !m_sync.wait( &m_arena->running, &m_arena->simuSeq, &m_arena->simuWaiting
+                        , [](){ return false; }, 3000 ) )
         {
-            //sleep( 10 );
-            if( timeout++ > 2e9 ) // Don't wait forever
-            {
-                qDebug() << "Error: QemuDevice::stamp timeout";
+            qDebug() << "Error: QemuDevice::stamp timeout";
 
-                m_qemuProcess.waitForFinished( 500 );
+            m_qemuProcess.waitForFinished( 500 );
 
-                if( m_qemuProcess.exitStatus() != QProcess::NormalExit )
+            if( m_qemuProcess.exitStatus() != QProcess::NormalExit )
+            {
+                QString output = m_qemuProcess.readAllStandardError();
+                if( !output.isEmpty() )
                 {
-                    QString output = m_qemuProcess.readAllStandardError();
-                    if( !output.isEmpty() )
-                    {
-                        QStringList lines = output.split("\n");
-                        for( QString line : lines ) qDebug() << line.remove("\"");
-                    }
-
-                    qDebug() << m_qemuProcess.exitStatus();
-                    qDebug() << m_qemuProcess.error();
-                    qDebug() << m_qemuProcess.exitCode();
-                    qDebug() << m_qemuProcess.state();
+                    QStringList lines = output.split("\n");
+                    for( QString line : lines ) qDebug() << line.remove("\"");
                 }
-//                    m_qemuProcess.kill();
-                return;
+
+                qDebug() << m_qemuProcess.exitStatus();
+                qDebug() << m_qemuProcess.error();
+                qDebug() << m_qemuProcess.exitCode();
+                qDebug() << m_qemuProcess.state();
             }
+//                    m_qemuProcess.kill();
+            return;
         }
         qDebug() << "QemuDevice::stamp started";
 
+        startWorker();
+
         Simulator::self()->addEvent( 1, this );
     }
 }
@@ -311,7 +329,7 @@ void QemuDevice::runToTime( uint64_t time )
     ///     //qDebug() << "QemuDevice::runToTime event"<< m_arena->simuTime;
 }
 
-void QemuDevice::runEvent()
+void QemuDevice::runEvent() // Release Qemu, Simulator waits all released devices together
 {
     uint64_t now = Simulator::self()->circTime();
     //qDebug() << "   QemuDevice::runEvent"<< now;
@@ -322,17 +340,27 @@ void QemuDevice::runEvent()
         m_eventModule->m_eventAction = 0;
         m_eventModule = nullptr;
     }
+    m_arena->simuTime = 0;
+    m_sync.notify( &m_arena->qemuSeq, &m_arena->qemuWaiting );
+    Simulator::self()->addQemuPending( this );
+}
 
+bool QemuDevice::waitQemu() // Can run in worker thread: only touches arena
+{
+    auto stop = [this](){ return Simulator::self()->simState() < SIM_RUNNING || !m_arena->running; };
 
-    m_arena->simuTime = 0;
-    while( !m_arena->simuTime )   // Wait for next event from Qemu
+    return m_sync.wait( &m_arena->simuTime, &m_arena->simuSeq, &m_arena->simuWaiting, stop ); // Wait for next event from Qemu
+}
+
+void QemuDevice::qemuReady( bool ok )
+{
+    if( !ok )                    // Simulation stopping or Qemu reset
     {
-        if( Simulator::self()->simState() < SIM_RUNNING ) //
-        {
-            Simulator::self()->addEvent( 1, this );
-            return;
-        }
+        if( m_arena->running ) Simulator::self()->addEvent( 1, this );
+        return;
     }
+    uint64_t now = Simulator::self()->circTime();
+
     uint64_t nextTime = m_arena->simuTime;
 
     if( nextTime <= now ){
@@ -355,6 +383,66 @@ void QemuDevice::runEvent()
     //m_lastEvent = m_nextEvent;
 }
 
+void QemuDevice::startWait()
+{
+    m_workMutex.lock();
+    m_workState = WORK_WAIT;
+    m_workCond.wakeAll();
+    m_workMutex.unlock();
+}
+
+bool QemuDevice::finishWait()
+{
+    m_workMutex.lock();
+    while( m_workState != WORK_DONE ) m_workCond.wait( &m_workMutex );
+    m_workState = WORK_IDLE;
+    bool ok = m_workOk;
+    m_workMutex.unlock();
+    return ok;
+}
+
+void QemuDevice::workerLoop()
+{
+    while( true )
+    {
+        m_workMutex.lock();
+        while( m_workState != WORK_WAIT && m_workState != WORK_EXIT ) m_workCond.wait( &m_workMutex );
+        bool exit = m_workState == WORK_EXIT;
+        m_workMutex.unlock();
+        if( exit ) return;
+
+        bool ok = waitQemu();
+
+        m_workMutex.lock();
+        m_workOk = ok;
+        m_workState = WORK_DONE;
+        m_workCond.wakeAll();
+        m_workMutex.unlock();
+    }
+}
+
+void QemuDevice::startWorker()
+{
+    if( m_worker ) return;
+    m_workState = WORK_IDLE;
+    m_worker = new QemuWorker( this );
+    m_worker->start();
+}
+
+void QemuDevice::stopWorker()
+{
+    if( !m_worker ) return;
+
+    m_workMutex.lock();
+    m_workState = WORK_EXIT;
+    m_workCond.wakeAll();
+    m_workMutex.unlock();
+
+    m_worker->wait();
+    delete m_worker;
+    m_worker = nullptr;
+}
+
 void QemuDevice::doAction()
 {
     uint32_t address = m_arena->regAddr;
@@ -6,8 +6,11 @@
 #pragma once
 
 #include <QProcess>
+#include <QMutex>
+#include <QWaitCondition>
 
 #include "chip.h"
+#include "qemusync.h"
 
 typedef struct qemuArena{
     uint64_t simuTime;    // in ps
@@ -21,6 +24,10 @@ typedef struct qemuArena{
     uint64_t running;
     int64_t  loop_timeout_ns;
     double   ps_per_inst;
+    uint32_t simuSeq;     // Futex word: Qemu increments it after writing simuTime or running, wakes it if simuWaiting
+    uint32_t simuWaiting; // We are blocked waiting simuSeq
+    uint32_t qemuSeq;     // Futex word: incremented by us after releasing Qemu
+    uint32_t qemuWaiting; // Qemu is blocked waiting qemuSeq
 
 } qemuArena_t;
 
@@ -44,6 +51,7 @@ class QemuUsart;
 class QemuTimer;
 class QemuTwi;
 class QemuSpi;
+class QemuWorker;
 class LibraryItem;
 
 class QemuDevice : public Chip
@@ -56,7 +64,14 @@ class QemuDevice : public Chip
         void stamp() override;
         //void updateStep() override;
         void voltChanged() override;
-        void runEvent() override;
+        void runEvent() override;    // Releases Qemu, answer processed in qemuReady()
+
+        bool waitQemu();             // Wait for Qemu answer, only touches arena
+        void qemuReady( bool ok );   // Process answer and schedule next event
+
+        void startWait();            // waitQemu() in worker thread
+        bool finishWait();
+        void workerLoop();
 
         QString firmware() { return m_firmware; }
         void setFirmware( QString file );
@@ -69,6 +84,8 @@ class QemuDevice : public Chip
         std::vector<uint32_t>* getIoMem() { return &m_ioMem; }
         volatile qemuArena_t* getArena() { return m_arena; }
 
+        QemuSync* sync() { return &m_sync; }
+
         void runToTime( uint64_t time );
         //void setNexTEvent( uint64_t e ) { m_nextEvent = e; }
 
@@ -80,12 +97,16 @@ class QemuDevice : public Chip
         //void cancelEvents( QemuModule* el );
         void addModule( QemuModule* m ) { m_modules.append( m ); }
 
- static QemuDevice* self() { return m_pSelf; }
  static Component* construct( QString type, QString id );
  static LibraryItem* libraryItem();
 
     protected:
- static QemuDevice* m_pSelf;
+        enum workState_t{
+            WORK_IDLE=0,
+            WORK_WAIT,
+            WORK_DONE,
+            WORK_EXIT
+        };
 
         virtual bool createArgs(){ return false;}
 
@@ -105,6 +126,17 @@ class QemuDevice : public Chip
 
         volatile qemuArena_t* m_arena;
 
+        QemuSync m_sync;
+
+        void startWorker();
+        void stopWorker();
+
+        QemuWorker*    m_worker;
+        QMutex         m_workMutex;
+        QWaitCondition m_workCond;
+        workState_t    m_workState;
+        bool           m_workOk;
+
         QemuModule* m_dummyModule;
         QemuModule* m_eventModule;
         uint64_t m_nextEvent;
@@ -0,0 +1,134 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <QElapsedTimer>
+#include <cstring>
+#include <thread>
+#include <chrono>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <time.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#define cpuRelax() _mm_pause()
+#else
+#define cpuRelax()
+#endif
+
+#include "qemusync.h"
+
+QemuSync::QemuSync()
+{
+    m_spinMin = 64;
+    m_spinMax = 1<<16;
+    reset();
+}
+
+void QemuSync::reset()
+{
+    m_spinLimit = 1<<12;
+    memset( &m_stats, 0, sizeof(syncStats_t) );
+}
+
+bool QemuSync::wait( volatile uint64_t* value, volatile uint32_t* seq, volatile uint32_t* waiting
+                   , std::function<bool()> stop, int timeout_ms )
+{
+    m_stats.waits++;
+    if( *value ) { m_stats.spinHits++; __sync_synchronize(); return true; }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for( uint32_t spins=1; spins<=m_spinLimit; ++spins ) // Spin
+    {
+        cpuRelax();
+        if( *value )
+        {
+            __sync_synchronize();
+            m_stats.spinHits++;
+            if( m_spinLimit < m_spinMax ) m_spinLimit += m_spinLimit>>3;
+            endWait( timer.nsecsElapsed() );
+            return true;
+        }
+        if( (spins & 63) == 0 && stop() ) { endWait( timer.nsecsElapsed() ); return false; }
+    }
+    m_spinLimit >>= 1;                                   // Spinning was not enough
+    if( m_spinLimit < m_spinMin ) m_spinLimit = m_spinMin;
+
+    uint64_t blockNs = QSYNC_BLOCK_MIN_NS;
+    while( !*value )
+    {
+        if( stop() || (timeout_ms && timer.elapsed() > timeout_ms) )
+        {
+            endWait( timer.nsecsElapsed() );
+            return false;
+        }
+        if( timer.nsecsElapsed() < QSYNC_YIELD_NS )      // Yield: answer may come soon
+        {
+            m_stats.yields++;
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t oldSeq = *seq;                          // Block until Qemu increments seq or timeout
+        *waiting = 1;
+        __sync_synchronize();
+        if( !*value )
+        {
+            m_stats.blocks++;
+            if( block( seq, oldSeq, blockNs ) ) m_stats.wakeups++;
+            else if( blockNs < QSYNC_BLOCK_MAX_NS ) blockNs *= 2;
+        }
+        *waiting = 0;
+    }
+    __sync_synchronize();
+    endWait( timer.nsecsElapsed() );
+    return true;
+}
+
+bool QemuSync::block( volatile uint32_t* seq, uint32_t oldSeq, uint64_t ns )
+{
+#ifdef __linux__
+    struct timespec ts;
+    ts.tv_sec  = ns/1000000000;
+    ts.tv_nsec = ns%1000000000;
+    long r = syscall( SYS_futex, (uint32_t*)seq, FUTEX_WAIT, oldSeq, &ts, nullptr, 0 );
+    return r == 0 && *seq != oldSeq;
+#else
+    std::this_thread::sleep_for( std::chrono::nanoseconds( ns ) );
+    return *seq != oldSeq;
+#endif
+}
+
+void QemuSync::notify( volatile uint32_t* seq, volatile uint32_t* waiting )
+{
+    __sync_fetch_and_add( seq, 1 );
+    if( !*waiting ) return;
+
+    m_stats.notifies++;
+#ifdef __linux__
+    syscall( SYS_futex, (uint32_t*)seq, FUTEX_WAKE, 1, nullptr, nullptr, 0 );
+#endif
+}
+
+void QemuSync::endWait( uint64_t ns )
+{
+    m_stats.waitNs += ns;
+    if( ns > m_stats.maxWaitNs ) m_stats.maxWaitNs = ns;
+}
+
+QString QemuSync::statsString()
+{
+    double avgUs = m_stats.waits ? m_stats.waitNs/1000.0/m_stats.waits : 0;
+
+    return QString("waits %1 spinHits %2 yields %3 blocks %4 wakeups %5 notifies %6 avgWait %7 us maxWait %8 us spinLimit %9")
+            .arg( m_stats.waits ).arg( m_stats.spinHits ).arg( m_stats.yields ).arg( m_stats.blocks )
+            .arg( m_stats.wakeups ).arg( m_stats.notifies )
+            .arg( avgUs, 0, 'f', 2 ).arg( m_stats.maxWaitNs/1000.0, 0, 'f', 2 ).arg( m_spinLimit );
+}
@@ -0,0 +1,65 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#pragma once
+
+#include <QString>
+#include <functional>
+#include <cstdint>
+
+// Waits for words of the arena shared with Qemu process.
+// Spins first, which is fastest when Qemu answers soon, then yields the CPU
+// for a short time, then blocks in kernel on the seq futex word with
+// *waiting set, so an idle Qemu doesn't cost a full core.
+// A peer that increments seq and wakes it when *waiting (see notify())
+// ends the block at once. Blocks are timed with growing timeout, so a peer
+// without wake still works, with up to QSYNC_BLOCK_MAX_NS latency.
+// Spin limit adapts to recent wait times.
+
+#define QSYNC_YIELD_NS     200000 // Yield the CPU for up to 200 us before blocking
+#define QSYNC_BLOCK_MIN_NS  50000 // First block timeout
+#define QSYNC_BLOCK_MAX_NS 2000000
+
+struct syncStats_t{
+    uint64_t waits;     // Total waits
+    uint64_t spinHits;  // Waits resolved while spinning
+    uint64_t yields;    // Times CPU yielded after spinning
+    uint64_t blocks;    // Times blocked in kernel
+    uint64_t wakeups;   // Blocks ended by a wake before timeout
+    uint64_t notifies;  // Wakes sent to Qemu
+    uint64_t waitNs;    // Total time waiting
+    uint64_t maxWaitNs; // Longest wait
+};
+
+class QemuSync
+{
+    public:
+        QemuSync();
+
+        void reset();
+
+        // Wait until *value != 0, blocking on seq futex word with *waiting set
+        // Returns false if stop() is true or timeout_ms expired
+        bool wait( volatile uint64_t* value, volatile uint32_t* seq, volatile uint32_t* waiting
+                 , std::function<bool()> stop, int timeout_ms=0 );
+
+        // Increment *seq and wake Qemu if it is blocked (*waiting)
+        void notify( volatile uint32_t* seq, volatile uint32_t* waiting );
+
+        const syncStats_t& stats() { return m_stats; }
+        QString statsString();
+
+        uint32_t spinLimit() { return m_spinLimit; }
+
+    private:
+        void endWait( uint64_t ns );
+        bool block( volatile uint32_t* seq, uint32_t oldSeq, uint64_t ns ); // true if woken
+
+        uint32_t m_spinLimit;
+        uint32_t m_spinMin;
+        uint32_t m_spinMax;
+
+        syncStats_t m_stats;
+};
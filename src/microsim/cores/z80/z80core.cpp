@@ -85,6 +85,12 @@ Z80Core::Z80Core( eMcu* mcu )
     m_cmos = false;                      // version of processor - behaviour of instruction OUT (C),0 / OUT (C),FF
     m_ioWait = true;                     // insert one wait state during I/O operations
     m_intVector = false;                 // interrupt vector for mode 2 is read from data bus
+    m_intMem = false;                    // memory is external, accessed by bus
+
+    m_fast = false;
+    m_busInst = false;
+    m_ioPending = false;
+    m_fastEdges = 0;
 
     m_delay = 10e3; // 10 ns
 
@@ -125,6 +131,9 @@ Z80Core::Z80Core( eMcu* mcu )
 
         new BoolProp<Z80Core>("Int_Vector", QObject::tr("Interrupt Vector 0xFF"), ""
                              , this, &Z80Core::intVector, &Z80Core::setIntVector ),
+
+        new BoolProp<Z80Core>("Int_Memory", QObject::tr("Internal 64K RAM (Firmware)"), ""
+                             , this, &Z80Core::intMemory, &Z80Core::setIntMemory ),
     },0} );
 }
 
@@ -484,6 +493,14 @@ void Z80Core::stamp()
     specialReset = false;               /// reset flag specialReset
     rstCount = 0;                       /// reset TState counter for reset
     m_nextClock = true; /// ???
+
+    // Whole instructions only if nothing can interrupt them at TState level
+    // ZX48k never runs here: ULA drives INT and reads video Ram from the external bus
+    m_fast = m_intMem && !m_waitPin->isConnected() && !m_intPin->isConnected() && !m_nmiPin->isConnected()
+          && !m_busreqPin->isConnected() && !m_resetPin->isConnected();
+    m_busInst = false;
+    m_ioPending = false;
+    m_fastEdges = 0;
 }
 
 void Z80Core::runEvent()
@@ -549,20 +566,118 @@ void Z80Core::reset()
     sDI = 0x00;
     sDO = 0x00;
     sAO = 0x0000;
+
+    m_busInst = false;
+    m_ioPending = false;
+    m_fastEdges = 0;
+}
+
+void Z80Core::setIntMemory( bool m )
+{
+    m_intMem = m && m_mcu->flashSize() >= 0x10000; // Z80 Mcu creates 64K program memory
 }
 
 void Z80Core::extClock( bool clkState ) // External Clock
 {
-    if( clkState == m_nextClock ) runStep();
+    if( m_fast && !m_busInst ) // One instruction every cyclesDone clock edges
+    {
+        if( ++m_fastEdges < m_mcu->cyclesDone ) return;
+        m_fastEdges = 0;
+        if( m_ioPending ) startIoCycle(); // Cycles before I/O cycle done
+        else              runStep();
+    }
+    else if( clkState == m_nextClock ) runStep();
 }
 
 void Z80Core::runStep()
 {
+    if( m_fast )
+    {
+        // I/O instruction finished in TState machine: new opcode fetched, not executed yet
+        if( m_busInst && m_nextClock && sm_lastTState && sm_MCycle == 1 && mc_prefix == noPrefix )
+        {
+            m_busInst = false;
+            idleBus();
+        }
+        if( !m_busInst ) { runFast(); return; }
+        m_mcu->cyclesDone = 0;                     // One clock edge per step
+    }
     if( m_nextClock ) clkRisingEdge();
     else              clkFallingEdge();
     m_nextClock = !m_nextClock;
 }
 
+// Run all machine cycles of an instruction at once, memory accessed directly.
+// Same microcode as TState machine: runMCode() at the end of each machine cycle.
+// Ends when the opcode of next instruction is fetched.
+// cyclesDone = clock edges used by the instruction.
+void Z80Core::runFast()
+{
+    uint32_t tStates = 0;
+    do{
+        m_lastBusOp = mc_busOp;
+        runMCode();                     // Execute machine cycle and set up next one
+        if( mc_StateMachine == sHalt ) m_haltPin->setOutStatFast( false );
+        nextMCycle();
+
+        if( mc_busOp == oIORead || mc_busOp == oIOWrite ) // Go on in TState machine from TState 1
+        {
+            if( tStates ){                // Wait clock edges of previous cycles first
+                m_ioPending = true;
+                m_mcu->cyclesDone = 2*tStates;
+            }
+            else startIoCycle();
+            return;
+        }
+        switch( mc_busOp )
+        {
+            case oM1:                                    // Opcode fetch and memory refresh
+                opCodeFetch();
+                regR = ( (regR + 1) & 0x7f ) + ( regR & 0x80 );
+                break;
+            case oMemRead:
+                sDI = readMemory( sAO );
+                if( sm_MCycle == 7 && mc_prefix == prefixCB ) fetchCBIndexed();
+                break;
+            case oMemWrite: writeMemory( sAO, sDO ); break;
+            default: break;
+        }
+        tStates += mc_TStates;
+    }while( sm_MCycle != 1 || mc_prefix != noPrefix );
+
+    sm_TState = mc_TStates;
+    sm_lastTState = true;
+    m_mcu->cyclesDone = 2*tStates;
+}
+
+void Z80Core::startIoCycle() // Called at rising edge of TState 1 of I/O cycle
+{
+    m_ioPending = false;
+    m_busInst = true;
+    sm_lastTState = false;
+    m_nextClock = false;                          // Rising edge of TState 1 done
+    m_mcu->cyclesDone = 0;                        // One clock edge per step
+    Simulator::self()->addEvent( m_delay, this ); // risingEdgeDelayed()
+}
+
+bool Z80Core::nextIsLocal() // Opcode already fetched: instruction without I/O cycles
+{
+    if( !m_fast || m_busInst || m_ioPending ) return false;
+
+    uint16_t pc = m_PC;
+    uint8_t  op = m_iReg;
+    for( int i=0; i<4 && (op == 0xDD || op == 0xFD); ++i ) op = readMemory( pc++ );
+
+    if( op == 0xDD || op == 0xFD ) return false;
+    if( op == 0xD3 || op == 0xDB ) return false;  // OUT (N),A  IN A,(N)
+    if( op != 0xED ) return true;
+
+    op = readMemory( pc );
+    if( (op & 0xC6) == 0x40 ) return false;       // IN r,(C)  OUT (C),r
+    if( (op & 0xE6) == 0xA2 ) return false;       // INI OUTI IND OUTD INIR OTIR INDR OTDR
+    return true;
+}
+
 void Z80Core::clkRisingEdge() // Execution of instruction and sampling bus signal at clock rising edge
 {
     //  Reset is accepted after three TStates
@@ -598,13 +713,7 @@ void Z80Core::clkRisingEdge() // Execution of instruction and sampling bus signa
         // This is simple version of function opCodeFetch()
         // Op Code is read from sDI register instead of data bus, because the machine cycle 7 is memory read cycle and not op code fetch cycle
         // and the data are valid at different clock edge.
-        if( sm_TState == 4 && sm_MCycle == 7 && mc_prefix == prefixCB )
-        {
-            m_iReg = sDI;                                   // reading opcode from data bus
-            m_PC++;                                        // increase program counter PC
-            m_iSet = prefixCB;                              // switch instruction set to prefix CB
-            mc_MCycles = sTableMCycles[prefixCB][m_iReg];   // set number of machine cycles for instruction
-        }
+        if( sm_TState == 4 && sm_MCycle == 7 && mc_prefix == prefixCB ) fetchCBIndexed();
     }
     sLastNMI = sNMI;
     sNMI    = !m_nmiPin->getInpState(); // Sampling of bus signals NMI, INT and BUSREQ
@@ -632,62 +741,12 @@ void Z80Core::clkFallingEdge() // Sampling bus signal at clock falling edge
 }
 
 // Increasing TState, if it is last TState then TState is reset and MCycle is increased
-// It also contains handling of bus request, halt, interrupt and maskable interrupt
 void Z80Core::nextTState()
 {
     if( sm_TState != 2 || sWait == false ) // Hold in TState 2 when Wait signal is actived
     {
-        if( sm_lastTState ) // If the TState is the last state then it is necessary to increase machine cycle
-        {
-            if( mc_StateMachine == sHalt) // Set Machine cycle to halt machine cycle
-            {
-                sm_M1CycleType = tHalt;                             // machine cycle halt
-                mc_StateMachine = sNone;                            // reset flag
-            }
-            if( sBusReq ) sBusAck = true; // The bus is release when it is required by signal BusReq
-            else {
-                sm_TState = 1;                                      // reset TState to first state
-
-                if( mc_StateMachine == sXYOffsetFetch ) // set machine cycle to IX/IY Address offset fetch cycle (Machine cycle number 6)
-                {
-                    sm_PreXYMCycle = sm_MCycle;                     // store actual machine cycle to be able to return (cycles are inserted)
-                    sm_MCycle = 6;                                  // address offset fetch cycle is cycle number 6
-                    mc_StateMachine = sNone;                        // reset flag
-                }
-                else if( sm_MCycle == 7 || mc_StateMachine == sXYFetchFinish )   // last IX/IY fetch cycle is 7, but it can be finish earlier by flag
-                {
-                    sm_MCycle = sm_PreXYMCycle + 1;             // restore machine cycle to cycle before IX/IY Address offset fetch cycle plus one
-                    mc_StateMachine = sNone;                    // reset flag
-                }
-                else if( sm_MCycle == mc_MCycles )              // Last Machine cycle of instruction
-                {
-                    sm_MCycle = 1;                              // set machine cycle number 1
-                    mc_busOp = oM1;                             // bus operaton Op Code Fetch
-                    if( sm_M1CycleType != tHalt ) sm_M1CycleType = tOpCodeFetch; // machine cycle Op Code Fetch only when the previous Machine cycle is not halt machine cycle
-
-                    if( specialReset ) {             // if the special reset is required then the next machine cycle is special reset cycle
-                        sm_M1CycleType = tSpecialReset;
-                        specialReset = false;               // reset special reset flag
-                    }
-                    if( NMIFF && mc_prefix == noPrefix ) // Non maskable interrupt only when instruction is completed with all prefixes
-                    {
-                        NMIFF = false;
-                        sm_M1CycleType = tNMI;              // machine cycle nonmaskable interrupt, bus op. Op Code Fetch
-                        IFF1 = false;                       // disable interrupt
-                    }
-                    else if( sInt && IFF1 && mc_prefix == noPrefix )// Interrupt only when instruction is completed with all prefixes and interrupt is enabled
-                    {
-                        mc_busOp = oIntAck;             // bus op. interrupt
-                        sm_M1CycleType = tInt;          // machine cycle interrupt
-                        sm_autoWait = 1;                // one wait state during INT M1 cycle TState 1
-                        IFF1 = false;                   // disable interrupt
-                        IFF2 = false;
-                        sm_TStatesAfterInt = 0;         // reset TStates after interrupt counter
-                    }
-                }
-                else sm_MCycle++;                            // increase machine cycle
-            }
-        } else {
+        if( sm_lastTState ) nextMCycle(); // If the TState is the last state then it is necessary to increase machine cycle
+        else {
             sm_waitTState = (sm_autoWait > 0);                      // increase TState when wait state is not required
             if( sm_waitTState == false )
             {
@@ -705,6 +764,60 @@ void Z80Core::nextTState()
     else sm_waitTState = true;                                      // when the TState = 2 and Wait is active it is a wait TState
 }
 
+// Next machine cycle after last TState
+// It contains handling of bus request, halt, interrupt and maskable interrupt
+void Z80Core::nextMCycle()
+{
+    if( mc_StateMachine == sHalt) // Set Machine cycle to halt machine cycle
+    {
+        sm_M1CycleType = tHalt;                             // machine cycle halt
+        mc_StateMachine = sNone;                            // reset flag
+    }
+    if( sBusReq ) sBusAck = true; // The bus is release when it is required by signal BusReq
+    else {
+        sm_TState = 1;                                      // reset TState to first state
+
+        if( mc_StateMachine == sXYOffsetFetch ) // set machine cycle to IX/IY Address offset fetch cycle (Machine cycle number 6)
+        {
+            sm_PreXYMCycle = sm_MCycle;                     // store actual machine cycle to be able to return (cycles are inserted)
+            sm_MCycle = 6;                                  // address offset fetch cycle is cycle number 6
+            mc_StateMachine = sNone;                        // reset flag
+        }
+        else if( sm_MCycle == 7 || mc_StateMachine == sXYFetchFinish )   // last IX/IY fetch cycle is 7, but it can be finish earlier by flag
+        {
+            sm_MCycle = sm_PreXYMCycle + 1;             // restore machine cycle to cycle before IX/IY Address offset fetch cycle plus one
+            mc_StateMachine = sNone;                    // reset flag
+        }
+        else if( sm_MCycle == mc_MCycles )              // Last Machine cycle of instruction
+        {
+            sm_MCycle = 1;                              // set machine cycle number 1
+            mc_busOp = oM1;                             // bus operaton Op Code Fetch
+            if( sm_M1CycleType != tHalt ) sm_M1CycleType = tOpCodeFetch; // machine cycle Op Code Fetch only when the previous Machine cycle is not halt machine cycle
+
+            if( specialReset ) {             // if the special reset is required then the next machine cycle is special reset cycle
+                sm_M1CycleType = tSpecialReset;
+                specialReset = false;               // reset special reset flag
+            }
+            if( NMIFF && mc_prefix == noPrefix ) // Non maskable interrupt only when instruction is completed with all prefixes
+            {
+                NMIFF = false;
+                sm_M1CycleType = tNMI;              // machine cycle nonmaskable interrupt, bus op. Op Code Fetch
+                IFF1 = false;                       // disable interrupt
+            }
+            else if( sInt && IFF1 && mc_prefix == noPrefix )// Interrupt only when instruction is completed with all prefixes and interrupt is enabled
+            {
+                mc_busOp = oIntAck;             // bus op. interrupt
+                sm_M1CycleType = tInt;          // machine cycle interrupt
+                sm_autoWait = 1;                // one wait state during INT M1 cycle TState 1
+                IFF1 = false;                   // disable interrupt
+                IFF2 = false;
+                sm_TStatesAfterInt = 0;         // reset TStates after interrupt counter
+            }
+        }
+        else sm_MCycle++;                            // increase machine cycle
+    }
+}
+
 void Z80Core::risingEdgeDelayed()
 {
     // When bus is requested by other device by BUSRQ signal then signal BUSACK is set and bus is set to high impedance
@@ -787,6 +900,7 @@ void Z80Core::fallingEdgeDelayed()
                         m_dataPort->setPinMode( output );
                         m_dataPort->setOutStatFast( sDO );
                     }
+                    if( m_intMem && mc_busOp == oMemWrite ) writeMemory( sAO, sDO ); // Internal memory
                 }
                 break;
         case 2: if( sm_waitTState == false ) {// Setting bus at clock rising edge of TState 2 (it might repeat when wait states are inserted)
@@ -797,7 +911,10 @@ void Z80Core::fallingEdgeDelayed()
                 }
                 break;
         case 3: if( mc_busOp == oMemRead || mc_busOp == oIORead )// Sampling data bus for Memory read and Input/Output read cycle
-                    sDI = m_dataPort->getInpState();
+                {
+                    if( m_intMem && mc_busOp == oMemRead ) sDI = readMemory( sAO ); // Internal memory
+                    else                                   sDI = m_dataPort->getInpState();
+                }
 
             /// If  current bus op. is Fetch (machine cycle 1) then reset MREQ
             /// reset or set???
@@ -848,6 +965,17 @@ void Z80Core::releaseBus( bool rel )
     highImpedanceBus = rel;                                 // reset flag that bus is in high impedance
 }
 
+void Z80Core::idleBus() // No bus operation: control signals inactive
+{
+    m_m1Pin->setOutStatFast( true );
+    m_mreqPin->setOutStatFast( true );
+    m_iorqPin->setOutStatFast( true );
+    m_rdPin->setOutStatFast( true );
+    m_wrPin->setOutStatFast( true );
+    m_rfshPin->setOutStatFast( true );
+    m_dataPort->setPinMode( input );
+}
+
 // Read instruction to instruction register. The source of instruction depends on type of machine cycle 1. It can be read from data bus or instruction NOP or RST 38H.
 // The instruction set is switched according to previous prefix instructions.
 // The number of machine cycles and TStates for machine cycle 1 is set for the instruction.
@@ -864,8 +992,9 @@ void Z80Core::opCodeFetch()
 
     switch( sm_M1CycleType ) // Fetching opcode
     {
-        case tOpCodeFetch: m_iReg = m_dataPort->getInpState();   // reading opcode from data bus
+        case tOpCodeFetch: m_iReg = m_intMem ? readMemory( sAO ) : m_dataPort->getInpState(); // reading opcode from data bus or internal memory
             m_PC++;                                            // increase program counter PC
+            if( mc_prefix == noPrefix ) m_mcu->instExecuted(); // Count instruction at first opcode byte
 
             // Set number of machine cycles and TStates for instruction
             mc_MCycles = sTableMCycles[m_iSet][m_iReg];
@@ -903,6 +1032,15 @@ void Z80Core::opCodeFetch()
     }
 }
 
+// Op Code Fetch of prefix CB instruction with IX or IY, from machine cycle 7 (memory read)
+void Z80Core::fetchCBIndexed()
+{
+    m_iReg = sDI;                                   // reading opcode from data bus
+    m_PC++;                                         // increase program counter PC
+    m_iSet = prefixCB;                              // switch instruction set to prefix CB
+    mc_MCycles = sTableMCycles[prefixCB][m_iReg];   // set number of machine cycles for instruction
+}
+
 // execution
 // It is called at rising edge of last TState of every machine cycle - the internal CPU timing is not exact
 void Z80Core::runMCode()
@@ -38,6 +38,8 @@ class Z80Core : public Cpu8bits, public eElement
         virtual void runStep() override;
         virtual void extClock( bool clkState ) override;
 
+        virtual bool nextIsLocal() override;
+
         virtual int getIntReg( QString reg ) override;
         virtual QString getStrReg( QString reg ) override;
 
@@ -58,11 +60,14 @@ class Z80Core : public Cpu8bits, public eElement
         void setIoWait( bool ioWait );
         bool intVector() { return m_intVector; }
         void setIntVector( bool intVector );
+        bool intMemory() { return m_intMem; }
+        void setIntMemory( bool m );
 
     private:
         void risingEdgeDelayed();
         void fallingEdgeDelayed();
         void releaseBus( bool rel );
+        void idleBus();
 
         // Setting of Z80Core
         enum eProducer { pZilog = 0, pNec, pSt };
@@ -75,6 +80,13 @@ class Z80Core : public Cpu8bits, public eElement
         bool m_cmos;
         bool m_ioWait;
         bool m_intVector;
+        bool m_intMem;       // 64K Ram in Mcu program memory instead of external bus
+
+        // Whole instruction mode: Internal memory and no WAIT, INT, NMI, BUSRQ or RESET wired
+        bool m_fast;
+        bool m_busInst;      // Current instruction running in TState machine (I/O)
+        bool m_ioPending;    // I/O cycle starts in TState machine after cyclesDone edges
+        int  m_fastEdges;    // External clock edges since last instruction
 
         uint8_t sm_autoWait;
         bool sm_waitTState;
@@ -186,8 +198,15 @@ class Z80Core : public Cpu8bits, public eElement
         void clkFallingEdge();
         
         void nextTState();
+        void nextMCycle();
         void opCodeFetch();
+        void fetchCBIndexed();
         void runMCode();
+        void runFast();
+        void startIoCycle();
+
+        inline uint8_t readMemory( uint16_t addr ) { return m_mcu->getFlashValue( addr ); }
+        inline void writeMemory( uint16_t addr, uint8_t v ) { m_mcu->setFlashValue( addr, v ); }
         
         // Instruction helpers
         inline void readMem( uint16_t addr ) { mc_busOp = oMemRead; sAO = addr; }
@@ -15,6 +15,8 @@
 #include "usartmodule.h"
 #include "usartrx.h"
 #include "mcuvref.h"
+#include "mcuprofiler.h"
+#include "mcusnapshot.h"
 #include "simulator.h"
 #include "basedebugger.h"
 #include "editorwindow.h"
@@ -44,6 +46,13 @@ eMcu::eMcu( Mcu* comp, QString id )
     m_romSize   = 0;
     m_ramSize   = 0;
 
+    m_instCount  = 0;
+    m_bursts     = 0;
+    m_burstInsts = 0;
+    m_skipCycles = 0;
+    m_profiler   = nullptr;
+    m_historySize = 0;
+
     m_firmware = "";
     m_debugger = nullptr;
     m_debugging = false;
@@ -55,6 +64,8 @@ eMcu::eMcu( Mcu* comp, QString id )
 eMcu::~eMcu()
 {
     if( m_cpu ) delete m_cpu;
+    if( m_profiler ) delete m_profiler;
+    clearHistory();
     m_interrupts.remove();
     for( McuModule* module : m_modules ) delete module;
     if( m_pSelf == this ) m_pSelf = nullptr;
@@ -70,7 +81,13 @@ void eMcu::reset()
     m_component->crash( false );
     m_state = mcuStopped;
     m_cycle = 0;
+    m_instCount = 0;
+    m_bursts = 0;
+    m_burstInsts = 0;
+    m_skipCycles = 0;
     cyclesDone = 0;
+    if( m_profiler ) m_profiler->reset();
+    clearHistory();
 
     for( McuModule* module : m_modules  ) { module->reset(); module->sleep(-1 ); }
     for( IoPort*    ioPort : m_ioPorts  ) ioPort->reset();
@@ -141,15 +158,54 @@ void eMcu::runEvent()
         stepCpu();
         uint64_t cycles = cyclesDone;
         if( cycles == 0 ) cycles = 1;                        // 8051: 2 Read cycles per Machine cycle
+        cycles = runBurst( cycles );
         Simulator::self()->addEvent( cycles*m_psTick, this );
     }
 }
 
+uint64_t eMcu::runBurst( uint64_t cycles ) // Run instructions with no external effects up to next event
+{
+    uint64_t insts = 1;
+    uint64_t time  = Simulator::self()->circTime() + cycles*m_psTick; // Next instruction time
+    uint64_t limit = Simulator::self()->burstLimit();
+
+    while( time < limit && m_state == mcuRunning && m_interrupts.idle() )
+    {
+        uint64_t maxCycles = (limit-time)/m_psTick;
+        if( maxCycles > 1<<30 ) maxCycles = 1<<30;
+
+        uint64_t c = m_cpu->skipLoop( maxCycles ); // Wait loop: nothing can change until limit
+        if( c )
+        {
+            m_cycle      += cyclesDone;
+            m_skipCycles += cyclesDone;
+            if( m_profiler ) m_profiler->addCycles( m_cpu->getPC(), cyclesDone );
+        }else{
+            if( !m_cpu->nextIsLocal() ) break;
+            stepCpu();
+            c = cyclesDone;
+            if( c == 0 ) c = 1;
+            insts++;
+        }
+        cycles += c;
+        time   += c*m_psTick;
+    }
+    m_bursts++;
+    m_burstInsts += insts;
+    return cycles;
+}
+
 void eMcu::stepCpu()
 {
     if( !m_flashSize || m_cpu->getPC() < m_flashSize )
     {
-        if( m_state == mcuRunning ) m_cpu->runStep();
+        if( m_state == mcuRunning )
+        {
+            uint32_t pc = m_profiler ? m_cpu->getPC() : 0;
+            m_cpu->runStep();
+            m_instCount++;
+            if( m_profiler ) m_profiler->step( pc, cyclesDone, m_cpu->getPC() );
+        }
         m_interrupts.runInterrupts();
     }else{
         m_state = mcuError;
@@ -166,6 +222,106 @@ void eMcu::setDebugger( BaseDebugger* deb )
     m_ramTable->setDebugger( deb );
 }
 
+void eMcu::setProfiling( bool p )
+{
+    if( p == (m_profiler != nullptr) ) return;
+
+    if( p ) m_profiler = new McuProfiler( this );
+    else{
+        delete m_profiler;
+        m_profiler = nullptr;
+    }
+}
+
+McuSnapshot* eMcu::saveSnapshot( McuSnapshot* base )
+{
+    if( m_state < mcuRunning || !m_cpu ) return nullptr;
+
+    McuSnapshot* snap = new McuSnapshot();
+    StateStream* state = snap->state();
+    if( !m_cpu->saveState( state ) ) { delete snap; return nullptr; }
+
+    m_interrupts.saveState( state );
+    for( McuModule* module : m_modules )
+    {
+        if( module->saveState( state ) ) continue;
+        delete snap;                   // Module state can't be restored
+        return nullptr;
+    }
+    snap->savePages( McuSnapshot::memDATA, m_dataMem.data(), m_dataMem.size(), base );
+    snap->savePages( McuSnapshot::memPROG, (uint8_t*)m_progMem.data(), m_progMem.size()*sizeof(uint16_t), base );
+    snap->savePages( McuSnapshot::memROM , (uint8_t*)m_eeprom.data(), m_eeprom.size()*sizeof(int), base );
+
+    snap->cycle      = m_cycle;
+    snap->instCount  = m_instCount;
+    snap->cyclesDone = cyclesDone;
+    snap->sleeping   = (m_state == mcuSleeping);
+    return snap;
+}
+
+bool eMcu::loadSnapshot( McuSnapshot* snap ) // Simulation time is not restored
+{
+    if( !snap || m_state < mcuRunning || !m_cpu ) return false;
+
+    snap->loadPages( McuSnapshot::memDATA, m_dataMem.data(), m_dataMem.size() ); // Raw copy: no watchers called
+    snap->loadPages( McuSnapshot::memROM , (uint8_t*)m_eeprom.data(), m_eeprom.size()*sizeof(int) );
+
+    std::vector<uint32_t> changed;
+    snap->loadPages( McuSnapshot::memPROG, (uint8_t*)m_progMem.data(), m_progMem.size()*sizeof(uint16_t), &changed );
+    for( uint32_t start : changed )                         // Discard decoded instructions
+    {
+        uint32_t end = (start+SNAP_PAGE)/sizeof(uint16_t);
+        for( uint32_t addr=start/sizeof(uint16_t); addr<end && addr<m_progMem.size(); ++addr ) m_cpu->pgmChanged( addr );
+    }
+    StateStream* state = snap->state();
+    state->rewind();
+    m_cpu->loadState( state );
+    m_interrupts.loadState( state );
+    for( McuModule* module : m_modules ) module->loadState( state );
+
+    m_cycle     = snap->cycle;
+    m_instCount = snap->instCount;
+    cyclesDone  = snap->cyclesDone;
+    if( snap->sleeping != (m_state == mcuSleeping) ) sleep( snap->sleeping );
+    return true;
+}
+
+void eMcu::setHistorySize( int size )
+{
+    if( size < 0 ) size = 0;
+    m_historySize = size;
+    while( (int)m_history.size() > m_historySize ) { delete m_history.front(); m_history.pop_front(); }
+}
+
+void eMcu::saveHistory()
+{
+    if( !m_historySize ) return;
+
+    McuSnapshot* last = m_history.empty() ? nullptr : m_history.back();
+    McuSnapshot* snap = saveSnapshot( last );
+    if( !snap ) return;
+
+    m_history.push_back( snap );
+    if( (int)m_history.size() > m_historySize ) { delete m_history.front(); m_history.pop_front(); }
+}
+
+bool eMcu::rewind()
+{
+    if( m_history.empty() ) return false;
+
+    McuSnapshot* snap = m_history.back();
+    m_history.pop_back();
+    bool ok = loadSnapshot( snap );
+    delete snap;
+    return ok;
+}
+
+void eMcu::clearHistory()
+{
+    for( McuSnapshot* snap : m_history ) delete snap;
+    m_history.clear();
+}
+
 void eMcu::setDebugging( bool d )
 {
     m_debugger->m_prevLine.lineNumber = -1;
@@ -200,6 +356,12 @@ void eMcu::sleep( bool s )
     for( McuModule* module : m_modules ) module->sleep( mode );
 }
 
+void eMcu::setFlashValue( int address, uint16_t value )
+{
+    m_progMem[address] = value;
+    if( m_cpu ) m_cpu->pgmChanged( address );
+}
+
 void eMcu::setFreq( double freq )
 {
     if( m_component->forceFreq() ) return;
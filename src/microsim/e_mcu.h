@@ -12,11 +12,15 @@
 #include "mcudataspace.h"
 #include "mcusleep.h"
 
+#include <deque>
+
 //class CpuBase;
 class McuTimer;
 class McuWdt;
 class McuSleep;
 class McuCtrlPort;
+class McuProfiler;
+class McuSnapshot;
 
 enum{
     R_READ = 0,
@@ -61,12 +65,26 @@ class eMcu : public DataSpace, public eIou
         inline int sleepMode() { return m_sleepModule->mode(); }
 
         void stepCpu();
+        uint64_t runBurst( uint64_t cycles );
 
         void setDebugger( BaseDebugger* deb );
         void setDebugging( bool d );
 
+        void setProfiling( bool p );                  // Only while simulation thread is stopped (Simulator::holdSim)
+        McuProfiler* profiler() { return m_profiler; } // Read or modify only while simulation thread is stopped
+
+        McuSnapshot* saveSnapshot( McuSnapshot* base=nullptr ); // Share unchanged pages with base, nullptr if not supported
+        bool loadSnapshot( McuSnapshot* snap );
+
+        void setHistorySize( int size ); // Snapshots kept for rewind, 0 = disabled
+        int  historySize() { return m_historySize; }
+        int  historyCount() { return m_history.size(); }
+        void saveHistory();              // Take snapshot for rewind
+        bool rewind();                   // Go back to last snapshot taken
+        void clearHistory();
+
         uint16_t getFlashValue( int address ) { return m_progMem[address]; }
-        void     setFlashValue( int address, uint16_t value ) { m_progMem[address] = value; }
+        void     setFlashValue( int address, uint16_t value );
         uint32_t flashSize(){ return m_flashSize; }
         uint32_t wordSize() { return m_wordSize; }
         uint8_t  pgmPage() { return m_pgmPage; }
@@ -78,6 +96,10 @@ class eMcu : public DataSpace, public eIou
         void     setRomValue( int address, uint8_t value ) { m_eeprom[address] = value; }
 
         uint64_t cycle(){ return m_cycle; }
+        uint64_t instCount() { return m_instCount; } // Instructions executed since reset
+        void instExecuted() { m_instCount++; }       // Cores clocked by extClock(), no stepCpu()
+        double avgBurst() { return m_bursts ? (double)m_burstInsts/m_bursts : 0; } // Instructions per event
+        uint64_t skipCycles() { return m_skipCycles; } // Cycles jumped over in wait loops
 
         void hardReset( bool r );
         void sleep( bool s );
@@ -125,6 +147,14 @@ class eMcu : public DataSpace, public eIou
         mcuState_t m_state;
 
         uint64_t m_cycle;
+        uint64_t m_instCount;
+        uint64_t m_bursts;     // Events that ran instructions
+        uint64_t m_burstInsts; // Instructions run by those events
+        uint64_t m_skipCycles; // Cycles skipped by Cpu::skipLoop()
+        McuProfiler* m_profiler; // Null if not profiling
+
+        std::deque<McuSnapshot*> m_history; // Snapshots for rewind, newest last
+        int m_historySize;
         std::vector<uint16_t> m_progMem;  // Program memory
         uint32_t m_flashSize;
         uint8_t  m_wordSize; // Size of Program memory word in bytes
@@ -92,8 +92,14 @@ class Mcu : public Chip, public Linker
         QString device() { return m_device; }
         bool isScripted() { return m_scripted; }
         Cpu8bits* cpu() { return m_eMcu.cpu(); }
+        uint64_t instCount() { return m_eMcu.instCount(); }
+        double avgBurst() { return m_eMcu.avgBurst(); }
+        uint64_t skipCycles() { return m_eMcu.skipCycles(); }
 
         void reset() { m_eMcu.hardReset( true ); }
+
+        McuSnapshot* saveSnapshot() { return m_eMcu.saveSnapshot(); } // nullptr if not supported
+        bool loadSnapshot( McuSnapshot* s ) { return m_eMcu.loadSnapshot( s ); }
         void crash( bool c) { m_crashed = c; update(); }
 
         bool load( QString fileName );
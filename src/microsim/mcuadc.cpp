@@ -6,6 +6,7 @@
 #include "mcuadc.h"
 #include "mcupin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcuinterrupts.h"
 #include "simulator.h"
 
@@ -63,6 +64,43 @@ void McuAdc::startConversion()
     Simulator::self()->addEvent( m_convTime, this );
 }
 
+bool McuAdc::saveState( StateStream* s )
+{
+    s->putEvent( this ); // Conversion in progress
+    s->put( m_enabled );
+    s->put( m_converting );
+    s->put( m_leftAdjust );
+    s->put( m_adcClock );
+    s->put( m_adcValue );
+    s->put( m_convTime );
+    s->put( m_channel );
+    s->put( m_chOffset );
+    s->put( m_fixedVref );
+    s->put( m_vRefP );
+    s->put( m_vRefN );
+    s->put( m_prIndex );
+    s->put( m_prescaler );
+    return true;
+}
+
+void McuAdc::loadState( StateStream* s )
+{
+    s->getEvent( this );
+    s->get( m_enabled );
+    s->get( m_converting );
+    s->get( m_leftAdjust );
+    s->get( m_adcClock );
+    s->get( m_adcValue );
+    s->get( m_convTime );
+    s->get( m_channel );
+    s->get( m_chOffset );
+    s->get( m_fixedVref );
+    s->get( m_vRefP );
+    s->get( m_vRefN );
+    s->get( m_prIndex );
+    s->get( m_prescaler );
+}
+
 void McuAdc::updtVref()
 {
     m_vRefP = m_mcu->vdd();
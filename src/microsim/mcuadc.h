@@ -25,6 +25,9 @@ class McuAdc : public McuPrescaled, public eElement
         virtual void setChannel( uint8_t val ){;}
         virtual void startConversion();
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         virtual void updtVref();
         virtual void specialConv();
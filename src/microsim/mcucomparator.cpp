@@ -5,6 +5,8 @@
 
 #include "mcucomparator.h"
 #include "e_mcu.h"
+#include "mcupin.h"
+#include "mcusnapshot.h"
 
 McuComp::McuComp( eMcu* mcu, QString name )
        : McuModule( mcu, name )
@@ -31,3 +33,42 @@ void McuComp::callBackDoub( double vref ) // Called from Vref module
     m_vref = vref;
     if( m_enabled ) voltChanged();
 }
+
+bool McuComp::saveState( StateStream* s )
+{
+    auto index = [this]( McuPin* p ){        // -1: no Pin, -2: Pin not in list (ADC multiplexer)
+        if( !p ) return (int8_t)-1;
+        for( uint i=0; i<m_pins.size(); ++i ) if( m_pins[i] == p ) return (int8_t)i;
+        return (int8_t)-2;
+    };
+    s->put( m_fixVref );
+    s->put( m_enabled );
+    s->put( m_compOut );
+    s->put( m_vref );
+    s->put( m_mode );
+    s->put( index( m_pinP ) );
+    s->put( index( m_pinN ) );
+    s->put( index( m_pinOut ) );
+    return true;
+}
+
+void McuComp::loadState( StateStream* s ) // Pin callbacks are set by each Comparator
+{
+    auto pin = [this]( int8_t i, McuPin* p ){ return (i == -2) ? p : (i < 0) ? nullptr : m_pins[i]; };
+    int8_t pinP, pinN, pinOut;
+
+    s->get( m_fixVref );
+    s->get( m_enabled );
+    s->get( m_compOut );
+    s->get( m_vref );
+    s->get( m_mode );
+    s->get( pinP );
+    s->get( pinN );
+    s->get( pinOut );
+
+    if( m_pinP ) m_pinP->changeCallBack( this, false );
+    if( m_pinN ) m_pinN->changeCallBack( this, false );
+    m_pinP   = pin( pinP, m_pinP );
+    m_pinN   = pin( pinN, m_pinN );
+    m_pinOut = pin( pinOut, m_pinOut );
+}
@@ -24,6 +24,9 @@ class McuComp : public McuModule, public eElement
 
         virtual void callBackDoub( double vref ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         virtual void setMode( uint8_t mode ) { m_mode = mode; }
 
@@ -159,6 +159,11 @@ int McuCreator::processFile( QString fileName )
         if( root.hasAttribute("prog") )       createProgMem( root.attribute("prog").toUInt(0,0) );
         if( root.hasAttribute("progword") )   mcu->m_wordSize = root.attribute("progword").toUInt(0,0);
         if( root.hasAttribute("progpage") )   mcu->m_pgmPage = root.attribute("progpage").toUInt(0,0);
+        if( m_core == "Z80" && !mcu->m_flashSize ) // 64K Ram for Z80 internal memory
+        {
+            createProgMem( 0x10000 );
+            mcu->m_wordSize = 1;
+        }
         if( root.hasAttribute("eeprom") )     createRomMem( root.attribute("eeprom").toUInt(0,0) );
         if( root.hasAttribute("inst_cycle") ) mcu->setInstCycle( root.attribute("inst_cycle").toDouble() );
         if( root.hasAttribute("cpu_cycle") )  mcu->m_cPerTick = root.attribute("cpu_cycle").toDouble();
@@ -347,7 +352,7 @@ void McuCreator::createProgMem( uint32_t size )
 void McuCreator::createDataMem( uint32_t size )
 {
     mcu->m_ramSize = size;
-    mcu->m_dataMem.resize( size, 0 );
+    mcu->setRamSize( size );
     mcu->m_addrMap.resize( size, 0xFFFF ); // Not Maped values = 0xFFFF -> don't exist
 }
 
@@ -5,6 +5,7 @@
 
 #include "mcudac.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 
 McuDac::McuDac( eMcu* mcu, QString name )
       : McuModule( mcu, name )
@@ -27,3 +28,24 @@ void McuDac::initialize()
     m_vRefP = 0;
     m_vRefN = 0;
 }
+
+bool McuDac::saveState( StateStream* s )
+{
+    s->put( m_enabled );
+    s->put( m_outVoltEn );
+    s->put( m_outVolt );
+    s->put( m_vRefP );
+    s->put( m_vRefN );
+    s->put( m_outVal );
+    return true;
+}
+
+void McuDac::loadState( StateStream* s )
+{
+    s->get( m_enabled );
+    s->get( m_outVoltEn );
+    s->get( m_outVolt );
+    s->get( m_vRefP );
+    s->get( m_vRefN );
+    s->get( m_outVal );
+}
@@ -23,6 +23,9 @@ class McuDac: public McuModule, public eElement
 
         virtual void outRegChanged( uint8_t ){;}
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
 
         bool m_enabled;
@@ -19,11 +19,8 @@ DataSpace::DataSpace()
 
 DataSpace::~DataSpace()
 {
-    for( uint16_t addr : m_readSignals.keys() )
-        delete m_readSignals.value( addr );
-
-    for( uint16_t addr : m_writeSignals.keys() )
-        delete m_writeSignals.value( addr );
+    for( McuSignal* regSignal : m_readSignals  ) if( regSignal ) delete regSignal;
+    for( McuSignal* regSignal : m_writeSignals ) if( regSignal ) delete regSignal;
 
     m_readSignals.clear();
     m_writeSignals.clear();
@@ -47,18 +44,32 @@ void DataSpace::initialize()
     }
 }
 
-uint8_t DataSpace::readReg( uint16_t addr )
+void DataSpace::setRamSize( uint32_t size ) // Only grows: Signals may be created before
 {
-    uint8_t v = m_dataMem[addr];
-    McuSignal* regSignal = m_readSignals.value( addr );
-    if( regSignal )
-    {
-        m_regOverride = -1;
-        regSignal->emitValue( v );
-        if( m_regOverride >= 0 ) v = (uint8_t)m_regOverride; // Value overriden in callback
-        else                     v = m_dataMem[addr];        // Timers update their counters in callback
-    }
-    return v;
+    if( size < m_dataMem.size() )      size = m_dataMem.size();
+    if( size < m_readSignals.size() )  size = m_readSignals.size();
+    if( size < m_writeSignals.size() ) size = m_writeSignals.size();
+
+    m_dataMem.resize( size, 0 );
+    m_readSignals.resize( size, nullptr );
+    m_writeSignals.resize( size, nullptr );
+}
+
+McuSignal* DataSpace::watchSignal( uint16_t addr, bool write )
+{
+    std::vector<McuSignal*>& sigTable = write ? m_writeSignals : m_readSignals;
+    if( addr >= sigTable.size() ) setRamSize( addr+1 ); // Ram size not set yet
+
+    if( !sigTable[addr] ) sigTable[addr] = new McuSignal;
+    return sigTable[addr];
+}
+
+uint8_t DataSpace::readWatched( uint16_t addr, McuSignal* regSignal )
+{
+    m_regOverride = -1;
+    regSignal->emitValue( m_dataMem[addr] );
+    if( m_regOverride >= 0 ) return (uint8_t)m_regOverride; // Value overriden in callback
+    return m_dataMem[addr];                                 // Timers update their counters in callback
 }
 
 void DataSpace::writeReg( uint16_t addr, uint8_t v, bool masked )
@@ -69,7 +80,7 @@ void DataSpace::writeReg( uint16_t addr, uint8_t v, bool masked )
         if( addr < m_regMask.size() ) mask = m_regMask[addr];
         if( mask != 0xFF && mask != 0x00 ) v = (m_dataMem[addr] & ~mask) | (v & mask);
     }
-    McuSignal* regSignal = m_writeSignals.value( addr );
+    McuSignal* regSignal = m_writeSignals[addr];
     if( regSignal )
     {
         m_regOverride = -1;
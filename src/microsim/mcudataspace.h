@@ -30,16 +30,22 @@ class DataSpace
         uint16_t getRegAddress( QString reg );  // Get Reg address by name
         uint8_t* getReg( QString reg );            // Get pointer to Reg data by name
         bool     regExist( QString reg ) { return m_regInfo.contains( reg ); }
-        uint8_t  readReg( uint16_t addr );         // Read Register (call watchers)
-        void     writeReg(uint16_t addr, uint8_t v, bool masked=true);// Write Register (call watchers)
+        inline uint8_t readReg( uint16_t addr )    // Read Register (call watchers)
+        {
+            McuSignal* regSignal = m_readSignals[addr];
+            if( !regSignal ) return m_dataMem[addr];  // Not watched: plain memory access
+            return readWatched( addr, regSignal );
+        }
+        void writeReg( uint16_t addr, uint8_t v, bool masked=true );// Write Register (call watchers)
+        bool isReadWatched( uint16_t addr ) { return m_readSignals[addr]; }
+
+        McuSignal* watchSignal( uint16_t addr, bool write ); // Get or create Signal for Reg address
 
         RamTable* getRamTable() { return m_ramTable; }
 
         QHash<QString, uint8_t>*       bitMasks() { return &m_bitMasks; }
         QHash<QString, uint16_t>*      bitRegs() { return &m_bitRegs; }
         QHash<QString, regInfo_t>*     regInfo()  { return &m_regInfo; }
-        QHash<uint16_t, McuSignal*>* readSignals() { return &m_readSignals; }
-        QHash<uint16_t, McuSignal*>* writeSignals() { return &m_writeSignals; }
 
         void setStatusBits( QStringList bits ) { m_statusBits = bits; }
         QStringList getStatusBits() { return m_statusBits; }
@@ -49,6 +55,10 @@ class DataSpace
         int m_regOverride;                         // Register value is overriden at write time
 
     protected:
+        uint8_t readWatched( uint16_t addr, McuSignal* regSignal );
+
+        void setRamSize( uint32_t size );          // Grow Ram space and Signal tables, never shrink
+
         uint16_t m_regStart;                       // First address of SFR section
         uint16_t m_regEnd;                         // Last  address of SFR Section
 
@@ -59,8 +69,8 @@ class DataSpace
         std::vector<uint8_t>  m_regMask;           // Registers Write mask
 
         QHash<QString, regInfo_t>   m_regInfo;     // Access Reg Info by  Reg name
-        QHash<uint16_t, McuSignal*> m_readSignals; // Access read Reg Signals by Reg address
-        QHash<uint16_t, McuSignal*> m_writeSignals;// Access write Reg Signals by Reg address
+        std::vector<McuSignal*> m_readSignals;     // Read Reg Signals by Reg address, same size as m_dataMem
+        std::vector<McuSignal*> m_writeSignals;    // Write Reg Signals by Reg address, same size as m_dataMem
         QHash<QString, uint8_t>     m_bitMasks;    // Access Bit mask by bit name
         QHash<QString, uint16_t>    m_bitRegs;     // Access Reg. address by bit name
 
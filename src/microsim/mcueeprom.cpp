@@ -6,6 +6,7 @@
 #include "mcueeprom.h"
 #include "simulator.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 
 McuEeprom::McuEeprom( eMcu* mcu, QString name )
          : McuModule( mcu, name )
@@ -46,3 +47,15 @@ void McuEeprom::addrWriteH( uint8_t val )
     if( m_addressL ) m_address = (val << 8) + *m_addressL;
 }
 
+bool McuEeprom::saveState( StateStream* s )
+{
+    s->putEvent( this ); // Write cycle in progress
+    s->put( m_address );
+    return true;
+}
+
+void McuEeprom::loadState( StateStream* s )
+{
+    s->getEvent( this );
+    s->get( m_address );
+}
@@ -24,6 +24,9 @@ class McuEeprom : public McuModule, public eElement
         virtual void addrWriteL( uint8_t val );
         virtual void addrWriteH( uint8_t val );
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
 
         uint8_t* m_addressL; // Actual ram for counter Low address byte
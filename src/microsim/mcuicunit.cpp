@@ -8,6 +8,7 @@
 #include "mcuinterrupts.h"
 #include "mcupin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 
 McuIcUnit::McuIcUnit( eMcu* mcu, QString name )
          : McuModule( mcu, name )
@@ -62,3 +63,25 @@ void McuIcUnit::enable( bool en )
     m_enabled = en;
     if( m_icPin ) m_icPin->changeCallBack( this, en );
 }
+
+bool McuIcUnit::saveState( StateStream* s )
+{
+    s->put( m_enabled );
+    s->put( m_inState );
+    s->put( m_mode );
+    s->put( m_fallingEdge );
+    s->put( m_prescaler );
+    s->put( m_counter );
+    return true;
+}
+
+void McuIcUnit::loadState( StateStream* s )
+{
+    s->get( m_enabled );
+    s->get( m_inState );
+    s->get( m_mode );
+    s->get( m_fallingEdge );
+    s->get( m_prescaler );
+    s->get( m_counter );
+    enable( m_enabled );
+}
@@ -26,6 +26,9 @@ class McuIcUnit : public McuModule, public eElement
 
         void enable( bool en );
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         void clear();
 
@@ -9,6 +9,8 @@
 #include "cpu8bits.h"
 #include "mcupin.h"
 #include "e_mcu.h"
+#include "mcuprofiler.h"
+#include "mcusnapshot.h"
 #include "datautils.h"
 
 Interrupt::Interrupt( QString name, uint16_t vector, eMcu* mcu )
@@ -170,6 +172,7 @@ void Interrupts::runInterrupts()
         if( !m_active ) {
             qDebug() << "Interrupts::retI Error: No active Interrupt"; return; }
         m_active->exitInt();
+        if( m_mcu->profiler() ) m_mcu->profiler()->isrExit();
 
         if( m_running )                         // Some interrupt was interrupted by this one
         {
@@ -197,6 +200,7 @@ void Interrupts::runInterrupts()
         }
         else return;
     }
+    if( m_mcu->profiler() ) m_mcu->profiler()->isrEnter( m_pending, m_mcu->cpu()->getPC() );
     m_pending->execute();
     m_active  = m_pending;
     m_pending = m_pending->m_nextInt;
@@ -260,3 +264,48 @@ Interrupt* Interrupts::getInterrupt( QString name )
 {
     return m_intList.value( name );
 }
+
+void Interrupts::saveState( StateStream* s )
+{
+    QList<Interrupt*> ints = m_intList.values();
+    auto index = [&ints]( Interrupt* i ){ return (int16_t)ints.indexOf( i ); }; // -1 if nullptr
+
+    s->put( m_enabled );
+    s->put( m_reti );
+    s->put( index( m_active ) );
+    s->put( index( m_pending ) );
+    s->put( index( m_running ) );
+
+    for( Interrupt* i : ints )
+    {
+        s->put( i->m_enabled );
+        s->put( i->m_priority );
+        s->put( i->m_raised );
+        s->put( i->m_autoClear );
+        s->put( i->m_continuous );
+        s->put( index( i->m_nextInt ) ); // Pending and running lists
+    }
+}
+
+void Interrupts::loadState( StateStream* s )
+{
+    QList<Interrupt*> ints = m_intList.values();
+    int16_t active, pending, running, next;
+    auto interrupt = [&ints]( int16_t i ){ return (i < 0) ? nullptr : ints.at( i ); };
+
+    s->get( m_enabled );
+    s->get( m_reti );
+    s->get( active );  m_active  = interrupt( active );
+    s->get( pending ); m_pending = interrupt( pending );
+    s->get( running ); m_running = interrupt( running );
+
+    for( Interrupt* i : ints )
+    {
+        s->get( i->m_enabled );
+        s->get( i->m_priority );
+        s->get( i->m_raised );
+        s->get( i->m_autoClear );
+        s->get( i->m_continuous );
+        s->get( next ); i->m_nextInt = interrupt( next );
+    }
+}
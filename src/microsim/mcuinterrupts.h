@@ -15,10 +15,12 @@ class eMcu;
 class Interrupts;
 class McuModule;
 class IoPin;
+class StateStream;
 
 class Interrupt
 {
         friend class McuCreator;
+        friend class Interrupts;
 
     public:
         Interrupt( QString name, uint16_t vector, eMcu* mcu );
@@ -29,6 +31,8 @@ class Interrupt
         virtual void execute();
         virtual void exitInt();
 
+        QString name() { return m_name; }
+
         uint8_t enabled() { return m_enabled; }
         uint8_t raised() { return m_raised; }
         void clearFlag();
@@ -92,6 +96,7 @@ class Interrupts
 
         void runInterrupts();
         void retI() { m_reti = true; }
+        bool idle() { return !m_reti && !(m_enabled && m_pending); } // runInterrupts() will do nothing
         void remove();
         void resetInts();
         void writeGlobalFlag( uint8_t flag );
@@ -101,6 +106,9 @@ class Interrupts
 
         Interrupt* getInterrupt( QString name );
 
+        void saveState( StateStream* s );
+        void loadState( StateStream* s );
+
     protected:
         eMcu* m_mcu;
 
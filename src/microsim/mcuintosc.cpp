@@ -7,6 +7,7 @@
 #include "simulator.h"
 #include "mcupin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcu.h"
 
 McuIntOsc::McuIntOsc( eMcu* mcu, QString name )
@@ -92,3 +93,20 @@ void McuIntOsc::setPin( int n, McuPin* p )
     else if( n == 1 ) m_clkPin[1] = m_clkInPin = p;
     else if( n == 2 ) m_clkOutPin = p;
 }
+
+bool McuIntOsc::saveState( StateStream* s )
+{
+    s->putEvent( this ); // Clock out Pin
+    s->put( m_psInst );
+    s->put( m_intOscFreq );
+    return true;
+}
+
+void McuIntOsc::loadState( StateStream* s )
+{
+    s->getEvent( this );
+    s->get( m_psInst );
+    s->get( m_intOscFreq );
+
+    freqChanged(); // Mcu frequency set by software
+}
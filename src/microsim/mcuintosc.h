@@ -39,6 +39,9 @@ class McuIntOsc : public McuModule, public eElement
 
         virtual bool freqChanged(){ return false; }
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         uint64_t m_psInst;
 
@@ -11,6 +11,7 @@
 
 class eMcu;
 class Interrupt;
+class StateStream;
 
 class McuModule
 {
@@ -30,6 +31,9 @@ class McuModule
         virtual void callBack() {;}
         virtual void sleep( int mode );
 
+        virtual bool saveState( StateStream* ){ return false; } // Module variables not in Ram, false if snapshots not supported
+        virtual void loadState( StateStream* ){;}
+
         void setSleepMode( uint8_t m ) { m_sleepMode = m; }
 
         virtual void setInterrupt( Interrupt* i ) { m_interrupt = i; }
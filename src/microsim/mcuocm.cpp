@@ -7,6 +7,7 @@
 #include "mcuocunit.h"
 #include "mcupin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 
 McuOcm::McuOcm( eMcu* mcu, QString name )
       : McuPrescaled( mcu, name )
@@ -45,3 +46,25 @@ void McuOcm::setState( McuOcUnit* oc, bool s ) // OC units call at state changes
     OutputOcm();
 }
 
+bool McuOcm::saveState( StateStream* s )
+{
+    s->put( m_state1 );
+    s->put( m_state2 );
+    s->put( m_oc1Active );
+    s->put( m_oc2Active );
+    s->put( m_mode );
+    s->put( m_prIndex );
+    s->put( m_prescaler );
+    return true;
+}
+
+void McuOcm::loadState( StateStream* s )
+{
+    s->get( m_state1 );
+    s->get( m_state2 );
+    s->get( m_oc1Active );
+    s->get( m_oc2Active );
+    s->get( m_mode );
+    s->get( m_prIndex );
+    s->get( m_prescaler );
+}
@@ -25,6 +25,9 @@ class McuOcm : public McuPrescaled, public eElement
         void setOcActive( McuOcUnit* oc, bool a );
         void setState( McuOcUnit* oc, bool s );
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         virtual void OutputOcm()=0;
 
@@ -6,6 +6,7 @@
 #include "mcuocunit.h"
 #include "mcupin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "simulator.h"
 
 McuOcUnit::McuOcUnit( eMcu* mcu, QString name )
@@ -113,6 +114,31 @@ void McuOcUnit::setOcActs( ocAct_t comAct, ocAct_t tovAct )
     m_tovAct = tovAct;
 }
 
+bool McuOcUnit::saveState( StateStream* s )
+{
+    s->put( m_comAct );
+    s->put( m_tovAct );
+    s->put( m_enabled );
+    s->put( m_ctrlPin );
+    s->put( m_mode );
+    s->put( m_comMatch );
+    s->put( m_extMatch );
+    s->put( m_pinSet );
+    return true;
+}
+
+void McuOcUnit::loadState( StateStream* s )
+{
+    s->get( m_comAct );
+    s->get( m_tovAct );
+    s->get( m_enabled );
+    s->get( m_ctrlPin );
+    s->get( m_mode );
+    s->get( m_comMatch );
+    s->get( m_extMatch );
+    s->get( m_pinSet );
+}
+
 void McuOcUnit::ocrWriteL( uint8_t val )
 {
     m_comMatch = (m_comMatch & 0xFF00) | val;
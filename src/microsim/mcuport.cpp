@@ -10,6 +10,7 @@
 #include "mcu.h"
 #include "e_mcu.h"
 #include "mcuinterrupts.h"
+#include "mcusnapshot.h"
 #include "datautils.h"
 
 McuPort::McuPort( eMcu* mcu, QString name )
@@ -52,6 +53,54 @@ void McuPort::pinChanged( uint8_t pinMask, uint8_t val ) // Pin number in pinMas
     if( m_inAddr ) *m_inReg = m_pinState; //m_mcu->writeReg( m_inAddr, m_pinState, false ); // Write to RAM
 }
 
+bool McuPort::saveState( StateStream* s )
+{
+    s->put( m_intMask );
+
+    for( int i=0; i<m_numPins; ++i ) // Pins controlled by other Modules
+    {
+        McuPin* pin = m_pins[i];
+        s->put( pin->m_outCtrl );
+        s->put( pin->m_dirCtrl );
+        s->put( pin->m_pinMode );
+        s->put( pin->getOutState() );
+        s->put( pin->m_isAnalog );
+        s->put( pin->m_extIntTrigger );
+    }
+    return true;
+}
+
+void McuPort::loadState( StateStream* s ) // Registers already restored: update Pins
+{                                         // Input state is not restored: circuit didn't go back
+    s->get( m_intMask );
+
+    for( int i=0; i<m_numPins; ++i )
+    {
+        McuPin* pin = m_pins[i];
+        pinMode_t mode;
+        bool outState, analog;
+        s->get( pin->m_outCtrl );
+        s->get( pin->m_dirCtrl );
+        s->get( mode );
+        s->get( outState );
+        s->get( analog );
+        s->get( pin->m_extIntTrigger );
+
+        pin->setAnalog( analog );
+        if( pin->m_dirCtrl ) pin->setPinMode( mode );
+        if( pin->m_outCtrl ) pin->IoPin::setOutState( outState );
+    }
+    if( m_dirReg )
+    {
+        uint8_t dir = m_dirInv ? ~*m_dirReg : *m_dirReg;
+        for( int i=0; i<m_numPins; ++i ) m_pins[i]->setDirection( dir & (1<<i) );
+    }
+    if( m_outReg )
+        for( int i=0; i<m_numPins; ++i ) m_pins[i]->setPortState( *m_outReg & (1<<i) );
+
+    readPort( 0 );
+}
+
 void McuPort::outChanged( uint8_t val )
 {
     uint8_t changed = *m_outReg ^ val; // See which Pins have actually changed
@@ -27,6 +27,9 @@ class McuPort : public McuModule
         virtual void reset() override;
         virtual void pinChanged( uint8_t pinMask, uint8_t val );
 
+        bool saveState( StateStream* s ) override;
+        void loadState( StateStream* s ) override;
+
         void setPullups( uint8_t puMask );
         void setAllPullups( uint8_t val );
         void clearAllPullups( uint8_t val );
@@ -0,0 +1,217 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <QFile>
+#include <QTextStream>
+#include <QSet>
+#include <algorithm>
+
+#include "mcuprofiler.h"
+#include "mcuinterrupts.h"
+#include "e_mcu.h"
+
+#define ROOT_KEY INT32_MIN
+#define MAX_DEPTH 64
+#define MAX_CALLS 60 // Keep some frames for ISRs
+
+McuProfiler::McuProfiler( eMcu* mcu )
+{
+    m_mcu = mcu;
+    m_funcAt.assign( mcu->flashSize(), -1 );
+    reset();
+}
+McuProfiler::~McuProfiler(){}
+
+void McuProfiler::reset()
+{
+    m_pcCycles.assign( m_mcu->flashSize(), 0 );
+
+    m_nodes.clear();
+    m_nodes.push_back( { -1, ROOT_KEY, 0 } );
+    m_children.clear();
+    m_node  = 0;
+    m_depth = 0;
+
+    m_isrs.clear();
+    m_isrIndex.clear();
+}
+
+void McuProfiler::setFunctions( QMap<int, QString> functions )
+{
+    m_funcAt.assign( m_mcu->flashSize(), -1 );
+    m_funcNames.clear();
+
+    for( int addr : functions.keys() )
+    {
+        if( addr < 0 || addr >= (int)m_funcAt.size() ) continue;
+        m_funcAt[addr] = m_funcNames.size();
+        m_funcNames.append( functions.value( addr ) );
+    }
+    reset();
+}
+
+void McuProfiler::jump( uint32_t pc, uint32_t newPC )
+{
+    for( int d=m_depth; d>0; --d )          // Return next to a call instruction
+    {
+        const frame_t& frame = m_frames[d-1];
+        if( frame.isr ) break;              // Only isrExit() leaves an ISR
+        if( newPC-frame.callPC-1 < 4 )
+        {
+            m_node  = m_nodes[frame.node].parent;
+            m_depth = d-1;
+            return;
+        }
+    }
+    if( newPC >= m_funcAt.size() ) return;
+    int func = m_funcAt[newPC];
+    if( func < 0 ) return;
+    if( m_nodes[m_node].key == func ) return; // Jump to start of current function
+
+    push( func, pc, false );
+}
+
+bool McuProfiler::push( int key, uint32_t callPC, bool isr )
+{
+    if( m_depth >= (isr ? MAX_DEPTH : MAX_CALLS) ) return false;
+
+    qint64 id = ((qint64)m_node << 32) | (uint32_t)key;
+    int node = m_children.value( id, -1 );
+    if( node < 0 )
+    {
+        node = m_nodes.size();
+        m_nodes.push_back( { m_node, key, 0 } );
+        m_children[id] = node;
+    }
+    m_frames[m_depth++] = { callPC, node, isr };
+    m_node = node;
+    return true;
+}
+
+void McuProfiler::isrEnter( Interrupt* intr, uint32_t pc )
+{
+    int index = m_isrIndex.value( intr, -1 );
+    if( index < 0 )
+    {
+        index = m_isrs.size();
+        m_isrs.push_back( { intr->name(), 0, 0 } );
+        m_isrIndex[intr] = index;
+    }
+    m_isrs[index].count++;
+    if( m_depth >= MAX_DEPTH ) return;
+
+    m_isrStart[m_depth] = m_mcu->cycle();
+    push( -1-index, pc, true );
+}
+
+void McuProfiler::isrExit()
+{
+    for( int d=m_depth; d>0; --d )
+    {
+        const frame_t& frame = m_frames[d-1];
+        if( !frame.isr ) continue;
+
+        int index = -1-m_nodes[frame.node].key;
+        m_isrs[index].cycles += m_mcu->cycle()-m_isrStart[d-1];
+        m_node  = m_nodes[frame.node].parent;
+        m_depth = d-1;
+        return;
+    }
+}
+
+uint64_t McuProfiler::totalCycles()
+{
+    uint64_t total = 0;
+    for( const node_t& node : m_nodes ) total += node.cycles;
+    return total;
+}
+
+QString McuProfiler::keyName( int key )
+{
+    if( key == ROOT_KEY ) return "firmware";
+    if( key < 0 ) return "ISR:"+m_isrs[-1-key].name;
+    return m_funcNames.at( key );
+}
+
+QString McuProfiler::nodePath( int node )
+{
+    QStringList path;
+    for( ; node >= 0; node = m_nodes[node].parent ) path.prepend( keyName( m_nodes[node].key ) );
+    return path.join(";");
+}
+
+QString McuProfiler::collapsedStacks()
+{
+    QString stacks;
+    for( uint i=0; i<m_nodes.size(); ++i )
+    {
+        if( !m_nodes[i].cycles ) continue;
+        stacks += nodePath( i )+" "+QString::number( m_nodes[i].cycles )+"\n";
+    }
+    return stacks;
+}
+
+bool McuProfiler::saveCollapsed( QString fileName )
+{
+    QFile file( fileName );
+    if( !file.open( QFile::WriteOnly | QFile::Text ) ) return false;
+
+    QTextStream out( &file );
+    out << collapsedStacks();
+    file.close();
+    return true;
+}
+
+QString McuProfiler::report( int top )
+{
+    uint64_t total = totalCycles();
+    if( !total ) return "No cycles profiled\n";
+
+    auto percent = [total]( uint64_t c ){ return QString::number( 100.0*c/total, 'f', 2 ).rightJustified( 7 )+" %"; };
+
+    QString rep = "Total cycles: "+QString::number( total )+"\n";
+
+    QMap<int, uint64_t> selfCycles;  // By function key
+    QMap<int, uint64_t> totCycles;
+    for( uint i=0; i<m_nodes.size(); ++i )
+    {
+        const node_t& node = m_nodes[i];
+        if( !node.cycles ) continue;
+        selfCycles[node.key] += node.cycles;
+
+        QSet<int> keys;              // Recursion: count once
+        for( int n=i; n >= 0; n = m_nodes[n].parent ) keys.insert( m_nodes[n].key );
+        for( int key : keys ) totCycles[key] += node.cycles;
+    }
+    QList<QPair<uint64_t, int>> funcs;
+    for( int key : selfCycles.keys() ) funcs.append( { selfCycles.value( key ), key } );
+    std::sort( funcs.begin(), funcs.end(), []( const QPair<uint64_t, int>& a, const QPair<uint64_t, int>& b ){ return a.first > b.first; } );
+
+    rep += "\nFunction                         Self cycles          Total cycles\n";
+    for( int i=0; i<funcs.size() && i<top; ++i )
+    {
+        int key = funcs.at(i).second;
+        rep += keyName( key ).leftJustified( 24 )
+             + QString::number( selfCycles.value( key ) ).rightJustified( 12 )+percent( selfCycles.value( key ) )
+             + QString::number( totCycles.value( key ) ).rightJustified( 12 )+percent( totCycles.value( key ) )+"\n";
+    }
+    if( m_isrs.size() )
+    {
+        rep += "\nInterrupt                 Count       Cycles\n";
+        for( const isr_t& isr : m_isrs )
+            rep += isr.name.leftJustified( 18 )+QString::number( isr.count ).rightJustified( 12 )
+                 + QString::number( isr.cycles ).rightJustified( 12 )+percent( isr.cycles )+"\n";
+    }
+    std::vector<uint32_t> pcs;
+    for( uint32_t pc=0; pc<m_pcCycles.size(); ++pc ) if( m_pcCycles[pc] ) pcs.push_back( pc );
+    std::sort( pcs.begin(), pcs.end(), [this]( uint32_t a, uint32_t b ){ return m_pcCycles[a] > m_pcCycles[b]; } );
+
+    rep += "\nAddress        Cycles\n";
+    for( uint i=0; i<pcs.size() && (int)i<top; ++i )
+        rep += "0x"+QString::number( pcs[i], 16 ).rightJustified( 6, '0' )
+             + QString::number( m_pcCycles[pcs[i]] ).rightJustified( 12 )+percent( m_pcCycles[pcs[i]] )+"\n";
+
+    return rep;
+}
@@ -0,0 +1,93 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#pragma once
+
+#include <QStringList>
+#include <QHash>
+#include <QMap>
+#include <vector>
+
+class eMcu;
+class Interrupt;
+
+// Counts Cpu cycles per PC and per call stack.
+// Calls are jumps to known function addresses, returns are jumps back
+// next to the call instruction. Interrupts::runInterrupts() reports ISRs.
+
+class McuProfiler
+{
+    public:
+        McuProfiler( eMcu* mcu );
+        ~McuProfiler();
+
+        void reset();
+
+        void setFunctions( QMap<int, QString> functions ); // Start address -> name
+
+        inline void step( uint32_t pc, int cycles, uint32_t newPC ) // Instruction at pc executed
+        {
+            if( pc < m_pcCycles.size() ) m_pcCycles[pc] += cycles;
+            m_nodes[m_node].cycles += cycles;
+
+            if( newPC-pc-1 < 4 ) return; // Next instruction or skip
+            jump( pc, newPC );
+        }
+        void addCycles( uint32_t pc, uint64_t cycles ) // Skipped loop iterations
+        {
+            if( pc < m_pcCycles.size() ) m_pcCycles[pc] += cycles;
+            m_nodes[m_node].cycles += cycles;
+        }
+
+        void isrEnter( Interrupt* intr, uint32_t pc );
+        void isrExit();
+
+        uint64_t totalCycles();
+        const std::vector<uint64_t>& pcCycles() { return m_pcCycles; }
+
+        QString collapsedStacks();   // Flame graph input: "main;func;... cycles" per line
+        bool saveCollapsed( QString fileName );
+
+        QString report( int top=20 );
+
+    private:
+        struct node_t{   // Call tree node
+            int parent;
+            int key;     // Function index or -1-ISR index
+            uint64_t cycles;
+        };
+        struct frame_t{
+            uint32_t callPC;
+            int  node;
+            bool isr;
+        };
+        struct isr_t{
+            QString  name;
+            uint64_t count;
+            uint64_t cycles;
+        };
+
+        void jump( uint32_t pc, uint32_t newPC );
+        bool push( int key, uint32_t callPC, bool isr );
+        QString keyName( int key );
+        QString nodePath( int node );
+
+        eMcu* m_mcu;
+
+        std::vector<uint64_t> m_pcCycles; // Cycles by PC
+        std::vector<int>      m_funcAt;   // Function index by start address, -1 if none
+        QStringList           m_funcNames;
+
+        std::vector<node_t>  m_nodes;
+        QHash<qint64, int>   m_children;  // (parent<<32 | key) -> node
+        int m_node;                       // Current node
+
+        frame_t  m_frames[64];
+        int      m_depth;
+        uint64_t m_isrStart[64];          // Cycle at ISR entry, by depth
+
+        std::vector<isr_t>     m_isrs;
+        QHash<Interrupt*, int> m_isrIndex;
+};
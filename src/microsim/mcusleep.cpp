@@ -7,6 +7,7 @@
 
 #include "mcusleep.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 
 McuSleep::McuSleep( eMcu* mcu, QString name )
        : McuModule( mcu, name )
@@ -26,3 +27,16 @@ void McuSleep::callBack()
     qDebug() << "McuSleep Exit Sleep\n";
     m_mcu->sleep( false );
 }
+
+bool McuSleep::saveState( StateStream* s )
+{
+    s->put( m_enabled );
+    s->put( m_sleepMode );
+    return true;
+}
+
+void McuSleep::loadState( StateStream* s )
+{
+    s->get( m_enabled );
+    s->get( m_sleepMode );
+}
@@ -22,6 +22,9 @@ class McuSleep : public McuModule, public eElement
         //virtual void sleep(){;}
         virtual void callBack() override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         bool m_enabled;
 
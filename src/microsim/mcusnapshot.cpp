@@ -0,0 +1,77 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include "mcusnapshot.h"
+#include "e-element.h"
+#include "simulator.h"
+
+void StateStream::putEvent( eElement* el )
+{
+    uint64_t time = el->eventTime;
+    if( time ) time -= Simulator::self()->circTime()-1; // 0 means no event
+    put( time );
+}
+
+void StateStream::getEvent( eElement* el )
+{
+    uint64_t time;
+    get( time );
+    Simulator::self()->cancelEvents( el );
+    if( time ) Simulator::self()->addEvent( time-1, el );
+}
+
+McuSnapshot::McuSnapshot()
+{
+    cycle      = 0;
+    instCount  = 0;
+    cyclesDone = 0;
+    sleeping   = false;
+    m_ownBytes = 0;
+    for( int i=0; i<memCOUNT; ++i ) m_sizes[i] = 0;
+}
+McuSnapshot::~McuSnapshot(){}
+
+void McuSnapshot::savePages( memory_t mem, const uint8_t* data, uint32_t size, McuSnapshot* base )
+{
+    std::vector<page_t>& pages = m_pages[mem];
+    pages.clear();
+    m_sizes[mem] = size;
+
+    std::vector<page_t>* basePages = nullptr;
+    if( base && base->m_sizes[mem] == size ) basePages = &base->m_pages[mem];
+
+    for( uint32_t start=0, i=0; start<size; start += SNAP_PAGE, ++i )
+    {
+        uint32_t bytes = size-start;
+        if( bytes > SNAP_PAGE ) bytes = SNAP_PAGE;
+
+        if( basePages )                          // Page not changed: share it
+        {
+            const page_t& basePage = basePages->at( i );
+            if( memcmp( basePage->data(), data+start, bytes ) == 0 ) { pages.push_back( basePage ); continue; }
+        }
+        pages.push_back( std::make_shared<const std::vector<uint8_t>>( data+start, data+start+bytes ) );
+        m_ownBytes += bytes;
+    }
+}
+
+uint32_t McuSnapshot::loadPages( memory_t mem, uint8_t* data, uint32_t size, std::vector<uint32_t>* changed )
+{
+    if( size != m_sizes[mem] ) return 0;
+
+    uint32_t copied = 0;
+    const std::vector<page_t>& pages = m_pages[mem];
+
+    for( uint32_t start=0, i=0; start<size; start += SNAP_PAGE, ++i )
+    {
+        const std::vector<uint8_t>& page = *pages[i];
+        if( memcmp( page.data(), data+start, page.size() ) == 0 ) continue; // Only copy changed pages
+
+        memcpy( data+start, page.data(), page.size() );
+        if( changed ) changed->push_back( start );
+        copied++;
+    }
+    return copied;
+}
@@ -0,0 +1,97 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+
+#define SNAP_PAGE 256 // Bytes per memory page
+
+class eElement;
+
+// Raw copy of Cpu, Interrupts and Modules variables.
+// Each one must get() exactly what it put(), in the same order.
+
+class StateStream
+{
+    public:
+        StateStream() { m_pos = 0; }
+
+        template <class T> void put( const T& v )
+        {
+            const uint8_t* p = (const uint8_t*)&v;
+            m_data.insert( m_data.end(), p, p+sizeof(T) );
+        }
+        template <class T> void get( T& v )
+        {
+            memcpy( &v, m_data.data()+m_pos, sizeof(T) );
+            m_pos += sizeof(T);
+        }
+        template <class T> void putVector( const std::vector<T>& v )
+        {
+            put( (uint32_t)v.size() );
+            const uint8_t* p = (const uint8_t*)v.data();
+            m_data.insert( m_data.end(), p, p+v.size()*sizeof(T) );
+        }
+        template <class T> void getVector( std::vector<T>& v )
+        {
+            uint32_t size;
+            get( size );
+            v.resize( size );
+            memcpy( v.data(), m_data.data()+m_pos, size*sizeof(T) );
+            m_pos += size*sizeof(T);
+        }
+
+        void putEvent( eElement* el ); // Time left to pending event
+        void getEvent( eElement* el ); // Simulation time is not restored
+
+        void rewind() { m_pos = 0; }
+        uint32_t size() { return m_data.size(); }
+
+    private:
+        std::vector<uint8_t> m_data;
+        uint32_t m_pos;
+};
+
+// Mcu state at some point: memories are kept in pages,
+// pages equal to the base snapshot are shared, not copied.
+
+class McuSnapshot
+{
+    public:
+        McuSnapshot();
+        ~McuSnapshot();
+
+        enum memory_t{
+            memDATA=0,
+            memPROG,
+            memROM,
+            memCOUNT
+        };
+
+        typedef std::shared_ptr<const std::vector<uint8_t>> page_t;
+
+        void savePages( memory_t mem, const uint8_t* data, uint32_t size, McuSnapshot* base );
+        uint32_t loadPages( memory_t mem, uint8_t* data, uint32_t size, std::vector<uint32_t>* changed=nullptr ); // Returns number of pages copied
+
+        StateStream* state() { return &m_state; }
+
+        uint32_t ownBytes() { return m_ownBytes; } // Bytes not shared with base snapshot
+
+        uint64_t cycle;
+        uint64_t instCount;
+        int      cyclesDone;
+        bool     sleeping;
+
+    private:
+        std::vector<page_t> m_pages[memCOUNT];
+        uint32_t m_sizes[memCOUNT];
+        uint32_t m_ownBytes;
+
+        StateStream m_state;
+};
@@ -6,6 +6,7 @@
 #include "mcuspi.h"
 #include "iopin.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 
 McuSpi::McuSpi( eMcu* mcu, QString name )
       : McuPrescaled( mcu, name )
@@ -25,6 +26,68 @@ void McuSpi::initialize()
     if( m_statReg ) *m_statReg = 0;
 }
 
+bool McuSpi::saveState( StateStream* s )
+{
+    auto pinIndex = [this]( IoPin* p ){ return (uint8_t)( (p == m_MOSI) ? 1 : (p == m_MISO) ? 2 : 0 ); };
+
+    s->putEvent( this ); // Next Clock edge in Master mode
+    s->put( m_mode );
+    s->put( pinIndex( m_dataOutPin ) );
+    s->put( pinIndex( m_dataInPin ) );
+    s->put( m_clock );
+    s->put( m_clkState );
+    s->put( m_clockPeriod );
+    s->put( m_lsbFirst );
+    s->put( m_toggleSck );
+    s->put( m_enabled );
+    s->put( m_useSS );
+    s->put( m_sampleEdge );
+    s->put( m_leadEdge );
+    s->put( m_tailEdge );
+    s->put( m_outBit );
+    s->put( m_inBit );
+    s->put( m_bitCount );
+    s->put( m_srReg );
+    s->put( m_txReg );
+    s->put( m_prIndex );
+    s->put( m_prescaler );
+    return true;
+}
+
+void McuSpi::loadState( StateStream* s ) // Pin control is restored by Ports
+{
+    auto indexPin = [this]( uint8_t i ){ return (i == 1) ? m_MOSI : (i == 2) ? m_MISO : nullptr; };
+    uint8_t outPin, inPin;
+
+    s->getEvent( this );
+    s->get( m_mode );
+    s->get( outPin ); m_dataOutPin = indexPin( outPin );
+    s->get( inPin );  m_dataInPin  = indexPin( inPin );
+    s->get( m_clock );
+    s->get( m_clkState );
+    s->get( m_clockPeriod );
+    s->get( m_lsbFirst );
+    s->get( m_toggleSck );
+    s->get( m_enabled );
+    s->get( m_useSS );
+    s->get( m_sampleEdge );
+    s->get( m_leadEdge );
+    s->get( m_tailEdge );
+    s->get( m_outBit );
+    s->get( m_inBit );
+    s->get( m_bitCount );
+    s->get( m_srReg );
+    s->get( m_txReg );
+    s->get( m_prIndex );
+    s->get( m_prescaler );
+
+    bool slave = (m_mode == SPI_SLAVE);         // Pin change callbacks as set by setMode()
+    if( m_MOSI )   m_MOSI->changeCallBack( this, false );
+    if( m_MISO )   m_MISO->changeCallBack( this, false );
+    if( m_clkPin ) m_clkPin->changeCallBack( this, slave && m_enabled );
+    if( m_SS )     m_SS->changeCallBack( this, slave && m_useSS );
+}
+
 /*void McuSpi::setMode( spiMode_t mode )
 {
     SpiModule::setMode(  mode );
@@ -25,6 +25,9 @@ class McuSpi : public McuPrescaled, public SpiModule
         virtual void writeStatus( uint8_t val ){;}
         virtual void writeSpiReg( uint8_t val ){;}
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         uint8_t* m_dataReg;
         uint8_t* m_statReg;
@@ -9,6 +9,7 @@
 #include "mcuocunit.h"
 #include "mcuicunit.h"
 #include "mcuinterrupts.h"
+#include "mcusnapshot.h"
 #include "simulator.h"
 
 McuTimer::McuTimer( eMcu* mcu, QString name )
@@ -85,6 +86,61 @@ void McuTimer::sleep( int mode )
     }
 }
 
+bool McuTimer::saveState( StateStream* s )
+{
+    if( m_running ) calcCounter(); // Counter and tick offset at this time
+
+    s->put( m_running );
+    s->put( m_bidirec );
+    s->put( m_reverse );
+    s->put( m_extClock );
+    s->put( m_countVal );
+    s->put( m_countStart );
+    s->put( m_ovfMatch );
+    s->put( m_ovfPeriod );
+    s->put( m_timeOffset );
+    s->put( m_mode );
+    s->put( m_prescaler );
+    s->put( m_prIndex );
+    s->put( m_psPerTick );
+    s->put( m_clkEdge );
+    s->put( m_clkState );
+
+    for( McuOcUnit* ocUnit : m_ocUnit ) ocUnit->saveState( s );
+    if( m_ICunit ) m_ICunit->saveState( s );
+    return true;
+}
+
+void McuTimer::loadState( StateStream* s )
+{
+    s->get( m_running );
+    s->get( m_bidirec );
+    s->get( m_reverse );
+    s->get( m_extClock );
+    s->get( m_countVal );
+    s->get( m_countStart );
+    s->get( m_ovfMatch );
+    s->get( m_ovfPeriod );
+    s->get( m_timeOffset );
+    s->get( m_mode );
+    s->get( m_prescaler );
+    s->get( m_prIndex );
+    s->get( m_psPerTick );
+    s->get( m_clkEdge );
+    s->get( m_clkState );
+
+    for( McuOcUnit* ocUnit : m_ocUnit ) ocUnit->loadState( s );
+    if( m_ICunit ) m_ICunit->loadState( s );
+
+    if( m_clockPin ) m_clockPin->changeCallBack( this, m_extClock );
+
+    m_circTime = Simulator::self()->circTime();
+    m_ovfTime  = 0;               // Force reshedule from restored counter
+    Simulator::self()->cancelEvents( this );
+    for( McuOcUnit* ocUnit : m_ocUnit ) Simulator::self()->cancelEvents( ocUnit );
+    if( m_running && !m_sleeping ) sheduleEvents();
+}
+
 void McuTimer::clockStep()  // Timer driven by external clock
 {
     m_countVal++;
@@ -32,6 +32,9 @@ class McuTimer : public McuPrescaled, public eElement
 
         void sleep( int mode ) override;
 
+        bool saveState( StateStream* s ) override;
+        void loadState( StateStream* s ) override;
+
         virtual void resetTimer();
 
         virtual void enable( uint8_t en );
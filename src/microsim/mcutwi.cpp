@@ -5,6 +5,8 @@
 
 #include "mcutwi.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
+#include "iopin.h"
 
 McuTwi::McuTwi( eMcu* mcu, QString name )
       : McuPrescaled( mcu, name )
@@ -27,3 +29,71 @@ void McuTwi::initialize()
     updateFreq();
 }
 
+bool McuTwi::saveState( StateStream* s )
+{
+    s->putEvent( this ); // Next Clock edge in Master mode
+    s->put( m_clock );
+    s->put( m_clkState );
+    s->put( m_cCode );
+    s->put( m_address );
+    s->put( m_addrBits );
+    s->put( m_freq );
+    s->put( m_clockPeriod );
+    s->put( m_lastSDA );
+    s->put( m_sdaState );
+    s->put( m_toggleScl );
+    s->put( m_isAddr );
+    s->put( m_write );
+    s->put( m_sendACK );
+    s->put( m_masterACK );
+    s->put( m_addrMatch );
+    s->put( m_genCall );
+    s->put( m_enabled );
+    s->put( m_bitPtr );
+    s->put( m_txReg );
+    s->put( m_rxReg );
+    s->put( m_mode );
+    s->put( m_twiState );
+    s->put( m_nextState );
+    s->put( m_i2cState );
+    s->put( m_lastState );
+    s->put( m_prIndex );
+    s->put( m_prescaler );
+    return true;
+}
+
+void McuTwi::loadState( StateStream* s ) // Pin control is restored by Ports
+{
+    s->getEvent( this );
+    s->get( m_clock );
+    s->get( m_clkState );
+    s->get( m_cCode );
+    s->get( m_address );
+    s->get( m_addrBits );
+    s->get( m_freq );
+    s->get( m_clockPeriod );
+    s->get( m_lastSDA );
+    s->get( m_sdaState );
+    s->get( m_toggleScl );
+    s->get( m_isAddr );
+    s->get( m_write );
+    s->get( m_sendACK );
+    s->get( m_masterACK );
+    s->get( m_addrMatch );
+    s->get( m_genCall );
+    s->get( m_enabled );
+    s->get( m_bitPtr );
+    s->get( m_txReg );
+    s->get( m_rxReg );
+    s->get( m_mode );
+    s->get( m_twiState );
+    s->get( m_nextState );
+    s->get( m_i2cState );
+    s->get( m_lastState );
+    s->get( m_prIndex );
+    s->get( m_prescaler );
+
+    bool slave = (m_mode == TWI_SLAVE);  // Pin change callbacks as set by setMode()
+    if( m_scl ) m_scl->changeCallBack( this, slave );
+    if( m_sda ) m_sda->changeCallBack( this, slave );
+}
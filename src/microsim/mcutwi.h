@@ -26,6 +26,9 @@ class McuTwi : public McuPrescaled, public TwiModule
         virtual void writeTwiReg( uint8_t val ){;}
         virtual void readTwiReg( uint8_t val ){;}
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         virtual void updateFreq() {;}
 
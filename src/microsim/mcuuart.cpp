@@ -8,6 +8,7 @@
 #include "usartrx.h"
 #include "usarttx.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcuinterrupts.h"
 #include "datautils.h"
 
@@ -44,3 +45,43 @@ void McuUsart::setBit9Rx( uint8_t bit )
 {
     writeRegBits( m_bit9Rx, bit );
 }
+
+bool McuUsart::saveState( StateStream* s )
+{
+    s->put( m_speedx2 );
+    s->put( m_synchronous );
+    s->put( m_baudRate );
+    s->put( m_mode );
+    s->put( m_stopBits );
+    s->put( m_parity );
+    s->put( (uint8_t)dataBits() );
+    s->put( m_uartSync != nullptr );
+
+    m_sender->saveState( s );
+    m_receiver->saveState( s );
+    if( m_uartSync ) m_uartSync->saveState( s );
+    return true;
+}
+
+void McuUsart::loadState( StateStream* s )
+{
+    bool synchronous, hasSync;
+    uint8_t dataBits;
+    s->get( m_speedx2 );
+    s->get( synchronous );
+    s->get( m_baudRate );
+    s->get( m_mode );
+    s->get( m_stopBits );
+    s->get( m_parity );
+    s->get( dataBits ); setDataBits( dataBits );
+    s->get( hasSync );
+
+    m_sender->loadState( s );
+    m_receiver->loadState( s );
+    if( hasSync )
+    {
+        if( !m_uartSync ) setSynchronous( true ); // Created at first use
+        m_uartSync->loadState( s );
+    }
+    m_synchronous = synchronous;
+}
@@ -24,6 +24,9 @@ class McuUsart : public McuModule, public UsartModule
         virtual uint8_t getBit9Tx() override;
         virtual void setBit9Rx( uint8_t bit ) override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         int m_number;
 
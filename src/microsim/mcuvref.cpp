@@ -5,6 +5,7 @@
 
 #include "mcuvref.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 
 McuVref::McuVref( eMcu* mcu, QString name )
        : McuModule( mcu, name )
@@ -33,3 +34,18 @@ void McuVref::addCallBack( McuModule* mod, bool call ) // Add Modules to be call
     { if( !m_callBacks.contains( mod ) ) m_callBacks.append( mod ); }
     else m_callBacks.removeAll( mod );
 }
+
+bool McuVref::saveState( StateStream* s )
+{
+    s->put( m_enabled );
+    s->put( m_mode );
+    s->put( m_vref );
+    return true;
+}
+
+void McuVref::loadState( StateStream* s )
+{
+    s->get( m_enabled );
+    s->get( m_mode );
+    s->get( m_vref );
+}
@@ -26,6 +26,9 @@ class McuVref : public McuModule, public eElement
 
         void addCallBack( McuModule* mod, bool call );
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         //virtual void setMode( uint8_t mode );
 
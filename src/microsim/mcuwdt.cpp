@@ -5,6 +5,7 @@
 
 #include "mcuwdt.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 //#include "cpu8bits.h"
 #include "mcuinterrupts.h"
 #include "simulator.h"
@@ -16,3 +17,28 @@ McuWdt::McuWdt( eMcu* mcu, QString name )
     m_wdtFuse  = false;
 }
 McuWdt::~McuWdt(){}
+
+bool McuWdt::saveState( StateStream* s )
+{
+    s->putEvent( this ); // Next overflow
+    s->put( m_wdtFuse );
+    s->put( m_ovfInter );
+    s->put( m_ovfReset );
+    s->put( m_ovfPeriod );
+    s->put( m_clkPeriod );
+    s->put( m_prIndex );
+    s->put( m_prescaler );
+    return true;
+}
+
+void McuWdt::loadState( StateStream* s )
+{
+    s->getEvent( this );
+    s->get( m_wdtFuse );
+    s->get( m_ovfInter );
+    s->get( m_ovfReset );
+    s->get( m_ovfPeriod );
+    s->get( m_clkPeriod );
+    s->get( m_prIndex );
+    s->get( m_prescaler );
+}
@@ -21,6 +21,9 @@ class McuWdt : public McuPrescaled, public eElement
         bool enabled() { return m_wdtFuse; }
         void enable( bool en ) { m_wdtFuse = en; }
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
 
         bool m_wdtFuse;
@@ -9,6 +9,7 @@
 #include "usarttx.h"
 #include "usartrx.h"
 #include "e_mcu.h"
+#include "mcusnapshot.h"
 #include "mcuinterrupts.h"
 
 #include "serialmon.h"
@@ -128,6 +129,28 @@ void UartSync::sendSyncData( uint8_t data )
     runEvent();
 }
 
+void UartSync::saveState( StateStream* s )
+{
+    s->putEvent( this );
+    s->put( m_currentBit );
+    s->put( m_clkState );
+    s->put( m_syncData );
+    s->put( m_frame );
+    s->put( m_syncPeriod );
+    s->put( m_syncClkOffset );
+}
+
+void UartSync::loadState( StateStream* s )
+{
+    s->getEvent( this );
+    s->get( m_currentBit );
+    s->get( m_clkState );
+    s->get( m_syncData );
+    s->get( m_frame );
+    s->get( m_syncPeriod );
+    s->get( m_syncClkOffset );
+}
+
 //---------------------------------------
 //---------------------------------------
 
@@ -179,3 +202,36 @@ void UartTR::setPins( QList<IoPin*> pinList )
     m_pinList = pinList;
     m_ioPin = pinList.at(0);
 }
+
+bool UartTR::saveState( StateStream* s )
+{
+    s->putEvent( this ); // Next bit
+    s->put( (int16_t)m_pinList.indexOf( m_ioPin ) );
+    s->put( m_buffer );
+    s->put( m_data );
+    s->put( m_frame );
+    s->put( m_framesize );
+    s->put( m_currentBit );
+    s->put( m_bit9 );
+    s->put( m_state );
+    s->put( m_enabled );
+    s->put( m_period );
+    return true;
+}
+
+void UartTR::loadState( StateStream* s )
+{
+    int16_t pinNum;
+    s->getEvent( this );
+    s->get( pinNum );
+    if( pinNum >= 0 ) m_ioPin = m_pinList.at( pinNum );
+    s->get( m_buffer );
+    s->get( m_data );
+    s->get( m_frame );
+    s->get( m_framesize );
+    s->get( m_currentBit );
+    s->get( m_bit9 );
+    s->get( m_state );
+    s->get( m_enabled );
+    s->get( m_period );
+}
@@ -29,6 +29,7 @@ enum rxError_t{
 };
 
 class IoPin;
+class StateStream;
 class UartTx;
 class UartRx;
 class UartSync;
@@ -100,6 +101,9 @@ class UartSync : public eElement
         void sendSyncData( uint8_t data );
         void setPeriod( uint64_t p ) { m_syncPeriod = p; }
 
+        void saveState( StateStream* s );
+        void loadState( StateStream* s );
+
     private:
         int m_currentBit;
         bool m_clkState;
@@ -154,6 +158,9 @@ class UartTR : public McuModule, public eElement
 
         void raiseInt( uint8_t data=0 );
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
     protected:
         UsartModule* m_usart;
         IoPin* m_ioPin;
@@ -8,6 +8,7 @@
 #include "iopin.h"
 #include "simulator.h"
 #include "connector.h"
+#include "mcusnapshot.h"
 
 UartRx::UartRx( UsartModule* usart, eMcu* mcu, QString name )
       : UartTR( usart, mcu, name )
@@ -140,3 +141,24 @@ void UartRx::setRxFlags()
     if( m_interrupt ) m_interrupt->raise();
 }
 
+bool UartRx::saveState( StateStream* s )
+{
+    s->put( m_startHigh );
+    s->put( m_ignoreData );
+    s->put( m_fifo );
+    s->put( m_fifoP );
+    s->put( m_fifoSize );
+    return UartTR::saveState( s );
+}
+
+void UartRx::loadState( StateStream* s )
+{
+    s->get( m_startHigh );
+    s->get( m_ignoreData );
+    s->get( m_fifo );
+    s->get( m_fifoP );
+    s->get( m_fifoSize );
+    UartTR::loadState( s );
+
+    if( m_ioPin ) m_ioPin->changeCallBack( this, m_enabled && m_state != usartRECEIVE ); // Waiting for start bit
+}
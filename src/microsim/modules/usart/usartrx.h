@@ -20,6 +20,9 @@ class UartRx : public UartTR
         virtual void runEvent() override;
         virtual uint8_t getData() override;
 
+        virtual bool saveState( StateStream* s ) override;
+        virtual void loadState( StateStream* s ) override;
+
         void ignoreData( bool i ) {m_ignoreData = i; }
         void setFifoSize( uint8_t s ) { m_fifoSize = s; }
 
@@ -4,34 +4,76 @@
  ***( see copyright.txt file at root folder )*******************************/
 
 #include <iostream>
+#include <algorithm>
+#include <cstdint>
 #include <QtMath>
+#include <QHash>
+#include <QThread>
 //#include <iomanip> // setw()
 
 #include "circmatrix.h"
+#include "lukernel.h"
 #include "simulator.h"
 
+#ifdef DEBUG_MATRIX
+#include <QElapsedTimer>
+#include <QDebug>
+#endif
+
+class MatrixWorker : public QThread
+{
+    public:
+        MatrixWorker( CircMatrix* matrix ) { m_matrix = matrix; }
+
+    protected:
+        void run() override { m_matrix->workerLoop(); }
+
+    private:
+        CircMatrix* m_matrix;
+};
+
 CircMatrix* CircMatrix::m_pSelf = nullptr;
 
 CircMatrix::CircMatrix()
 {
     m_pSelf = this;
     m_numEnodes = 0;
+    m_solver = Solver_Auto;
+    m_threads   = 0;
+    m_threadMin = 64;
+    m_poolGen  = 0;
+    m_numJobs  = 0;
+    m_poolExit = false;
+    m_nextJob  = 0;
+    m_jobsDone = 0;
+
+    LuKernel::init();
+
+#ifdef DEBUG_MATRIX
+    m_solves  = 0;
+    m_factors = 0;
+    m_partFactors = 0;
+    m_solveTime = 0;
+#endif
+}
+CircMatrix::~CircMatrix()
+{
+    stopWorkers();
+    clearSparse();
 }
-CircMatrix::~CircMatrix(){}
 
 void CircMatrix::createMatrix( QList<eNode*> &eNodeList )
 {
     m_eNodeList = &eNodeList;
     m_numEnodes = eNodeList.size();
 
-    m_circMatrix.clear();
-    m_coefVect.clear();
-
-    m_circMatrix.resize( m_numEnodes , d_vector_t( m_numEnodes , 0 ) );
-    m_coefVect.resize( m_numEnodes , 0 );
-
     /// qDebug() <<"\n  Initializing Matrix: "<< m_numEnodes << " eNodes";
     analyze();
+
+    if( (int)m_workers.size() != m_threads ){
+        stopWorkers();
+        startWorkers();
+    }
 }
 
 void CircMatrix::addConnections( int enodNum, QList<int>* nodeGroup, QList<int>* allNodes )
@@ -56,11 +98,10 @@ void CircMatrix::analyze()
     QList<int> allNodes;
     for( int i=0; i<m_numEnodes; i++ ) allNodes.append( i );
 
-    m_aList.clear();
-    m_aFaList.clear();
-    m_bList.clear();
-    m_eNodeActList.clear();
-    int group = 0;
+    QList<QList<int>> nodeGroups;
+    clearSparse();
+    m_localIdx.assign( m_numEnodes, 0 );
+    m_factorIdx.assign( m_numEnodes, 0 );
     int singleNode = 0;
 
     while( !allNodes.isEmpty() ) // Get a list of groups of nodes interconnected
@@ -68,162 +109,246 @@ void CircMatrix::analyze()
         QList<int> nodeGroup;
         addConnections( allNodes.first(), &nodeGroup, &allNodes ); // Get a group of nodes interconnected
 
-        int numEnodes = nodeGroup.size();
-        if( numEnodes==1 )           // Sigle nodes do by themselves
+        if( nodeGroup.size()==1 )           // Sigle nodes do by themselves
         {
             eNode* enod = m_eNodeList->at( nodeGroup[0] );
             enod->setSingle( true );
             singleNode++;
         }else{
-            dp_matrix_t a;
-            d_matrix_t ap;
-            dp_vector_t b;
-            QList<eNode*> eNodeActive;
-
-            a.resize( numEnodes, dp_vector_t( numEnodes, 0 ) );
-            ap.resize( numEnodes, d_vector_t( numEnodes, 0 ) );
-            b.resize( numEnodes, 0 );
-
-            int ny=0;
-            for( int y=0; y<m_numEnodes; ++y )    // Copy data to reduced Matrix
-            {
-                if( !nodeGroup.contains( y ) ) continue;
-                int nx=0;
-                for( int x=0; x<m_numEnodes; ++x )
-                {
-                    if( !nodeGroup.contains( x ) ) continue;
-                    a[nx][ny] = &(m_circMatrix[x][y]);
-                    nx++;
-                }
-                b[ny] = &(m_coefVect[y]);
-                eNode* node = m_eNodeList->at(y);
-                node->setNodeGroup( group );
-                eNodeActive.append( node );
-                ny++;
-            }
-            m_aList.append( a );
-            m_aFaList.append( ap );
-            m_bList.append( b );
-            m_eNodeActList.append( eNodeActive );
-            group++;
+            std::sort( nodeGroup.begin(), nodeGroup.end() ); // Keep eNode number order in reduced Matrix
+            nodeGroups.append( nodeGroup );
         }
     }
-    m_admitChanged.clear();
-    m_currChanged.clear();
-    m_admitChanged.resize( group, true );
-    m_currChanged.resize(  group, true );
+    int groups = nodeGroups.size();
+    m_groups.resize( groups ); // Storage pointers point inside each group_t: don't resize after this
 
-    /// qDebug() <<"CircMatrix::solveMatrix"<<group<<"Circuits";
+    for( int group=0; group<groups; ++group )
+    {
+        QList<int>& nodeGroup = nodeGroups[group];
+        group_t& g = m_groups[group];
+        int n = nodeGroup.size();
+
+        g.n = n;
+        g.stride = (n+7) & ~7;          // 8 doubles = 64 bytes
+        g.sparse = nullptr;
+        if( m_solver != Solver_Dense ) g.sparse = createSparse( nodeGroup );
+
+        size_t aSize = g.sparse ? 0 : g.stride*n;
+        g.data.assign( 2*aSize + 2*g.stride + 8, 0 );
+
+        uintptr_t p = (uintptr_t)g.data.data();
+        double* data = (double*)((p+63) & ~(uintptr_t)63); // Align to cache line
+        g.a  = data;
+        g.lu = data + aSize;
+        g.b  = data + 2*aSize;
+        g.x  = data + 2*aSize + g.stride;
+
+        g.eNodes.clear();
+        for( int i=0; i<n; ++i )
+        {
+            int y = nodeGroup[i];
+            m_localIdx[y]  = i;
+            m_factorIdx[y] = g.sparse ? g.sparse->factorIndex( i ) : i;
+            eNode* node = m_eNodeList->at( y );
+            node->setNodeGroup( group );
+            g.eNodes.push_back( node );
+        }
+        g.firstChanged = 0;
+        g.admitChanged = true;
+        g.currChanged  = true;
+        g.solveOk = true;
+    }
+    m_jobs.clear();
+    m_jobs.reserve( groups );
+
+    /// qDebug() <<"CircMatrix::solveMatrix"<<groups<<"Circuits";
     /// qDebug() <<"CircMatrix::solveMatrix"<<singleNode<<"Single Nodes\n";
 }
 
-bool CircMatrix::solveMatrix()
+SparseLU* CircMatrix::createSparse( QList<int> &nodeGroup )
 {
-    bool ok = true;
-    for( int i=0; i<m_bList.size(); ++i )
-    {
-        if( !m_admitChanged[i] && !m_currChanged[i] ) continue;
+    int n = nodeGroup.size();
+    bool autoSolver = (m_solver == Solver_Auto);
+    if( autoSolver && n < 8 ) return nullptr; // Small: dense kernel is faster
 
-        m_eNodeActive = &(m_eNodeActList[i]);
-        int n = m_eNodeActive->size();
+    QHash<int, int> local;                  // eNode number to reduced Matrix index
+    for( int i=0; i<n; ++i ) local[ nodeGroup[i] ] = i;
 
-        if( m_admitChanged[i] ) factorMatrix( n, i );
-        if( !luSolve( n, i ) ) ok = false;
-
-        m_currChanged[i]  = false;
-        m_admitChanged[i] = false;
+    std::vector<std::vector<int>> pattern( n );
+    int nonZeros = 0;
+    for( int row=0; row<n; ++row )
+    {
+        pattern[row].push_back( row );
+        for( int nodeNum : m_eNodeList->at( nodeGroup[row] )->getConnections() )
+        {
+            int col = local.value( nodeNum, -1 );
+            if( col >= 0 && col != row ) pattern[row].push_back( col );
+        }
+        nonZeros += pattern[row].size();
     }
-    return ok;
+    if( autoSolver )   // Too dense: fill-in would make it full, skip analyze
+    {
+        double density = (double)nonZeros/((double)n*n);
+        if( density*qSqrt( n ) > 2 ) return nullptr; // Fill-in grows with density and size: sparse never wins above 2
+    }
+
+    SparseLU* sparse = new SparseLU();
+    sparse->analyze( n, pattern );
+
+    if( autoSolver )                        // Use dense solver if too much fill-in
+    {
+        double denseOps = (double)n*n*n/3;
+        if( 4*sparse->factorOps() > denseOps ){ // Dense kernel is SIMD: sparse needs 4x less flops
+            delete sparse;
+            return nullptr;
+    }   }
+    return sparse;
 }
 
-void CircMatrix::factorMatrix( int n, int group ) // Factor matrix into Lower/Upper triangular
+void CircMatrix::clearSparse()
 {
-    dp_matrix_t& ap = m_aList[group];
-    d_matrix_t&   a = m_aFaList[group];
+    for( group_t& g : m_groups ) delete g.sparse;
+    m_groups.clear();
+}
 
-    /*std::cout << "\nAdmitance Matrix:\n"<< std::endl;
-    for( int i=0; i<n; i++ )
+bool CircMatrix::solveMatrix()
+{
+#ifdef DEBUG_MATRIX
+    QElapsedTimer timer;
+    timer.start();
+#endif
+    int groups = m_groups.size();
+
+    m_jobs.clear();
+    for( int i=0; i<groups; ++i )
     {
-        for( int j=0; j<n; ++j ) { std::cout << std::setw(15); std::cout << *ap[i][j]; }
-        std::cout << std::endl;
-    }*/
+        const group_t& g = m_groups[i];
+        if( !g.admitChanged && !g.currChanged ) continue;
 
-    int row,col,k;
+        if( m_workers.size() && g.n >= m_threadMin ) m_jobs.push_back( i );
+        else solveGroup( i );
+    }
+    if( !m_jobs.empty() )          // Solve big groups in parallel
+    {
+        int numJobs = m_jobs.size();
+        m_poolMutex.lock();
+        m_poolGen++;
+        m_numJobs  = numJobs;
+        m_jobsDone = 0;
+        m_nextJob  = m_poolGen<<32;
+        m_poolCond.wakeAll();
+        m_poolMutex.unlock();
+
+        runJobs( m_poolGen, numJobs );          // This thread also solves groups
+        while( m_jobsDone < numJobs ) QThread::yieldCurrentThread();
+    }
 
-    for( col=0; col<n; ++col )              // Crout's method: loop through columns
+    bool ok = true;
+    for( group_t& g : m_groups ) // Set Node Voltages always in the same order
     {
-        for( row=0; row<col; ++row )        // Upper triangular elements
-        {
-            double q = *(ap[row][col]);
-            for( k=0; k<row; ++k ) q -= a[row][k]*a[k][col];
-            a[row][col] = q;
-        }
-        for( row=col; row<n; ++row )        // Lower triangular elements
-        {
-            double q = *(ap[row][col]);
-            for( k=0; k<col; ++k ) q -= a[row][k]*a[k][col];
-            a[row][col] = q;
-        }
-        if( col != n-1 )                    // Normalize column respect to diagonal
-        {
-            double div = a[col][col];
-            if( div == 0 ) continue;
-            for( row=col+1; row<n; ++row ) a[row][col] /= div;
+        if( !g.admitChanged && !g.currChanged ) continue;
+
+        const double* x = g.x;
+        eNode* const* nodes = g.eNodes.data();
+
+        for( int j=g.n-1; j>=0; --j ) nodes[j]->setVolt( x[j] );
+
+        if( !g.solveOk ) ok = false;
+#ifdef DEBUG_MATRIX
+        if( g.admitChanged ){
+            m_factors++;
+            if( g.firstChanged > 0 ) m_partFactors++;
         }
+        m_solves++;
+#endif
+        g.currChanged  = false;
+        g.admitChanged = false;
+        g.firstChanged = g.n;
     }
-    /*std::cout << "\nFactored Matrix:\n" << std::endl;
-    for( int i=0; i<n; i++ )
+#ifdef DEBUG_MATRIX
+    m_solveTime += timer.nsecsElapsed();
+    if( m_solves >= 100000 )
     {
-        for( int j=0; j<n; j++ ) { std::cout << std::setw(15); std::cout << a[i][j]; }
-        std::cout << std::endl;
-    }*/
+        qDebug() << "CircMatrix::solveMatrix solver" << m_solver << "factors" << m_factors
+                 << "partial" << m_partFactors << "solves" << m_solves << "ns/solve" << m_solveTime/m_solves;
+        m_solves  = 0;
+        m_factors = 0;
+        m_partFactors = 0;
+        m_solveTime = 0;
+    }
+#endif
+    return ok;
 }
 
-bool CircMatrix::luSolve( int n, int group ) // Solves the system to get voltages for each node
+void CircMatrix::solveGroup( int group ) // Can run in worker threads: don't touch anything outside this group
 {
-    const d_matrix_t&  a  = m_aFaList[group];
-    const dp_vector_t& bp = m_bList[group];
+    group_t& g = m_groups[group];
 
-    /*std::cout << "\nCurrent vector:\n" << std::endl;
-    for( int i=0; i<n; i++ )
+    if( g.sparse )
     {
-        std::cout << std::setw(15); std::cout << *bp[i];
-        std::cout << std::endl;
-    }*/
-
-    d_vector_t b;
-    b.resize( n , 0 );
+        if( g.admitChanged ) g.sparse->factor( g.firstChanged );
+        g.solveOk = g.sparse->solve( g.b, g.x );
+    }else{
+        if( g.admitChanged ) LuKernel::factor( g.a, g.lu, g.n, g.stride, g.firstChanged );
+        g.solveOk = LuKernel::solve( g.lu, g.n, g.stride, g.b, g.x );
+    }
+}
 
-    double tot;
-    int i;
-    for( i=0; i<n; ++i )
+void CircMatrix::runJobs( uint64_t gen, int numJobs )
+{
+    while( true )
     {
-        tot = *(bp[i]);
-        b[i] = tot;
-        if( tot != 0 ) break; // First nonzero b element
+        uint64_t next = m_nextJob;
+        if( (next>>32) != gen ) break;    // Jobs from another solveMatrix() call
+        int job = next & 0xFFFFFFFF;
+        if( job >= numJobs ) break;
+        if( !m_nextJob.compare_exchange_weak( next, next+1 ) ) continue;
+
+        solveGroup( m_jobs[job] );
+        m_jobsDone++;
     }
+}
 
-    int bi = i++;
-    for( ; i<n; ++i )
+void CircMatrix::workerLoop()
+{
+    uint64_t gen = 0;
+    while( true )
     {
-        tot = *(bp[i]);
-        for( int j=bi; j<i; ++j ) tot -= a[i][j]*b[j]; // Forward substitution from lower triangular matrix
-        b[i] = tot;
+        m_poolMutex.lock();
+        while( m_poolGen == gen && !m_poolExit ) m_poolCond.wait( &m_poolMutex );
+        gen = m_poolGen;
+        int numJobs = m_numJobs;
+        bool exit = m_poolExit;
+        m_poolMutex.unlock();
+
+        if( exit ) return;
+        runJobs( gen, numJobs );
     }
-    bool isOk = true;
+}
 
-    for( i=n-1; i>=0; --i )
+void CircMatrix::startWorkers()
+{
+    m_poolExit = false;
+    for( int i=0; i<m_threads; ++i )
     {
-        tot = b[i];
-        for( int j=i+1; j<n; ++j ) tot -= a[i][j]*b[j]; // Back substitution from upper triangular matrix
+        MatrixWorker* worker = new MatrixWorker( this );
+        m_workers.push_back( worker );
+        worker->start();
+    }
+}
+
+void CircMatrix::stopWorkers()
+{
+    if( m_workers.empty() ) return;
 
-        double div = a[i][i];
-        double volt = 0;
-        if( div != 0 ) volt = tot/div;
-        else isOk = false;
+    m_poolMutex.lock();
+    m_poolExit = true;
+    m_poolCond.wakeAll();
+    m_poolMutex.unlock();
 
-        b[i] = volt;
-        m_eNodeActive->at(i)->setVolt( volt );         // Set Node Voltages
+    for( MatrixWorker* worker : m_workers ){
+        worker->wait();
+        delete worker;
     }
-    return isOk;
+    m_workers.clear();
 }
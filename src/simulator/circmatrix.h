@@ -6,16 +6,46 @@
 #pragma once
 
 #include <vector>
+#include <atomic>
 #include <QList>
+#include <QMutex>
+#include <QWaitCondition>
 
 #include "e-node.h"
+#include "sparselu.h"
+
+//#define DEBUG_MATRIX
+
+enum solver_t{
+    Solver_Auto=0,
+    Solver_Dense,
+    Solver_Sparse,
+};
+
+class MatrixWorker;
 
 class CircMatrix
 {
-    typedef std::vector<double>      d_vector_t;
-    typedef std::vector<double*>     dp_vector_t;
-    typedef std::vector<d_vector_t>  d_matrix_t;
-    typedef std::vector<dp_vector_t> dp_matrix_t;
+        friend class MatrixWorker;
+
+    typedef std::vector<double> d_vector_t;
+
+    struct group_t          // Interconnected nodes solved together
+    {
+        int n;              // Number of nodes
+        int stride;         // Row size in dense storage, padded to cache line
+        double* a;          // Admittance Matrix, row major (dense solver)
+        double* lu;         // LU factors, same layout as a
+        double* b;          // Current vector
+        double* x;          // Node voltages solved
+        SparseLU* sparse;   // nullptr if group uses dense solver
+        int  firstChanged;  // First row/col changed since last factorization
+        bool admitChanged;
+        bool currChanged;
+        bool solveOk;
+        d_vector_t data;    // Storage for a, lu, b and x
+        std::vector<eNode*> eNodes;
+    };
 
     public:
         CircMatrix();
@@ -26,16 +56,33 @@ class CircMatrix
         void createMatrix( QList<eNode*> &eNodeList );
         bool solveMatrix();
 
+        solver_t solver() { return m_solver; }
+        void setSolver( solver_t s ) { m_solver = s; }
+
+        int threads() { return m_threads; }     // Applied at next createMatrix()
+        void setThreads( int t ) { m_threads = t < 0 ? 0 : t; }
+
+        int threadMin() { return m_threadMin; }
+        void setThreadMin( int n ) { m_threadMin = n < 2 ? 2 : n; }
+
         inline void stampDiagonal( int group, int n, double value ){
-            m_admitChanged[group] = true;
-            m_circMatrix[n][n] = value;      // eNode numbers start at 1
+            double* e = element( group, n, n );
+            if( *e == value ) return;
+            *e = value;
+            admitChanged( group, m_factorIdx[n] );
         }
-        inline void stampMatrix( int row, int col, double value ){
-            m_circMatrix[row][col] = value;      // eNode numbers start at 1
+        inline void stampMatrix( int group, int row, int col, double value ){
+            double* e = element( group, row, col );
+            if( !e || *e == value ) return;
+            *e = value;
+            int idx = m_factorIdx[row];
+            if( m_factorIdx[col] < idx ) idx = m_factorIdx[col];
+            admitChanged( group, idx );
         }
         inline void stampCoef( int group, int row, double value ){
-            m_currChanged[group] = true;
-            m_coefVect[row] = value;
+            group_t& g = m_groups[group];
+            g.currChanged = true;
+            g.b[m_localIdx[row]] = value;
         }
 
     private:
@@ -43,22 +90,54 @@ class CircMatrix
 
         void analyze();
         void addConnections( int enodNum, QList<int>* nodeGroup, QList<int>* allNodes );
+        SparseLU* createSparse( QList<int> &nodeGroup );
+        void clearSparse();
 
-        inline void factorMatrix( int n, int group );
-        inline bool luSolve( int n, int group );
+        inline double* element( int group, int row, int col ){ // eNode numbers to group storage
+            group_t& g = m_groups[group];
+            int r = m_localIdx[row];
+            int c = m_localIdx[col];
+            if( g.sparse ) return g.sparse->element( r, c );
+            return g.a + r*g.stride + c;
+        }
+        inline void admitChanged( int group, int idx ){
+            group_t& g = m_groups[group];
+            g.admitChanged = true;
+            if( idx < g.firstChanged ) g.firstChanged = idx;
+        }
+        inline void solveGroup( int group );
 
-        int m_numEnodes;
-        QList<eNode*>* m_eNodeList;
+        void startWorkers();
+        void stopWorkers();
+        void workerLoop();
+        void runJobs( uint64_t gen, int numJobs );
+
+#ifdef DEBUG_MATRIX
+        uint64_t m_solves;
+        uint64_t m_factors;
+        uint64_t m_partFactors;
+        uint64_t m_solveTime;
+#endif
 
-        QList<dp_matrix_t> m_aList;
-        QList<d_matrix_t>  m_aFaList;
-        QList<dp_vector_t> m_bList;
+        solver_t m_solver;
 
-        std::vector<bool>    m_admitChanged;
-        std::vector<bool>    m_currChanged;
-        QList<eNode*>*       m_eNodeActive;
-        QList<QList<eNode*>> m_eNodeActList;
+        int m_threads;   // Worker threads for big groups, 0 = solve all groups in simulation thread
+        int m_threadMin; // Minimum group size solved in worker threads
+
+        std::vector<MatrixWorker*> m_workers;
+        std::vector<int> m_jobs;            // Groups to solve in worker threads
+        std::atomic<uint64_t> m_nextJob;    // Generation<<32 | next job index
+        std::atomic<int> m_jobsDone;
+        uint64_t m_poolGen;
+        int  m_numJobs;
+        bool m_poolExit;
+        QMutex m_poolMutex;
+        QWaitCondition m_poolCond;
+
+        int m_numEnodes;
+        QList<eNode*>* m_eNodeList;
 
-        d_matrix_t m_circMatrix;
-        d_vector_t m_coefVect;
+        std::vector<group_t> m_groups;
+        std::vector<int> m_localIdx;  // eNode index in it's group storage
+        std::vector<int> m_factorIdx; // eNode index in factor order of it's group
 };
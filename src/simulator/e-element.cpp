@@ -13,6 +13,8 @@ eElement::eElement( QString id )
     nextChanged = nullptr;
     nextEvent  = nullptr;
     eventTime = 0;
+    eventSeq  = 0;
+    eventIndex = -1;
     m_pendingTime = 0;
     added = false;
     m_step = 0;
@@ -42,6 +42,8 @@ class eElement
 
         eElement* nextEvent;
         uint64_t eventTime;
+        uint64_t eventSeq;   // Insertion order, resolves same-time events
+        int      eventIndex; // Position in Simulator event heap, -1 if not queued
 
     protected:
         uint64_t m_pendingTime;
@@ -21,10 +21,6 @@ eNode::eNode( QString id )
 
     m_voltChEl     = nullptr;
     m_nonLinEl     = nullptr;
-    m_firstAdmit   = nullptr;
-    m_firstSingAdm = nullptr;
-    m_firstCurrent = nullptr;
-    m_nodeAdmit    = nullptr;
 
     if( !id.isEmpty() ) Simulator::self()->addToEnodeList( this );
 }
@@ -32,10 +28,6 @@ eNode::~eNode()
 {
     clearElmList( m_voltChEl );
     clearElmList( m_nonLinEl );
-    clearConnList( m_firstAdmit );
-    clearConnList( m_firstSingAdm );
-    clearConnList( m_firstCurrent );
-    clearConnList( m_nodeAdmit );
 }
 
 void eNode::initialize()
@@ -55,115 +47,83 @@ void eNode::initialize()
     clearElmList( m_nonLinEl );
     m_nonLinEl = nullptr;
 
-    clearConnList( m_firstAdmit );
-    m_firstAdmit = nullptr;
-
-    clearConnList( m_firstSingAdm );
-    m_firstSingAdm = nullptr;
-
-    clearConnList( m_firstCurrent );
-    m_firstCurrent = nullptr;
-
-    clearConnList( m_nodeAdmit );
-    m_nodeAdmit = nullptr;
-
+    m_admit.clear();      // Keep capacity for next run
+    m_singAdm.clear();
+    m_current.clear();
+    m_nodeAdmit.clear();
     m_nodeList.clear();
+
+    for( ePin* epin : m_ePinList ){ // Slots assigned again at stamp()
+        epin->m_admitSlot = -1;
+        epin->m_singSlot  = -1;
+        epin->m_currSlot  = -1;
+    }
 }
 
-void eNode::addConnection( ePin* epin, eNode* node )
+int eNode::addConnection( ePin* epin, eNode* node )
 {
-    if( node == this ) return;// Be sure msg doesn't come from this node
+    if( node == this ) return -1;// Be sure msg doesn't come from this node
 
-    Connection* first = m_firstAdmit; // Create list of connections
-    while( first ){
-        if( first->epin == epin ) return; // Connection already in the list
-        first = first->next;
-    }
-    Connection* conn = new Connection( epin, node );
-    conn->next = m_firstAdmit;  // Prepend
-    m_firstAdmit = conn;
-
-    first = m_nodeAdmit;            // Create list of admitances to nodes (reusing Connection class)
-    while( first ){
-        if( first->node == node ) return; // Node already in the list
-        first = first->next;
+    for( uint i=0; i<m_admit.size(); ++i ) // One per ePin: nodes not in node list (LedBase::m_gndEnode) are not cleared
+    {
+        admit_t& a = m_admit[i];
+        if( a.epin != epin ) continue;
+        a.nodeSlot = nodeSlot( node );
+        a.node = node;
+        return i;
     }
-    conn = new Connection( epin, node );
-    conn->next = m_nodeAdmit;  // Prepend
-    m_nodeAdmit = conn;
-
-    if( !m_nodeList.contains( conn->nodeNum ) ) m_nodeList.append( conn->nodeNum ); // Used by CircMatrix
+    m_admit.push_back( { 0, nodeSlot( node ), epin, node } );
+    return m_admit.size()-1;
 }
 
-void eNode::stampAdmitance( ePin* epin, double admit ) // Be sure msg doesn't come from this node
+void eNode::stampAdmitance( int slot, double admit ) // Be sure msg doesn't come from this node
 {
-    Connection* conn = m_firstAdmit;
-    while( conn ){
-        if( conn->epin == epin ) { conn->value = admit; break; } // Connection found
-        conn = conn->next;
-    }
+    if( slot >= 0 ) m_admit[slot].value = admit;
     m_admitChanged = true;
     changed();
 }
 
-void eNode::addSingAdm( ePin* epin, eNode* node, double admit )
+int eNode::addSingAdm( eNode* node, double admit )
 {
-    Connection* conn = new Connection( epin, node );
-    conn->next = m_firstSingAdm;  // Prepend
-    m_firstSingAdm = conn;
-    conn->value = admit;
-
-    conn = nullptr;
-    Connection* first = m_nodeAdmit;   // Create list of admitances to nodes (reusing Connection class)
-    while( first ){
-        if( first->node == node )  { conn = first; break; }// Node already in the list
-        first = first->next;
-    }
-    if( !conn ){
-        conn = new Connection( epin, node );
-        conn->next = m_nodeAdmit;  // Prepend
-        m_nodeAdmit = conn;
-    }
-    if( !m_nodeList.contains( conn->nodeNum ) ) m_nodeList.append( conn->nodeNum ); // Used by CircMatrix
+    m_singAdm.push_back( { admit, nodeSlot( node ), nullptr, node } );
     m_admitChanged = true;
     changed();
+    return m_singAdm.size()-1;
 }
 
-void eNode::stampSingAdm( ePin* epin, double admit )
+void eNode::stampSingAdm( int slot, double admit )
 {
-    Connection* conn = m_firstSingAdm;
-    while( conn ){
-        if( conn->epin == epin ) { conn->value = admit; break; } // Connection found
-        conn = conn->next;
-    }
+    if( slot >= 0 ) m_singAdm[slot].value = admit;
     m_admitChanged = true;
     changed();
 }
 
-void eNode::createCurrent( ePin* epin )
+int eNode::createCurrent()
 {
-    Connection* first = m_firstCurrent;
-
-    while( first ){
-        if( first->epin == epin ) return; // Element already in the list
-        first = first->next;
-    }
-    Connection* conn = new Connection( epin );
-    conn->next = m_firstCurrent;  // Prepend
-    m_firstCurrent = conn;
+    m_current.push_back( 0 );
+    return m_current.size()-1;
 }
 
-void eNode::stampCurrent( ePin* epin, double current ) // Be sure msg doesn't come from this node
+void eNode::stampCurrent( int slot, double current ) // Be sure msg doesn't come from this node
 {
-    Connection* conn = m_firstCurrent;
-    while( conn ){
-        if( conn->epin == epin ) { conn->value = current; break; } // Connection found
-        conn = conn->next;
-    }
+    if( slot >= 0 ) m_current[slot] = current;
     m_currChanged = true;
     changed();
 }
 
+int eNode::nodeSlot( eNode* node ) // Index of node in list of admitances to nodes
+{
+    int nodeNum = node ? node->getNodeNumber() : -1;
+    if( nodeNum < 0 ) return -1;
+
+    for( uint i=0; i<m_nodeAdmit.size(); ++i )
+        if( m_nodeAdmit[i].nodeNum == nodeNum ) return i;
+
+    m_nodeAdmit.push_back( { 0, nodeNum } );
+    m_nodeList.append( nodeNum ); // Used by CircMatrix
+    return m_nodeAdmit.size()-1;
+}
+
 void eNode::changed()
 {
     if( m_changed ) return;
@@ -181,58 +141,27 @@ void eNode::stampMatrix()
         m_totalAdmit = 0;
 
         if( m_single ){
-            Connection* conn = m_firstAdmit;
-            while( conn ){ m_totalAdmit += conn->value; conn = conn->next; } // Calculate total admitance
+            for( const admit_t& a : m_admit ) m_totalAdmit += a.value; // Calculate total admitance
         }else{
-            Connection* na = m_nodeAdmit;
-            while( na ){ na->value = 0; na = na->next; } // Clear nodeAdmit
-
-            Connection* conn = m_firstAdmit; // Full Admitances
-            while( conn ){
-                double adm = conn->value;
-                int  enode = conn->nodeNum;
-
-                if( enode >= 0 ){        // Calculate admitances to nodes
-                    na = m_nodeAdmit;
-                    while( na ){
-                        if( na->nodeNum == enode ){ na->value += adm; break; }
-                        na = na->next;
-                    }
-                }
-                m_totalAdmit += adm;    // Calculate total admitance
-                conn = conn->next;
+            for( nodeAdmit_t& na : m_nodeAdmit ) na.value = 0;         // Clear nodeAdmit
+
+            for( const admit_t& a : m_admit ){                        // Full Admitances
+                if( a.nodeSlot >= 0 ) m_nodeAdmit[a.nodeSlot].value += a.value; // Calculate admitances to nodes
+                m_totalAdmit += a.value;                               // Calculate total admitance
             }
             CircMatrix::self()->stampDiagonal( m_nodeGroup, m_nodeNum, m_totalAdmit ); // Stamp diagonal
 
-            conn = m_firstSingAdm;      // Single admitance values
-            while( conn ){
-                double adm = conn->value;
-                int  enode = conn->nodeNum;
-
-                if( enode >= 0 ){        // Add sinle admitance to node
-                    na = m_nodeAdmit;
-                    while( na ){
-                        if( na->nodeNum == enode ){ na->value += adm; break; }
-                        na = na->next;
-                    }
-                }
-                conn = conn->next;
-            }
-            na = m_nodeAdmit;
-            while( na ){                  // Stamp non diagonal
-                int    enode = na->nodeNum;
-                double admit = na->value;
-                if( enode >= 0 ) CircMatrix::self()->stampMatrix( m_nodeNum, enode, -admit );
-                na = na->next;
-            }
+            for( const admit_t& a : m_singAdm )                       // Single admitance values
+                if( a.nodeSlot >= 0 ) m_nodeAdmit[a.nodeSlot].value += a.value;
+
+            for( const nodeAdmit_t& na : m_nodeAdmit )                 // Stamp non diagonal
+                CircMatrix::self()->stampMatrix( m_nodeGroup, m_nodeNum, na.nodeNum, -na.value );
         }
         m_admitChanged = false;
     }
     if( m_currChanged ){
         m_totalCurr  = 0;
-
-        Connection* conn = m_firstCurrent;
-        while( conn ){ m_totalCurr += conn->value; conn = conn->next; } // Calculate total current
+        for( double current : m_current ) m_totalCurr += current;     // Calculate total current
 
         if( !m_single ) CircMatrix::self()->stampCoef( m_nodeGroup, m_nodeNum, m_totalCurr );
         m_currChanged  = false;
@@ -265,7 +194,12 @@ void  eNode::setVolt( double v )
         Simulator::self()->addToChangedList( el );
         el->added = true;
     }
-    linked = m_nonLinEl ;              // Non Linear callback
+    wakeNonLinear();                      // Non Linear callback
+}
+
+void eNode::wakeNonLinear()
+{
+    CallBackElement* linked = m_nonLinEl;
     while( linked )
     {
         eElement* el = linked->element;
@@ -368,21 +302,17 @@ void eNode::updateCurrents()
     //    epin->m_hasCurrent = false;
     //    epin->m_current = 0;
     //}
-    Connection* conn = m_firstAdmit;
-    while( conn )
+    for( const admit_t& a : m_admit )
     {
-
         //if( fabs(current) < 1e-7 ) current = 0;
-        ePin* circuitPin = conn->epin->m_circuitPin;
+        ePin* circuitPin = a.epin->m_circuitPin;
         if( circuitPin ){
-            double admit = conn->value;
-            double volt1 = conn->node->getVolt();
-            double current = (volt1-m_volt)*admit;
-            circuitPin->m_current += current + conn->epin->m_sourceCurrent;
+            double volt1 = a.node->getVolt();
+            double current = (volt1-m_volt)*a.value;
+            circuitPin->m_current += current + a.epin->m_sourceCurrent;
             circuitPin->m_hasCurrent = true;
         }
-        //else qDebug() << "eNode::updateCurrents Error: missing circuitPin" << conn->epin->getId();
-        conn = conn->next;
+        //else qDebug() << "eNode::updateCurrents Error: missing circuitPin" << a.epin->getId();
     }
 }
 
@@ -394,12 +324,3 @@ void eNode::clearElmList( CallBackElement* first )
         delete del;
     }
 }
-
-void eNode::clearConnList( Connection* first )
-{
-    while( first ){
-        Connection* del = first;
-        first = first->next;
-        delete del;
-    }
-}
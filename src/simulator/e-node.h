@@ -6,6 +6,7 @@
 #pragma once
 
 #include<QHash>
+#include <vector>
 
 class ePin;
 class Node;
@@ -29,16 +30,19 @@ class eNode
         void remFromChangedCallback( eElement* el );
 
         void addToNoLinList( eElement* el );
+        bool hasNonLinear() { return m_nonLinEl; }
+        void wakeNonLinear();                      // Evaluate Non Linear elements again
         //void remFromNoLinList( eElement* el );
 
-        void addConnection( ePin* epin, eNode* node );
-        void stampAdmitance( ePin* epin, double admit );
+        // Slots are assigned to ePins at stamp time, stamps just write the value
+        int  addConnection( ePin* epin, eNode* node );   // Returns admitance slot
+        void stampAdmitance( int slot, double admit );
 
-        void addSingAdm( ePin* epin, eNode* node, double admit );
-        void stampSingAdm( ePin* epin, double admit );
+        int  addSingAdm( eNode* node, double admit );    // Returns single admitance slot
+        void stampSingAdm( int slot, double admit );
 
-        void createCurrent( ePin* epin );
-        void stampCurrent( ePin* epin, double current );
+        int  createCurrent();                            // Returns current slot
+        void stampCurrent( int slot, double current );
 
         int  getNodeNumber() { return m_nodeNum; }
         void setNodeNumber( int n ) { m_nodeNum = n; }
@@ -65,19 +69,15 @@ class eNode
         eNode* nextCH;
 
     private:
-        class Connection
-        {
-            public:
-                Connection( ePin* e, eNode* n=nullptr, double v=0 )
-                { epin = e; node = n; value = v;
-                  if( n ) nodeNum = n->getNodeNumber(); }
-                ~Connection(){;}
-
-                Connection* next = nullptr;
-                ePin*  epin = nullptr;
-                eNode* node = nullptr;
-                int    nodeNum = 0;
-                double value;
+        struct admit_t{
+            double value;
+            int    nodeSlot; // Index in m_nodeAdmit, -1 if not a Matrix node
+            ePin*  epin;
+            eNode* node;
+        };
+        struct nodeAdmit_t{  // Admitance to neighbor node
+            double value;
+            int    nodeNum;
         };
         class CallBackElement
         {
@@ -94,7 +94,8 @@ class eNode
         inline void solveSingle();
 
         void clearElmList( CallBackElement* first );
-        void clearConnList( Connection* first );
+
+        int nodeSlot( eNode* node );
 
         QString m_id;
 
@@ -103,10 +104,10 @@ class eNode
         CallBackElement* m_voltChEl;
         CallBackElement* m_nonLinEl;
 
-        Connection* m_firstAdmit;   // Stamp full admitance in Admitance Matrix
-        Connection* m_firstSingAdm; // Stamp single value   in Admitance Matrix
-        Connection* m_firstCurrent; // Stamp value in Current Vector
-        Connection* m_nodeAdmit;
+        std::vector<admit_t>     m_admit;    // Stamp full admitance in Admitance Matrix
+        std::vector<admit_t>     m_singAdm;  // Stamp single value   in Admitance Matrix
+        std::vector<double>      m_current;  // Stamp value in Current Vector
+        std::vector<nodeAdmit_t> m_nodeAdmit;
 
         QList<int> m_nodeList;
         QList<Node*> m_nodeCompList;
@@ -15,6 +15,10 @@ ePin::ePin( QString id, int index )
     m_circuitPin = nullptr;
     m_inverted = false;
 
+    m_admitSlot = -1;
+    m_singSlot  = -1;
+    m_currSlot  = -1;
+
     m_current = 0;
     m_sourceCurrent = 0;
 }
@@ -31,28 +35,31 @@ void ePin::setEnode( eNode* enode )
     if( enode ) enode->addEpin( this );
 
     m_enode = enode;
+    m_admitSlot = -1; // Slots belong to previous eNode
+    m_singSlot  = -1;
+    m_currSlot  = -1;
 }
 
 void ePin::setEnodeComp( eNode* enode )
 {
     m_enodeComp = enode;
     if( m_enode && m_enodeComp )
-        m_enode->addConnection( this, enode );
+        m_admitSlot = m_enode->addConnection( this, enode );
 }
 
 void ePin::addSingAdm( eNode* node, double admit )
 {
-    if( m_enode ) m_enode->addSingAdm( this, node, admit );
+    if( m_enode ) m_singSlot = m_enode->addSingAdm( node, admit );
 }
 
 void ePin::stampSingAdm( double admit )
 {
-    if( m_enode ) m_enode->stampSingAdm( this, admit );
+    if( m_enode ) m_enode->stampSingAdm( m_singSlot, admit );
 }
 
 void ePin::createCurrent()
 {
-    if( m_enode ) m_enode->createCurrent( this );
+    if( m_enode && m_currSlot < 0 ) m_currSlot = m_enode->createCurrent();
 }
 
 void ePin::changeCallBack( eElement* el, bool cb )
@@ -33,13 +33,13 @@ class ePin
         bool inverted() { return m_inverted; }
         virtual void setInverted( bool i ) { m_inverted = i; }
 
-        inline void stampAdmitance( double a ) { if( m_enode ) m_enode->stampAdmitance( this, a ); }
+        inline void stampAdmitance( double a ) { if( m_enode ) m_enode->stampAdmitance( m_admitSlot, a ); }
 
         void addSingAdm( eNode* node, double admit );
         void stampSingAdm( double admit );
 
         void createCurrent();
-        inline void stampCurrent( double c ) { if( m_enode ) { m_sourceCurrent = c; m_enode->stampCurrent( this, c ); } }
+        inline void stampCurrent( double c ) { if( m_enode ) { m_sourceCurrent = c; m_enode->stampCurrent( m_currSlot, c ); } }
         
         QString getId()  { return m_id; }
         void setId( QString id );
@@ -62,6 +62,10 @@ class ePin
         eNode* m_enode;     // My eNode
         eNode* m_enodeComp; // eNode at other side of my component
 
+        int m_admitSlot;    // Slots in my eNode arrays, -1 if none
+        int m_singSlot;
+        int m_currSlot;
+
         QString m_id;
         int m_index;
 
@@ -0,0 +1,67 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <cmath>
+
+#include "diodebatch.h"
+#include "e-diode.h"
+
+DiodeBatch* DiodeBatch::m_pSelf = nullptr;
+
+DiodeBatch::DiodeBatch()
+{
+    m_pSelf = this;
+    m_batches = 0;
+    m_count   = 0;
+}
+DiodeBatch::~DiodeBatch(){}
+
+// No branches and no aliasing: vectorized
+static void diodeModel( uint32_t size, const double* argD, const double* argZ
+                      , const double* vdCoef, const double* vzCoef, const double* satCur, const double* gmin
+                      , double* __restrict admit, double* __restrict current )
+{
+    for( uint32_t i=0; i<size; ++i )
+    {
+        double eval = std::exp( argD[i] );
+        double expZ = std::exp( argZ[i] );
+        admit[i]   = satCur[i]*( vdCoef[i]*eval + vzCoef[i]*expZ ) + gmin[i];
+        current[i] = satCur[i]*( eval-1 - expZ );
+    }
+}
+
+void DiodeBatch::evaluate()
+{
+    uint32_t size = m_diodes.size();
+    m_admit.resize( size );
+    m_current.resize( size );
+
+    diodeModel( size, m_argD.data(), m_argZ.data(), m_vdCoef.data(), m_vzCoef.data()
+              , m_satCur.data(), m_gmin.data(), m_admit.data(), m_current.data() );
+
+    for( uint32_t i=0; i<size; ++i ) m_diodes[i]->stampModel( m_admit[i], m_current[i] );
+
+    m_batches++;
+    m_count += size;
+    clear();
+}
+
+void DiodeBatch::reset()
+{
+    clear();
+    m_batches = 0;
+    m_count   = 0;
+}
+
+void DiodeBatch::clear() // Keep capacity
+{
+    m_diodes.clear();
+    m_argD.clear();
+    m_argZ.clear();
+    m_vdCoef.clear();
+    m_vzCoef.clear();
+    m_satCur.clear();
+    m_gmin.clear();
+}
@@ -0,0 +1,65 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#define DIODE_NO_BREAKDOWN -700. // exp() ~ 0
+
+class eDiode;
+
+// Evaluates together the exponential models of all eDiodes in one Non Linear iteration.
+// eDiode::voltChanged() queues its limited junction voltage and Simulator calls evaluate()
+// after all Non Linear elements run. Loops over plain arrays: compiler uses SIMD exp().
+
+class DiodeBatch
+{
+    public:
+        DiodeBatch();
+        ~DiodeBatch();
+
+ static DiodeBatch* self() { return m_pSelf; }
+
+        inline void queue( eDiode* diode, double argD, double argZ, double vdCoef, double vzCoef, double satCur, double gmin )
+        {
+            m_diodes.push_back( diode );
+            m_argD.push_back( argD );
+            m_argZ.push_back( argZ );
+            m_vdCoef.push_back( vdCoef );
+            m_vzCoef.push_back( vzCoef );
+            m_satCur.push_back( satCur );
+            m_gmin.push_back( gmin );
+        }
+
+        bool empty() { return m_diodes.empty(); }
+
+        void evaluate(); // Calculate and stamp all queued eDiodes
+        void reset();
+
+        uint64_t batches() { return m_batches; }
+        uint64_t diodes()  { return m_count; }
+
+    private:
+ static DiodeBatch* m_pSelf;
+
+        void clear();
+
+        std::vector<eDiode*> m_diodes;
+
+        std::vector<double> m_argD;   // Forward exponent
+        std::vector<double> m_argZ;   // Breakdown exponent, very negative if not in breakdown
+        std::vector<double> m_vdCoef;
+        std::vector<double> m_vzCoef;
+        std::vector<double> m_satCur;
+        std::vector<double> m_gmin;
+
+        std::vector<double> m_admit;
+        std::vector<double> m_current;
+
+        uint64_t m_batches;
+        uint64_t m_count;
+};
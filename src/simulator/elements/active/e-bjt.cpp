@@ -49,7 +49,7 @@ void eBJT::setup()
 void eBJT::initialize()
 {
     m_changed = true;
-    m_step = 0;
+    m_gmin = 0;
     m_voltBE = 0;
     m_voltBC = 0;
     m_baseCurr = 0;
@@ -93,16 +93,16 @@ void eBJT::voltChanged()
     double voltB = BASE->getVoltage();
     double voltBC = voltB-voltC;
     double voltBE = voltB-voltE;
+    double gmin = Simulator::self()->gmin();
 
-    if( m_changed ) m_changed = false;      // Forze recalculation
-    else if( qFabs(voltBC-m_voltBC) < .01
-          && qFabs(voltBE-m_voltBE) < .01 )
-        { m_step = 0; return; }
+    if( m_changed || gmin != m_gmin ) m_changed = false;      // Forze recalculation
+    else if( Simulator::self()->nlConverged( voltBC, m_voltBC )
+          && Simulator::self()->nlConverged( voltBE, m_voltBE ) )
+        return;
     Simulator::self()->notCorverged();
 
-    m_step += .1;
-    double gmin = m_satCur*1e-2*qExp( m_step );
-    if( gmin > .1 ) gmin = .1;
+    m_gmin = gmin;
+    gmin += m_satCur*1e-2;
 
     voltBC = pnp*limitStep( pnp*voltBC, pnp*m_voltBC );
     m_voltBC = voltBC;
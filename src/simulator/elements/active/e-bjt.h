@@ -38,6 +38,7 @@ class eBJT : public eElement
         double m_vt;
         double m_satCur;
         double m_vCrit;
+        double m_gmin;   // Simulator gmin in last stamp
         double m_rgain;
         double m_fgain;
 
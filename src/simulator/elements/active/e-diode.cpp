@@ -10,6 +10,7 @@
 #include <QDomDocument>
 
 #include "e-diode.h"
+#include "diodebatch.h"
 #include "e-pin.h"
 #include "e-node.h"
 #include "simulator.h"
@@ -36,6 +37,7 @@ void eDiode::stamp()
     m_converged = true;
     m_admit   = m_bAdmit;
     m_voltPN  = 0;
+    m_gmin    = 0;
     m_current = 0;
 
     eResistor::stamp();
@@ -53,15 +55,15 @@ void eDiode::stamp()
 void eDiode::voltChanged()
 {
     double voltPN = m_ePin[0]->getVoltage() - m_ePin[1]->getVoltage();
+    double gmin = Simulator::self()->gmin();
 
-    if( m_changed ) m_changed = false;
-    else if( qFabs( voltPN - m_voltPN ) < .01 ) { m_step = 0; m_converged = true; return; } // Converged
+    if( m_changed || gmin != m_gmin ) m_changed = false;           // Forze recalculation
+    else if( Simulator::self()->nlConverged( voltPN, m_voltPN ) ) { m_converged = true; return; } // Converged
     m_converged = false;
     Simulator::self()->notCorverged();
 
-    m_step += .01;
-    double gmin = m_bAdmit*qExp( m_step );
-    if( gmin > .1 ) gmin = .1;
+    m_gmin = gmin;
+    gmin += m_bAdmit;
 
     if( voltPN > m_vCriti && qFabs(voltPN - m_voltPN) > m_vScale*2 ) // check new voltage; has current changed by factor of e^2?
     {
@@ -78,20 +80,19 @@ void eDiode::voltChanged()
     }
     m_voltPN = voltPN;
 
-    double eval = qExp( voltPN*m_vdCoef );
+    double argZ = DIODE_NO_BREAKDOWN;
+    if( m_bkDown != 0 && voltPN < 0 ) argZ = (-voltPN-m_zOfset)*m_vzCoef; // Reverse biased Zener or Diode with breakdown
 
-    if( m_bkDown == 0 || voltPN >= 0  )  // No breakdown Diode or Forward biased Zener
-    {
-        m_admit   = m_satCur * m_vdCoef*eval + gmin;
-        m_current = m_satCur * (eval-1);
-    }else{                               // Reverse biased Zener or Diode with breakdown
-        double expCoef = qExp( (-voltPN-m_zOfset)*m_vzCoef );
-        m_admit   = m_satCur * ( m_vdCoef*eval + m_vzCoef*expCoef ) + gmin;
-        m_current = m_satCur * ( eval-1 - expCoef ) ;
-    }
+    DiodeBatch::self()->queue( this, voltPN*m_vdCoef, argZ, m_vdCoef, m_vzCoef, m_satCur, gmin );
+}
+
+void eDiode::stampModel( double admit, double current ) // Called from DiodeBatch
+{
+    m_admit   = admit;
+    m_current = current;
     eResistor::stampAdmit();
 
-    double stCurr = m_current - m_admit*voltPN;
+    double stCurr = m_current - m_admit*m_voltPN;
     m_ePin[0]->stampCurrent(-stCurr );
     m_ePin[1]->stampCurrent( stCurr );
 }
@@ -28,6 +28,8 @@ class eDiode : public eResistor
         virtual void stamp() override;
         virtual void voltChanged() override;
 
+        void stampModel( double admit, double current );
+
         double threshold() { return m_vCriti; }
         void   setThreshold( double vCrit );
 
@@ -71,6 +73,7 @@ class eDiode : public eResistor
 
         double m_voltPN;
         double m_bAdmit;
+        double m_gmin;   // Simulator gmin in last stamp
 
         QString m_diodeType;
         QString m_model;
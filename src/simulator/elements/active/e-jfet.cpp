@@ -30,7 +30,11 @@ void eJfet::initialize()
     m_step = 0;
     m_gateV = eElement::cero_doub;
     m_lastCurrent = eElement::cero_doub;
-    m_accuracy = 1;
+    m_damped = false;
+    m_changed = true;
+    m_voltGS = 0;
+    m_voltDS = 0;
+    m_gmin = 0;
     m_beta = m_Idss/(qPow(m_Vp,2));
     m_admit = eElement::cero_doub;
 }
@@ -81,6 +85,19 @@ void eJfet::voltChanged()
     double Vg = m_ePin[2]->isConnected() ? m_ePin[2]->getVoltage() : Vs;
     double Vgs = Vg-Vs;
     double Vds = Vd-Vs; // Should always be positive using virtual switching method above
+    double gmin = Simulator::self()->gmin();
+
+    if( m_changed || gmin != m_gmin ) m_changed = false;      // Forze recalculation
+    else if( !m_damped
+          && Simulator::self()->nlConverged( Vgs, m_voltGS )
+          && Simulator::self()->nlConverged( Vds, m_voltDS ) )
+        return;                                               // Converged
+    Simulator::self()->notCorverged();
+
+    m_voltGS = Vgs;
+    m_voltDS = Vds;
+    m_gmin = gmin;
+
     double gateV = Vgs - m_Vp; // Vgs - Vgs(off)
     double tempAdmit = eElement::cero_doub;
 
@@ -100,7 +117,7 @@ void eJfet::voltChanged()
         if( Vds < gateV)
         {
             current = m_beta*( 2*( gateV )*Vds-qPow( Vds , 2 ))*correction;
-            tempAdmit = current/Vds;
+            tempAdmit = m_beta*( 2*( gateV )-Vds )*correction; // current/Vds, also valid at Vds = 0
         }
         else //(i.e., Vds >= gateV
         {
@@ -111,20 +128,14 @@ void eJfet::voltChanged()
 
     // if( m_Pchannel ) current = -current;
 
+    tempAdmit += gmin;
+    double modelAdmit = tempAdmit;
+    if( Simulator::self()->nlIteration() > NL_GMIN_ITER )   // Not converging: damp admittance steps
+        tempAdmit = m_admit + (tempAdmit-m_admit)*0.5;
+    m_damped = !Simulator::self()->nlStampConverged( tempAdmit, modelAdmit );
 
-
-    if( qFabs(current-m_lastCurrent)<m_accuracy )
-    {
-        if( tempAdmit != m_admit ){
-            eResistor::setAdmit( tempAdmit );
-            eResistor::stamp();
-        }
-        return; // Converged
-    }
-
-    Simulator::self()->notCorverged();
     if( tempAdmit != m_admit ){
-        eResistor::setAdmit( m_admit + 0.001*(tempAdmit-m_admit));
+        eResistor::setAdmit( tempAdmit );
         eResistor::stamp();
     }
 
@@ -33,8 +33,10 @@ class eJfet : public eResistor
     protected:
         void updateValues();
 
-        double m_accuracy;
         double m_lastCurrent;
+        double m_voltGS;
+        double m_voltDS;
+        double m_gmin;   // Simulator gmin in last stamp
         double m_lastAdmit;
         double m_gateV;
         double m_beta;
@@ -42,6 +44,7 @@ class eJfet : public eResistor
 
         // Component properties
         bool m_Pchannel;    // Not user defineable yet
+        bool m_damped;      // Last stamp damped, not at model value yet
         double m_Idss;      // Idss = Ids when gate "shorted" to source (i.e., nearly maxCurrent). Idss is specified in datasheets.
         double m_Vp;        // Pinch off voltage or Vgs(off), specified in datasheets
         double m_LambdaInv;    // Not specified in datasheets but (nearly) identical to lambda in LTSpice accounting for channel length
@@ -27,9 +27,14 @@ eMosfet::~eMosfet(){}
 
 void eMosfet::initialize()
 {
+    m_changed = true;
     m_step = 0;
     m_gateV = 0;
     m_lastCurrent = 0;
+    m_damped = false;
+    m_voltGS = 0;
+    m_voltDS = 0;
+    m_gmin = 0;
 }
 
 void eMosfet::stamp()
@@ -37,7 +42,6 @@ void eMosfet::stamp()
     m_admit = 1/m_RDSon;
 
     updateValues();
-    m_accuracy = 5e-6;
 
     if( (m_ePin[0]->isConnected())
       &&(m_ePin[1]->isConnected()) )
@@ -62,7 +66,19 @@ void eMosfet::voltChanged()
     double Vds = Vd-Vs;
 
     if( m_Pchannel ){ Vgs = -Vgs; Vds = -Vds; }
-    
+    double gmin = Simulator::self()->gmin();
+
+    if( m_changed || gmin != m_gmin ) m_changed = false;      // Forze recalculation
+    else if( !m_damped
+          && Simulator::self()->nlConverged( Vgs, m_voltGS )
+          && Simulator::self()->nlConverged( Vds, m_voltDS ) )
+        return;                                               // Converged
+    Simulator::self()->notCorverged();
+
+    m_voltGS = Vgs;
+    m_voltDS = Vds;
+    m_gmin = gmin;
+
     double gateV = Vgs - m_Gth;
     
     if( gateV < 0 ) gateV = 0;
@@ -83,15 +99,18 @@ void eMosfet::voltChanged()
         current = maxCurrDS-DScurrent;
     }
     if( m_Pchannel ) current = -current;
-    
+    admit += gmin;
+
     if( admit != m_admit ){
         eResistor::setAdmit( admit );
         eResistor::stamp();
     }
     m_gateV = gateV;
 
-    if( qFabs(current-m_lastCurrent)<m_accuracy ) return; // Converged
-    Simulator::self()->notCorverged();
+    double modelCurrent = current;
+    if( Simulator::self()->nlIteration() > NL_GMIN_ITER )   // Not converging: damp current steps
+        current = m_lastCurrent + (current-m_lastCurrent)*0.5;
+    m_damped = !Simulator::self()->nlStampConverged( current, modelCurrent );
 
     m_lastCurrent = current;
     m_ePin[0]->stampCurrent( current );
@@ -32,8 +32,10 @@ class eMosfet : public eResistor
     protected:
         void updateValues();
 
-        double m_accuracy;
         double m_lastCurrent;
+        double m_voltGS;
+        double m_voltDS;
+        double m_gmin;   // Simulator gmin in last stamp
         double m_threshold;
         double m_kRDSon;
         double m_RDSon;
@@ -42,4 +44,5 @@ class eMosfet : public eResistor
 
         bool m_Pchannel;
         bool m_depletion;
+        bool m_damped;   // Last stamp damped, not at model value yet
 };
@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <algorithm>
+
 #include "analogclock.h"
 #include "simulator.h"
 #include "e-reactive.h"
@@ -17,13 +19,33 @@ AnalogClock::AnalogClock()
     m_clkElement = nullptr;
     m_divider = 1;
     m_period = m_step = 1e6;
+    m_minStep = 0;
+    m_maxStep = 0;
+    m_error = 0;
+    m_quietSteps  = 0;
+    m_reactSteps  = 0;
+    m_stepChanges = 0;
+    m_integration = intEULER;
+    m_wakes  = 0;
+    m_sleeps = 0;
+    updtBounds();
+    m_concurrent = true;   // updateStep() only updates App dialog
 }
 AnalogClock::~AnalogClock(){}
 
 void AnalogClock::stamp()
 {
     setDivider( 1 );
-    if( m_clkElement ) Simulator::self()->addEvent( m_period, this );
+    m_error = 0;
+    m_quietSteps  = 0;
+    m_reactSteps  = 0;
+    m_stepChanges = 0;
+    resetCounters();
+
+    m_active.clear();
+    for( eReactive* r : m_reactive ){ r->m_awake = true; m_active.push_back( r ); } // All run first step
+
+    if( m_clkElement || !m_active.empty() ) Simulator::self()->addEvent( m_period, this );
 }
 
 void AnalogClock::updateStep()
@@ -35,21 +57,84 @@ void AnalogClock::updateStep()
 
 void AnalogClock::runEvent()
 {
+    if( adaptive() ) adaptStep();             // Elements get new step now
+    m_error = 0;
+
     eElement* clkElement = m_clkElement;
     while( clkElement )
     {
         clkElement->runEvent();
         clkElement = clkElement->nextEvent;
     }
+
+    uint32_t awake = 0;
+    uint32_t size = m_active.size();
+    for( uint32_t i=0; i<size; ++i )  // Elements with nothing to do go to sleep
+    {
+        eReactive* r = m_active[i];
+        r->runEvent();
+        if( r->m_awake ) m_active[awake++] = r;
+#ifdef DEBUG_EVENTS
+        else m_sleeps++;
+#endif
+    }
+    m_active.erase( m_active.begin()+awake, m_active.begin()+size ); // Keep any woken meanwhile
+    m_reactSteps++;
     Simulator::self()->addEvent( m_step, this );
 }
 
+void AnalogClock::adaptStep() // Based on error estimated by eReactive elements in last step
+{
+    uint64_t step = m_step;
+
+    if( m_error > 1 )              // Too big: halve until error is in tolerance (error ~ step²)
+    {
+        m_quietSteps = 0;
+        while( m_error > 1 && step > m_lowStep ){ step /= 2; m_error /= 4; }
+        if( step < m_lowStep ) step = m_lowStep;
+    }
+    else if( m_error < 0.1 )       // Quiescent: double after some steps
+    {
+        if( ++m_quietSteps < 4 ) return;
+        m_quietSteps = 0;
+        step *= 2;
+        if( step > m_highStep ) step = m_highStep;
+    }
+    else { m_quietSteps = 0; return; }
+
+    if( step == m_step ) return;
+    m_step = step;
+    m_stepChanges++;
+
+    for( eReactive* r : m_reactive ) if( !r->m_awake ) r->voltChanged(); // All update companion model
+}
+
 void AnalogClock::addClkElement( eElement* e )
 {
     e->nextEvent = m_clkElement;
     m_clkElement = e;
 }
 
+void AnalogClock::addReactive( eReactive* r )
+{
+    r->m_awake = false;
+    m_reactive.push_back( r );
+}
+
+void AnalogClock::remReactive( eReactive* r )
+{
+    m_reactive.erase( std::remove( m_reactive.begin(), m_reactive.end(), r ), m_reactive.end() );
+    m_active.erase( std::remove( m_active.begin(), m_active.end(), r ), m_active.end() );
+}
+
+void AnalogClock::wake( eReactive* r )
+{
+    m_active.push_back( r );
+#ifdef DEBUG_EVENTS
+    m_wakes++;
+#endif
+}
+
 void AnalogClock::remClkElement( eElement* e )
 {
     eElement* clkElement = m_clkElement;
@@ -74,12 +159,25 @@ void AnalogClock::remClkElement( eElement* e )
 void AnalogClock::setPeriod( uint64_t p )
 {
     m_period = p;
-    m_step = m_period/m_divider;
+    updtBounds();
 }
 
 void AnalogClock::setDivider( uint64_t d )
 {
     m_divider = d;
-    m_step = m_period/m_divider;
+    updtBounds();
     m_changed = true;
 }
+
+void AnalogClock::updtBounds()
+{
+    m_step = m_period/m_divider;
+
+    m_highStep = m_maxStep ? m_maxStep/m_divider : m_step;
+    m_lowStep  = m_minStep ? m_minStep/m_divider : m_step;
+    if( m_lowStep  < 1 ) m_lowStep = 1;
+    if( m_highStep < m_lowStep ) m_highStep = m_lowStep;
+
+    if     ( m_step < m_lowStep  ) m_step = m_lowStep;
+    else if( m_step > m_highStep ) m_step = m_highStep;
+}
@@ -5,9 +5,22 @@
 
 #pragma once
 
+#include <vector>
+
 #include "e-element.h"
 #include "updatable.h"
 
+class eReactive;
+
+#define REACT_ABSTOL 1e-3 // Reactive step: local truncation error tolerance
+#define REACT_RELTOL 1e-3
+
+enum integration_t{
+    intEULER=0,      // Backward Euler
+    intTRAPEZOIDAL,
+    intGEAR2,        // Variable step BDF2
+};
+
 class AnalogClock : public eElement, public Updatable
 {
     public:
@@ -21,6 +34,10 @@ class AnalogClock : public eElement, public Updatable
         void addClkElement( eElement* e );
         void remClkElement( eElement* e );
 
+        void addReactive( eReactive* r );
+        void remReactive( eReactive* r );
+        void wake( eReactive* r ); // Terminal voltage changed
+
         void setPeriod( uint64_t p );
         uint64_t getPeriod() { return m_period; }
 
@@ -29,14 +46,56 @@ class AnalogClock : public eElement, public Updatable
 
         uint64_t getStep(){ return m_step; }
 
+        void setMinStep( uint64_t s ) { m_minStep = s; updtBounds(); } // 0 = Period: fixed step
+        uint64_t minStep() { return m_minStep; }
+
+        void setMaxStep( uint64_t s ) { m_maxStep = s; updtBounds(); } // 0 = Period
+        uint64_t maxStep() { return m_maxStep; }
+
+        void setIntegration( integration_t i ) { m_integration = i; }
+        integration_t integration() { return m_integration; }
+
+        bool adaptive() { return m_lowStep < m_highStep; }
+        inline void addError( double e ) { if( e > m_error ) m_error = e; } // Error/tolerance in last step
+
+        uint64_t reactSteps() { return m_reactSteps; }
+        uint64_t stepChanges() { return m_stepChanges; }
+
+        uint64_t wakes()  { return m_wakes; }  // Counted if DEBUG_EVENTS
+        uint64_t sleeps() { return m_sleeps; }
+        uint32_t active() { return m_active.size(); }
+        void resetCounters() { m_wakes = 0; m_sleeps = 0; }
+
  static AnalogClock* self() { return m_pSelf; }
 
     private:
+        void updtBounds();
+        void adaptStep();
+
         uint64_t m_period; // in ps
         uint64_t m_step;
         uint64_t m_divider;
 
+        uint64_t m_minStep; // User bounds
+        uint64_t m_maxStep;
+        uint64_t m_lowStep; // Bounds for current divider
+        uint64_t m_highStep;
+
+        double m_error;
+        int    m_quietSteps;
+
+        uint64_t m_reactSteps;
+        uint64_t m_stepChanges;
+
+        integration_t m_integration;
+
         eElement* m_clkElement;
 
+        std::vector<eReactive*> m_reactive; // All reactive elements
+        std::vector<eReactive*> m_active;   // Reactive elements to run next step
+
+        uint64_t m_wakes;
+        uint64_t m_sleeps;
+
  static AnalogClock* m_pSelf;
 };
@@ -3,6 +3,8 @@
  *                                                                         *
  ***( see copyright.txt file at root folder )*******************************/
 
+#include <math.h>
+
 #include "e-reactive.h"
 #include "e-pin.h"
 #include "e-node.h"
@@ -15,27 +17,33 @@ eReactive::eReactive( QString id )
     m_value    = 0;
     m_InitCurr = 0;
     m_InitVolt = 0;
+    m_lastTStep = 0;
+    m_stepRatio = 1;
 
-    AnalogClock::self()->addClkElement( this );
+    AnalogClock::self()->addReactive( this );
 }
 eReactive::~eReactive()
 {
-    AnalogClock::self()->remClkElement( this );
+    AnalogClock::self()->remReactive( this );
 }
 
 void eReactive::stamp()
 {
     eResistor::stamp();
 
+    m_lastTStep = 0;
+    updtReactStep();
+    m_lastTStep = m_tStep;
+
+    m_volt = m_lastVolt = m_InitVolt;
+    m_current = m_lastCurr = -m_InitCurr;
+    m_curSource = m_InitCurr;
+
     if( m_ePin[0]->isConnected() && m_ePin[1]->isConnected())
     {
         m_ePin[0]->createCurrent();
         m_ePin[1]->createCurrent();
 
-        updtReactStep();
-
-        m_volt = m_InitVolt;
-        m_curSource = m_InitCurr;
         m_curSource = updtCurr();
 
         if( m_curSource )
@@ -43,12 +51,17 @@ void eReactive::stamp()
             m_ePin[0]->stampCurrent( m_curSource );
             m_ePin[1]->stampCurrent(-m_curSource );
         }
-        //m_ePin[0]->changeCallBack( this );
-        //m_ePin[1]->changeCallBack( this );
+        m_ePin[0]->changeCallBack( this ); // Wake up in AnalogClock
+        m_ePin[1]->changeCallBack( this );
     }
     //m_voltChanged = false;
+}
 
-    updtReactStep();
+void eReactive::voltChanged()
+{
+    if( m_awake ) return;
+    m_awake = true;
+    AnalogClock::self()->wake( this );
 }
 
 /*void eReactive::voltChanged()
@@ -72,26 +85,58 @@ void eReactive::stamp()
 void eReactive::runEvent()
 {
     double volt = m_ePin[0]->getVoltage() - m_ePin[1]->getVoltage();
+    double current = volt*m_admit - m_curSource; // Current at this time, with last step admitance
+    double tStep = m_tStep;                      // Last step
 
-    if( m_volt != volt )
+    AnalogClock* clock = AnalogClock::self();
+    if( clock->adaptive() )  // Local truncation error ~ step²/2 * d²V/dt²
     {
-        /*if( m_voltChanged )
-        {
-            updtReactStep();
-            m_voltChanged = false;
-            m_lastTime = 0;
-        }*/
-        m_volt = volt;
-        m_curSource = updtCurr();
+        double d1 = (volt-m_volt)/tStep;
+        double d0 = (m_volt-m_lastVolt)/m_lastTStep;
+        double lte = (d1-d0)*tStep*tStep/(tStep+m_lastTStep);
+        clock->addError( fabs( lte )/(REACT_ABSTOL + REACT_RELTOL*fabs( volt )) );
+    }
+    m_lastTStep = tStep;
 
-        m_ePin[0]->stampCurrent( m_curSource );
-        m_ePin[1]->stampCurrent(-m_curSource );
+    // Adaptive step changed now, or in last step (Gear2 coefficients depend on both steps)
+    if( m_timeStep != clock->getStep() || m_stepRatio != 1 ) updtReactStep();
+    m_lastVolt = m_volt;
+    m_volt = volt;
+    m_lastCurr = m_current;
+    m_current = current;
+
+    double curSource = updtCurr();
+    if( curSource == m_curSource )   // Nothing changing: sleep until terminal voltage changes
+    {
+        m_lastVolt = m_volt;
+        m_lastCurr = m_current;
+        m_awake = false;
+        return;
     }
+    m_curSource = curSource;
+
+    m_ePin[0]->stampCurrent( m_curSource );
+    m_ePin[1]->stampCurrent(-m_curSource );
 }
 
 void eReactive::updtReactStep()
 {
     m_timeStep = AnalogClock::self()->getStep(); // Time in ps
     m_tStep = (double)m_timeStep/1e12;         // Time in seconds
+
+    m_integration = AnalogClock::self()->integration();
+    m_stepRatio = 1;
+    switch( m_integration ) {
+        case intEULER:       m_intK = 1;   break;
+        case intTRAPEZOIDAL: m_intK = 2;   break;
+        case intGEAR2:                     // Variable step BDF2, w = step/last step
+        {
+            double w = 1;
+            if( m_lastTStep > 0 ) w = m_stepRatio = m_tStep/m_lastTStep;
+            m_intK   = (1+2*w)/(1+w);
+            m_gearK1 = (1+w)*(1+w)/(1+2*w);
+            m_gearK2 = w*w/(1+2*w);
+        } break;
+    }
     eResistor::setResistance( updtRes() );
 }
@@ -6,15 +6,18 @@
 #pragma once
 
 #include "e-resistor.h"
+#include "analogclock.h"
 
 class eReactive : public eResistor
 {
+        friend class AnalogClock;
+
     public:
         eReactive( QString id );
         ~eReactive();
 
         void stamp() override;
-        //void voltChanged() override;
+        void voltChanged() override;
         void runEvent() override;
 
         double initVolt() { return m_InitVolt; }
@@ -29,7 +32,10 @@ class eReactive : public eResistor
         virtual double updtRes(){ return 0.0;}
         virtual double updtCurr(){ return 0.0;}
 
-        //bool m_voltChanged;
+        inline double histVolt() { return (m_integration == intGEAR2) ? m_gearK1*m_volt-m_gearK2*m_lastVolt    : m_volt; }
+        inline double histCurr() { return (m_integration == intGEAR2) ? m_gearK1*m_current-m_gearK2*m_lastCurr : m_current; }
+
+        bool m_awake;       // In AnalogClock active list
 
         double m_value; // Capacitance or Inductance
 
@@ -38,8 +44,18 @@ class eReactive : public eResistor
 
         double m_InitVolt;
         double m_volt;
+        double m_lastVolt;
+        double m_current;   // Branch current: m_volt*m_admit-m_curSource
+        double m_lastCurr;
 
         double m_tStep;
+        double m_lastTStep;
+        double m_intK;      // Companion admitance factor: Euler 1, Trapezoidal 2, Gear2 1.5 at constant step
+        double m_stepRatio; // Gear2: this step/last step
+        double m_gearK1;    // Gear2 history: K1*x(n)-K2*x(n-1)
+        double m_gearK2;
+
+        integration_t m_integration;
 
         uint64_t m_timeStep;
         //uint64_t m_lastTime;
@@ -0,0 +1,347 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <QElapsedTimer>
+
+#include "lukernel.h"
+
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define LUKERNEL_X86
+#include <immintrin.h>
+#endif
+
+//------------------------------------------------------------
+// Portable kernels
+
+static double dotScalar( const double* a, const double* b, int n )
+{
+    double tot = 0;
+    for( int i=0; i<n; ++i ) tot += a[i]*b[i];
+    return tot;
+}
+
+static void axpyScalar( double* w, double q, const double* u, int from, int to ) // w -= q*u
+{
+    for( int i=from; i<to; ++i ) w[i] -= q*u[i];
+}
+
+static void axpy4Scalar( double* w, const double* q, const double* const* u, int from, int to )
+{
+    const double* u0 = u[0]; const double* u1 = u[1];
+    const double* u2 = u[2]; const double* u3 = u[3];
+    for( int i=from; i<to; ++i ) w[i] -= q[0]*u0[i] + q[1]*u1[i] + q[2]*u2[i] + q[3]*u3[i];
+}
+
+#ifdef LUKERNEL_X86
+//------------------------------------------------------------
+// SSE2 kernels
+
+__attribute__((target("sse2")))
+static double dotSSE2( const double* a, const double* b, int n )
+{
+    __m128d s0 = _mm_setzero_pd();
+    __m128d s1 = _mm_setzero_pd();
+    int i = 0;
+    for( ; i+4<=n; i+=4 )
+    {
+        s0 = _mm_add_pd( s0, _mm_mul_pd( _mm_loadu_pd( a+i   ), _mm_loadu_pd( b+i   ) ) );
+        s1 = _mm_add_pd( s1, _mm_mul_pd( _mm_loadu_pd( a+i+2 ), _mm_loadu_pd( b+i+2 ) ) );
+    }
+    s0 = _mm_add_pd( s0, s1 );
+    double tot = _mm_cvtsd_f64( _mm_add_sd( s0, _mm_unpackhi_pd( s0, s0 ) ) );
+    for( ; i<n; ++i ) tot += a[i]*b[i];
+    return tot;
+}
+
+__attribute__((target("sse2")))
+static void axpySSE2( double* w, double q, const double* u, int from, int to )
+{
+    int i = from;
+    if( (i & 1) && i<to ) { w[i] -= q*u[i]; ++i; } // Rows are aligned: align to 16 bytes
+
+    __m128d vq = _mm_set1_pd( q );
+    for( ; i+2<=to; i+=2 )
+        _mm_store_pd( w+i, _mm_sub_pd( _mm_load_pd( w+i ), _mm_mul_pd( vq, _mm_load_pd( u+i ) ) ) );
+
+    for( ; i<to; ++i ) w[i] -= q*u[i];
+}
+
+__attribute__((target("sse2")))
+static void axpy4SSE2( double* w, const double* q, const double* const* u, int from, int to )
+{
+    const double* u0 = u[0]; const double* u1 = u[1];
+    const double* u2 = u[2]; const double* u3 = u[3];
+    int i = from;
+    if( (i & 1) && i<to ) { w[i] -= q[0]*u0[i] + q[1]*u1[i] + q[2]*u2[i] + q[3]*u3[i]; ++i; }
+
+    __m128d q0 = _mm_set1_pd( q[0] ); __m128d q1 = _mm_set1_pd( q[1] );
+    __m128d q2 = _mm_set1_pd( q[2] ); __m128d q3 = _mm_set1_pd( q[3] );
+    for( ; i+2<=to; i+=2 )
+    {
+        __m128d s = _mm_add_pd( _mm_mul_pd( q0, _mm_load_pd( u0+i ) ), _mm_mul_pd( q1, _mm_load_pd( u1+i ) ) );
+        s = _mm_add_pd( s, _mm_add_pd( _mm_mul_pd( q2, _mm_load_pd( u2+i ) ), _mm_mul_pd( q3, _mm_load_pd( u3+i ) ) ) );
+        _mm_store_pd( w+i, _mm_sub_pd( _mm_load_pd( w+i ), s ) );
+    }
+    for( ; i<to; ++i ) w[i] -= q[0]*u0[i] + q[1]*u1[i] + q[2]*u2[i] + q[3]*u3[i];
+}
+
+//------------------------------------------------------------
+// AVX2 kernels
+
+__attribute__((target("avx2,fma")))
+static double dotAVX2( const double* a, const double* b, int n )
+{
+    __m256d s0 = _mm256_setzero_pd();
+    __m256d s1 = _mm256_setzero_pd();
+    int i = 0;
+    for( ; i+8<=n; i+=8 )
+    {
+        s0 = _mm256_fmadd_pd( _mm256_loadu_pd( a+i   ), _mm256_loadu_pd( b+i   ), s0 );
+        s1 = _mm256_fmadd_pd( _mm256_loadu_pd( a+i+4 ), _mm256_loadu_pd( b+i+4 ), s1 );
+    }
+    s0 = _mm256_add_pd( s0, s1 );
+    __m128d s = _mm_add_pd( _mm256_castpd256_pd128( s0 ), _mm256_extractf128_pd( s0, 1 ) );
+    double tot = _mm_cvtsd_f64( _mm_add_sd( s, _mm_unpackhi_pd( s, s ) ) );
+    for( ; i<n; ++i ) tot += a[i]*b[i];
+    return tot;
+}
+
+__attribute__((target("avx2,fma")))
+static void axpyAVX2( double* w, double q, const double* u, int from, int to )
+{
+    int i = from;
+    for( ; (i & 3) && i<to; ++i ) w[i] -= q*u[i]; // Rows are aligned: align to 32 bytes
+
+    __m256d vq = _mm256_set1_pd( q );
+    for( ; i+4<=to; i+=4 )
+        _mm256_store_pd( w+i, _mm256_fnmadd_pd( vq, _mm256_load_pd( u+i ), _mm256_load_pd( w+i ) ) );
+
+    for( ; i<to; ++i ) w[i] -= q*u[i];
+}
+
+__attribute__((target("avx2,fma")))
+static void axpy4AVX2( double* w, const double* q, const double* const* u, int from, int to )
+{
+    const double* u0 = u[0]; const double* u1 = u[1];
+    const double* u2 = u[2]; const double* u3 = u[3];
+    int i = from;
+    for( ; (i & 3) && i<to; ++i ) w[i] -= q[0]*u0[i] + q[1]*u1[i] + q[2]*u2[i] + q[3]*u3[i];
+
+    __m256d q0 = _mm256_set1_pd( q[0] ); __m256d q1 = _mm256_set1_pd( q[1] );
+    __m256d q2 = _mm256_set1_pd( q[2] ); __m256d q3 = _mm256_set1_pd( q[3] );
+    for( ; i+4<=to; i+=4 )
+    {
+        __m256d v = _mm256_load_pd( w+i );
+        v = _mm256_fnmadd_pd( q0, _mm256_load_pd( u0+i ), v );
+        v = _mm256_fnmadd_pd( q1, _mm256_load_pd( u1+i ), v );
+        v = _mm256_fnmadd_pd( q2, _mm256_load_pd( u2+i ), v );
+        v = _mm256_fnmadd_pd( q3, _mm256_load_pd( u3+i ), v );
+        _mm256_store_pd( w+i, v );
+    }
+    for( ; i<to; ++i ) w[i] -= q[0]*u0[i] + q[1]*u1[i] + q[2]*u2[i] + q[3]*u3[i];
+}
+#endif
+
+//------------------------------------------------------------
+
+kernel_t         LuKernel::m_kernel = Kernel_Scalar;
+LuKernel::dot_t   LuKernel::m_dot   = dotScalar;
+LuKernel::axpy_t  LuKernel::m_axpy  = axpyScalar;
+LuKernel::axpy4_t LuKernel::m_axpy4 = axpy4Scalar;
+
+void LuKernel::init()
+{
+    if     ( setKernel( Kernel_AVX2 ) ) return;
+    else if( setKernel( Kernel_SSE2 ) ) return;
+    setKernel( Kernel_Scalar );
+}
+
+bool LuKernel::supported( kernel_t k )
+{
+    switch( k ){
+        case Kernel_Scalar: return true;
+#ifdef LUKERNEL_X86
+        case Kernel_SSE2: return __builtin_cpu_supports("sse2");
+        case Kernel_AVX2: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+        default: return false;
+    }
+}
+
+bool LuKernel::setKernel( kernel_t k )
+{
+    if( !supported( k ) ) return false;
+
+    m_kernel = k;
+    switch( k ){
+#ifdef LUKERNEL_X86
+        case Kernel_SSE2: m_dot = dotSSE2; m_axpy = axpySSE2; m_axpy4 = axpy4SSE2; break;
+        case Kernel_AVX2: m_dot = dotAVX2; m_axpy = axpyAVX2; m_axpy4 = axpy4AVX2; break;
+#endif
+        default:          m_dot = dotScalar; m_axpy = axpyScalar; m_axpy4 = axpy4Scalar;
+    }
+    return true;
+}
+
+const char* LuKernel::name( kernel_t k )
+{
+    switch( k ){
+        case Kernel_SSE2: return "SSE2";
+        case Kernel_AVX2: return "AVX2";
+        default:          return "Scalar";
+    }
+}
+
+// Row by row (Doolittle) factorization, rows are updated by blocks of 4 previous rows.
+// Padding columns are zero, so row updates go up to stride without remainder loops.
+void LuKernel::factor( const double* a, double* lu, int n, int stride, int first )
+{
+    for( int row=first; row<n; ++row )
+    {
+        const double* ar = a + row*stride;
+        double* w = lu + row*stride;
+
+        for( int col=first; col<stride; ++col ) w[col] = ar[col]; // Lower cols before first didn't change
+
+        double q[4];
+        const double* u[4];
+        int k = 0;
+        for( ; k+4<=first; k+=4 )             // Lower factors before first are already normalized
+        {
+            for( int i=0; i<4; ++i ){ q[i] = w[k+i]; u[i] = lu + (k+i)*stride; }
+            if( q[0] == 0 && q[1] == 0 && q[2] == 0 && q[3] == 0 ) continue;
+            m_axpy4( w, q, u, first, stride );
+        }
+        for( ; k<first; ++k ) if( w[k] != 0 ) m_axpy( w, w[k], lu + k*stride, first, stride );
+
+        for( ; k+4<=row; k+=4 )
+        {
+            for( int i=0; i<4; ++i )          // Normalize respect to diagonal, update inside block
+            {
+                u[i] = lu + (k+i)*stride;
+                double qi = w[k+i];
+                double div = u[i][k+i];
+                if( div != 0 ) qi /= div;
+                w[k+i] = qi;
+                q[i] = qi;
+                for( int j=i+1; j<4; ++j ) w[k+j] -= qi*u[i][k+j];
+            }
+            if( q[0] == 0 && q[1] == 0 && q[2] == 0 && q[3] == 0 ) continue;
+            m_axpy4( w, q, u, k+4, stride );
+        }
+        for( ; k<row; ++k )
+        {
+            const double* uk = lu + k*stride;
+            double qk = w[k];
+            double div = uk[k];
+            if( div != 0 ) qk /= div;
+            w[k] = qk;
+            if( qk != 0 ) m_axpy( w, qk, uk, k+1, stride );
+        }
+    }
+}
+
+bool LuKernel::solve( const double* lu, int n, int stride, const double* b, double* x )
+{
+    int i;
+    for( i=0; i<n; ++i )
+    {
+        x[i] = b[i];
+        if( b[i] != 0 ) break; // First nonzero b element
+    }
+    int bi = i++;
+    for( ; i<n; ++i )          // Forward substitution from lower triangular matrix
+    {
+        const double* ar = lu + i*stride;
+        x[i] = b[i] - m_dot( ar+bi, x+bi, i-bi );
+    }
+    bool isOk = true;
+
+    for( i=n-1; i>=0; --i )    // Back substitution from upper triangular matrix
+    {
+        const double* ar = lu + i*stride;
+        double tot = x[i] - m_dot( ar+i+1, x+i+1, n-i-1 );
+
+        double div = ar[i];
+        double volt = 0;
+        if( div != 0 ) volt = tot/div;
+        else isOk = false;
+
+        x[i] = volt;
+    }
+    return isOk;
+}
+
+void LuKernel::benchmark()
+{
+    kernel_t best = m_kernel;
+    const int sizes[] = { 4, 8, 16, 32, 64, 128, 256, 512 };
+
+    printf("\nLU kernels benchmark, selected kernel: %s\n\n", name( best ) );
+    printf("%6s %8s %14s %14s %14s %12s\n", "Nodes", "Kernel", "Factor(ns)", "Partial(ns)", "Solve(ns)", "Residual" );
+
+    for( int n : sizes )
+    {
+        int stride = (n+7) & ~7;
+        std::vector<double> data( 2*stride*n + 3*stride + 8, 0 );
+        uintptr_t p = (uintptr_t)data.data();
+        double* a  = (double*)((p+63) & ~(uintptr_t)63);
+        double* lu = a  + stride*n;
+        double* b  = lu + stride*n;
+        double* x  = b  + stride;
+        double* r  = x  + stride;
+
+        uint32_t seed = 12345;                         // Circuit like Matrix: diagonal dominant, sparse
+        auto rnd = [&seed](){ seed = seed*1103515245 + 12345; return (seed>>16) & 0x7FFF; };
+        for( int row=0; row<n; ++row )
+        {
+            double diag = 1e-3;
+            for( int col=0; col<n; ++col )
+            {
+                if( col == row || rnd()%4 ) continue;
+                double adm = 1.0/(1+rnd()%1000);
+                a[row*stride+col] = -adm;
+                diag += adm;
+            }
+            a[row*stride+row] = diag + 1.0/(1+rnd()%100);
+            b[row] = (rnd()%200)-100;
+        }
+        double ops = (double)n*n*n;
+        int reps = ops > 1e8 ? 1 : (int)(1e8/ops);
+
+        for( int k=Kernel_Scalar; k<=Kernel_AVX2; ++k )
+        {
+            if( !setKernel( (kernel_t)k ) ) continue;
+
+            QElapsedTimer timer;
+            timer.start();
+            for( int i=0; i<reps; ++i ) factor( a, lu, n, stride, 0 );
+            double factTime = (double)timer.nsecsElapsed()/reps;
+
+            timer.restart();
+            for( int i=0; i<reps; ++i ) factor( a, lu, n, stride, n/2 );
+            double partTime = (double)timer.nsecsElapsed()/reps;
+
+            int solveReps = reps*n;
+            timer.restart();
+            for( int i=0; i<solveReps; ++i ) solve( lu, n, stride, b, x );
+            double solveTime = (double)timer.nsecsElapsed()/solveReps;
+
+            double residual = 0;
+            for( int row=0; row<n; ++row )
+            {
+                r[row] = b[row] - dotScalar( a+row*stride, x, n );
+                residual = std::fmax( residual, std::fabs( r[row] ) );
+            }
+            printf("%6i %8s %14.0f %14.0f %14.0f %12.2e\n", n, name( (kernel_t)k ), factTime, partTime, solveTime, residual );
+        }
+    }
+    printf("\n");
+    setKernel( best );
+}
@@ -0,0 +1,43 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#pragma once
+
+// Dense LU kernels for flat row major matrices with rows padded to 8 doubles.
+// SIMD code paths are selected at runtime for the running CPU.
+
+enum kernel_t{
+    Kernel_Scalar=0,
+    Kernel_SSE2,
+    Kernel_AVX2,
+};
+
+class LuKernel
+{
+    public:
+ static void init();              // Select best kernel for this CPU
+
+ static kernel_t kernel() { return m_kernel; }
+ static bool setKernel( kernel_t k ); // false if not supported by this CPU
+ static const char* name( kernel_t k );
+
+        // Factor a into lu from row/col first, rows and cols before it are already factored
+ static void factor( const double* a, double* lu, int n, int stride, int first );
+ static bool solve( const double* lu, int n, int stride, const double* b, double* x );
+
+ static void benchmark();         // Compare kernels for group sizes 4 to 512
+
+    private:
+        typedef double (*dot_t)( const double* a, const double* b, int n );
+        typedef void (*axpy_t)( double* w, double q, const double* u, int from, int to );
+        typedef void (*axpy4_t)( double* w, const double* q, const double* const* u, int from, int to );
+
+ static bool supported( kernel_t k );
+
+ static kernel_t m_kernel;
+ static dot_t    m_dot;
+ static axpy_t   m_axpy;
+ static axpy4_t  m_axpy4;
+};
@@ -5,6 +5,7 @@
 
 #include <qtconcurrentrun.h>
 #include <QHash>
+#include <QThread>
 #include <math.h>
 
 #include "simulator.h"
@@ -29,6 +30,11 @@ Simulator::Simulator( QObject* parent )
 {
     m_pSelf = this;
 
+    m_eventSeq = 0;
+    m_headless = false;
+    m_freeRun  = false;
+    m_guiSync  = SYNC_NONE;
+    m_framePublished = false;
     m_matrix = new CircMatrix();
     addToElementList( &m_analogClock );
     addToUpdateList( &m_analogClock );
@@ -40,6 +46,8 @@ Simulator::Simulator( QObject* parent )
     m_stepSize  = 1e6;
     m_stepsPS   = 1e6;
     m_maxNlstp  = 100000;
+    m_nlAbsTol  = 1e-3;
+    m_nlRelTol  = 1e-3;
     m_slopeSteps = 0;
 
     m_errors[0] = "";
@@ -71,6 +79,7 @@ inline void Simulator::solveMatrix()
     //if( !m_matrix->solveMatrix() ) // m_matrix sets the eNode voltages
     //    m_warning = 2;             // Warning if diagonal element = 0.
     m_matrix->solveMatrix(); // m_matrix sets the eNode voltages
+    m_solveCount++;
 }
 
 void Simulator::timerEvent( QTimerEvent* e )  //update at m_timerTick_ms rate (50 ms, 20 Hz max)
@@ -80,8 +89,9 @@ void Simulator::timerEvent( QTimerEvent* e )  //update at m_timerTick_ms rate (5
     if( m_state == SIM_WAITING ) return;
 
     // Get Simulation times
-    m_simPsPF = m_circTime-m_tStep;
-    m_tStep   = m_circTime;
+    uint64_t circTime = m_snapTime.load( std::memory_order_acquire );
+    m_simPsPF = circTime-m_tStep;
+    m_tStep   = circTime;
 
 #ifdef DEBUG_EVENTS
     double simMilis = (double)m_simPsPF/1e9;
@@ -91,6 +101,8 @@ void Simulator::timerEvent( QTimerEvent* e )  //update at m_timerTick_ms rate (5
     if( m_totEvents && m_findEvents ) finds = (double)m_findEvents/(double)m_totEvents;
 
     qDebug() << "Simulator::timerEvent" << m_totEvents<< eventPerMili << finds << m_maxfinds << m_maxEvents << m_events;
+    qDebug() << "AnalogClock wakes" << m_analogClock.wakes() << "sleeps" << m_analogClock.sleeps() << "active" << m_analogClock.active();
+    m_analogClock.resetCounters();
     m_maxEvents = 0;
     m_totEvents = 0;
     m_findEvents = 0;
@@ -123,17 +135,31 @@ void Simulator::timerEvent( QTimerEvent* e )  //update at m_timerTick_ms rate (5
     else if( m_warning < 0 )
     { if( ++m_warning == 0 ) CircuitWidget::self()->setMsg( " "+tr("Running")+" ", 0 ); }
 
-    if( !m_CircuitFuture.isFinished() ) // Stop remaining parallel thread
+    bool syncUpdate = false;  // Some Updatables need simulation stopped
+    for( Updatable* el : m_updateList ) if( !el->concurrent() ) { syncUpdate = true; break; }
+
+    bool freeRunning = m_freeRun && !m_CircuitFuture.isFinished();
+    bool synced = false;
+    if( syncUpdate )
     {
-        simState_t state = m_state;
-        m_state = SIM_WAITING;
-        m_CircuitFuture.waitForFinished();
-        //while( m_state == SIM_WAITING ){;}
-        m_state = state;
-    }
+        if( !freeRunning ) synced = holdSim();
+        else if( m_timerTime-m_freeSyncTime >= FREE_SYNC_NS ) // Free running: hold at frame boundary, rate limited
+        {
+            synced = holdSim();
+            m_freeSyncTime = m_timerTime;
+    }   }
+
+    bool simStopped = synced || m_CircuitFuture.isFinished(); // Otherwise only concurrent Updatables
+    bool framePublished = simStopped && m_framePublished.exchange( false ); // runCircuit() already published concurrent Updatables
+
     if( m_debug && m_state == SIM_PAUSED ) CircuitWidget::self()->debugPaused();
 
-    for( Updatable* el : m_updateList ) el->updateStep();
+    for( Updatable* el : m_updateList )
+    {
+        if( !simStopped && !el->concurrent() ) continue; // Free running: updated at next sync
+        if( simStopped && !(framePublished && el->concurrent()) ) el->publish();
+        el->updateStep();
+    }
     EditorWindow::self()->outPane()->updateStep(); // OutPanel in Editor can be created before this simulator.
 
     // Calculate Simulation Load
@@ -142,10 +168,17 @@ void Simulator::timerEvent( QTimerEvent* e )  //update at m_timerTick_ms rate (5
     if( m_loopTime > m_refTime ) simLoop = m_loopTime-m_refTime;
     m_simLoad = (m_simLoad+100*simLoop/timer_ns)/2;
 
-
-
-    if( m_state == SIM_RUNNING ) // Run Circuit in a parallel thread
-        m_CircuitFuture = QtConcurrent::run( [=](){ runCircuit(); } );
+    if( !m_CircuitFuture.isFinished() )   // Simulation thread continues
+    {
+        m_guiSync = SYNC_NONE;
+        if( freeRunning ) m_simLoad = 100;
+    }
+    else if( m_state == SIM_RUNNING ) // Run Circuit in a parallel thread
+    {
+        m_guiSync = SYNC_NONE;
+        if( m_freeRun ) m_CircuitFuture = QtConcurrent::run( [=](){ runFree(); } );
+        else            m_CircuitFuture = QtConcurrent::run( [=](){ runCircuit( m_circTime+m_psPF ); } ); // Run upto next Timer event
+    }
 
     if( Circuit::self()->animateLogic() ) // Moved here to be in parallel with runCircuit thread
     {
@@ -238,54 +271,120 @@ void Simulator::timerEvent( QTimerEvent* e )  //update at m_timerTick_ms rate (5
 //    //else if( m_state == SIM_WAITING ) m_state = SIM_PAUSED;
 //}
 
-void Simulator::runCircuit()
+void Simulator::runCircuit( uint64_t endRun )
 {
+    m_endRun = endRun;
+    m_framePublished = false;              // State changes from here: GUI publishes if frame is not completed
     solveCircuit();                        // Solve any pending changes
     if( m_state < SIM_RUNNING ) return;
 
     eElement* event;
-    uint64_t endRun = m_circTime + m_psPF; // Run upto next Timer event
     uint64_t nextTime;
 
     while( true )          // Simulator event loop
     {
-        //if( QemuDevice::self() )
-        //{
-        //    if( m_firstEvent ) nextTime = m_firstEvent->eventTime;
-        //    else               nextTime = m_circTime + 1000000000;
+        if( m_eventHeap.empty() ) break;
 
-        //    QemuDevice::self()->runToTime( nextTime ); // This will add events
-        //}
-        if( !m_firstEvent ) break;
 
-
-        nextTime = m_firstEvent->eventTime;
+        nextTime = m_eventHeap[0]->eventTime;
         if( nextTime > endRun ) break;           // All events for this Timer Tick are done
 
         m_circTime = nextTime;
         while( m_circTime == nextTime )          // Run all event with same timeStamp
         {
-            event = m_firstEvent;
-            m_firstEvent = event->nextEvent;
+            // Qemu answers processed before any other event: only consecutive releases overlap
+            if( !m_qemuPending.empty() && !dynamic_cast<QemuDevice*>( m_eventHeap[0] ) ) syncQemu();
 
-            event->nextEvent = nullptr;          // free Event
-            event->eventTime = 0;
+            event = popEvent();                  // free Event
             event->runEvent();                   // Run event callback
+            m_eventCount++;
 #ifdef DEBUG_EVENTS
             m_events--;
 #endif
-            if( !m_firstEvent ) break;
+            if( m_eventHeap.empty() ) break;
 
-            nextTime = m_firstEvent->eventTime;
+            nextTime = m_eventHeap[0]->eventTime;
         }
+        if( !m_qemuPending.empty() ) syncQemu(); // Qemu devices add their next events
         solveCircuit();
         if( m_state < SIM_RUNNING ) break;
     }
     m_loopTime = m_RefTimer.nsecsElapsed();
 
-    if     ( m_state >  SIM_WAITING ) m_circTime = endRun;
+    if( m_state > SIM_WAITING )  // Frame completed
+    {
+        m_circTime = endRun;
+        for( Updatable* el : m_updateList ) if( el->concurrent() ) el->publish();
+        m_framePublished = true;
+    }
     //else if( m_state == SIM_WAITING ) m_state = SIM_PAUSED;
     //qDebug() << "\n---------------------------------------------\n";
+    m_snapTime.store( m_circTime, std::memory_order_release );
+}
+
+bool Simulator::holdSim() // Called from GUI thread, returns true if thread is paused (release needed)
+{
+    if( m_CircuitFuture.isFinished() ) return false;
+
+    if( m_freeRun )           // Wait until simulation thread reaches a frame boundary
+    {
+        m_guiSync = SYNC_REQUEST;
+        while( m_guiSync != SYNC_PAUSED && !m_CircuitFuture.isFinished() ) QThread::yieldCurrentThread();
+        return true;
+    }
+    simState_t state = m_state; // Stop remaining parallel thread
+    m_state = SIM_WAITING;
+    m_CircuitFuture.waitForFinished();
+    m_state = state;
+    return false;
+}
+
+void Simulator::releaseSim()
+{
+    if( !m_CircuitFuture.isFinished() ) m_guiSync = SYNC_NONE;
+}
+
+void Simulator::runFree() // Run continuously, GUI updates components at frame boundaries
+{
+    while( m_state == SIM_RUNNING && m_freeRun )
+    {
+        runCircuit( m_circTime+m_psPF );
+
+        if( m_guiSync == SYNC_REQUEST )
+        {
+            m_guiSync = SYNC_PAUSED;
+            while( m_guiSync == SYNC_PAUSED && m_state == SIM_RUNNING ) QThread::yieldCurrentThread();
+        }
+    }
+}
+
+void Simulator::gminStep() // Add gmin to PN junctions and reduce it each time they converge
+{
+    if( m_gmin == 0 ){
+        m_gmin = NL_GMIN_START;
+        m_nlStats.gminSteps++;
+    }else{
+        m_gmin *= 0.1;
+        if( m_gmin < NL_GMIN_END ) m_gmin = 0; // Last iterations without gmin
+    }
+    for( eNode* node : m_nonLinNodes ) node->wakeNonLinear(); // Stamp again with new gmin
+    m_converged = false;
+}
+
+void Simulator::runHeadless( uint64_t endTime ) // Run as fast as possible upto endTime, 0 = until stopped
+{
+    while( m_state == SIM_RUNNING && !m_error )
+    {
+        uint64_t endRun = m_circTime + m_psPF; // Updatables are updated at the same simulation time rate
+        if( endTime && endRun > endTime ) endRun = endTime;
+
+        runCircuit( endRun );
+        if( m_state < SIM_RUNNING ) break;
+
+        for( Updatable* el : m_updateList ) el->updateStep(); // Test Units finish here
+
+        if( endTime && m_circTime >= endTime ) break;
+    }
 }
 
 void Simulator::solveCircuit()
@@ -303,13 +402,32 @@ void Simulator::solveCircuit()
                 m_nonLinear->voltChanged();
                 m_nonLinear = m_nonLinear->nextChanged;
             }
-            if( m_maxNlstp && (m_NLstep++ >= m_maxNlstp) ) { m_warning = 1; return; } // Max iterations reached
+            if( !m_diodeBatch.empty() ) m_diodeBatch.evaluate(); // Stamp eDiodes queued in voltChanged()
+            m_NLstep++;
+            if( m_gmin > 0 ){                                      // Gmin stepping
+                if( m_converged ) gminStep();                      // Converged with this gmin: reduce it
+            }
+            else if( !m_converged && m_NLstep == NL_GMIN_ITER ) gminStep(); // Not converging: start gmin stepping
+
+            if( m_maxNlstp && (m_NLstep > m_maxNlstp) )            // Max iterations reached
+            {
+                if( m_warning != 1 ) m_nlStats.failures++;
+                m_warning = 1;
+                return;
+            }
             if( m_state < SIM_RUNNING ){ m_converged = false; break; }    // Loop broken without converging
             if( m_changedNode ) solveMatrix();
         }
         if( !m_converged ) return; // Don't run linear until nonliear converged (Loop broken)
 
-        m_NLstep = 0;
+        if( m_NLstep )
+        {
+            m_nlStats.steps++;
+            m_nlStats.iterations += m_NLstep;
+            m_nlStats.lastIter = m_NLstep;
+            if( m_NLstep > m_nlStats.maxIter ) m_nlStats.maxIter = m_NLstep;
+            m_NLstep = 0;
+        }
         while( m_voltChanged )
         {
             m_voltChanged->added = false;
@@ -331,8 +449,16 @@ void Simulator::resetSim()
     m_tStep    = 0;
     m_lastRefT = 0;
     m_circTime = 1;
+    m_snapTime = 1;
+    m_framePublished = false;
+    m_endRun   = 0;
+    m_eventCount = 0;
+    m_solveCount = 0;
     m_updtTime = 0;
+    m_freeSyncTime = 0;
     m_NLstep   = 0;
+    m_gmin     = 0;
+    m_nlStats  = nlStats_t();
     ///m_pauseCirc = false;
     m_simPsPF = 1;
 
@@ -341,6 +467,7 @@ void Simulator::resetSim()
     m_changedNode = nullptr;
     m_voltChanged = nullptr;
     m_nonLinear = nullptr;
+    m_diodeBatch.reset();
 
 #ifdef DEBUG_EVENTS
     m_events = 0;
@@ -421,7 +548,11 @@ void Simulator::startSim( bool paused )
     }
     for( eElement* el : m_elementList ) el->stamp();
 
+    m_nonLinNodes.clear();
+    for( eNode* enode : m_eNodeList ) if( enode->hasNonLinear() ) m_nonLinNodes.push_back( enode );
+
     m_matrix->createMatrix( m_eNodeList );
+    m_eventHeap.reserve( m_elementList.size() ); // Each eElement can be queued only once
 
     /// qDebug() << "\nCircuit Matrix looks good";
 
@@ -444,6 +575,9 @@ void Simulator::startSim( bool paused )
     else m_state = SIM_RUNNING;
 
     if( m_timerId != 0 ) this->killTimer( m_timerId );               // Stop Timer
+    m_timerId = 0;
+    if( m_headless ) return;
+
     m_refTime  = m_RefTimer.nsecsElapsed();
     m_loopTime = m_refTime;
     m_timerTime = m_loopTime;
@@ -467,7 +601,7 @@ void Simulator::stopSim()
 
     for( eNode* node  : m_eNodeList  )  node->setVolt( 0 );
     for( eElement* el : m_elementList ) el->initialize();
-    for( Updatable* el : m_updateList ) el->updateStep();
+    for( Updatable* el : m_updateList ) { el->publish(); el->updateStep(); }
 
     clearEventList();
     m_changedNode = nullptr;
@@ -518,9 +652,97 @@ void Simulator::setPsPerSec( uint64_t psPs )
     InfoWidget::self()->setTargetSpeed( 100*m_psPerSec/1e12 );
 }
 
+void Simulator::syncQemu() // Released Qemu devices run in parallel, we wait all of them here
+{
+    while( !m_qemuPending.empty() )
+    {
+        std::vector<QemuDevice*> pending;
+        pending.swap( m_qemuPending );
+
+        if( pending.size() == 1 ) pending[0]->qemuReady( pending[0]->waitQemu() );
+        else{
+            for( QemuDevice* dev : pending ) dev->startWait();
+            for( QemuDevice* dev : pending ) dev->qemuReady( dev->finishWait() ); // Always same order
+        }
+    }
+}
+
+uint64_t Simulator::burstLimit() // Nothing outside an MCU can change before this time
+{
+    if( m_changedNode || m_voltChanged || m_nonLinear || !m_converged ) return 0; // Circuit not solved yet
+    if( !m_qemuPending.empty() ) return 0;
+
+    uint64_t limit = m_endRun;
+    if( !m_eventHeap.empty() && m_eventHeap[0]->eventTime < limit ) limit = m_eventHeap[0]->eventTime;
+    return limit;
+}
+
 void Simulator::clearEventList()
 {
-    m_firstEvent = nullptr;
+    m_qemuPending.clear();
+    for( eElement* el : m_eventHeap ){
+        el->eventTime  = 0;
+        el->eventIndex = -1;
+    }
+    m_eventHeap.clear();
+    m_eventSeq = 0;
+}
+
+void Simulator::eventUp( int i ) // Move event up until parent goes first
+{
+    eElement* el = m_eventHeap[i];
+    while( i > 0 )
+    {
+        int parent = (i-1)>>1;
+        eElement* pEl = m_eventHeap[parent];
+        if( !eventFirst( el, pEl ) ) break;
+#ifdef DEBUG_EVENTS
+        m_findEvents++;
+#endif
+        m_eventHeap[i] = pEl;
+        pEl->eventIndex = i;
+        i = parent;
+    }
+    m_eventHeap[i] = el;
+    el->eventIndex = i;
+}
+
+void Simulator::eventDown( int i ) // Move event down until it goes before children
+{
+    int size = m_eventHeap.size();
+    eElement* el = m_eventHeap[i];
+    while( true )
+    {
+        int child = 2*i+1;
+        if( child >= size ) break;
+        if( child+1 < size && eventFirst( m_eventHeap[child+1], m_eventHeap[child] ) ) child++;
+
+        eElement* cEl = m_eventHeap[child];
+        if( !eventFirst( cEl, el ) ) break;
+#ifdef DEBUG_EVENTS
+        m_findEvents++;
+#endif
+        m_eventHeap[i] = cEl;
+        cEl->eventIndex = i;
+        i = child;
+    }
+    m_eventHeap[i] = el;
+    el->eventIndex = i;
+}
+
+eElement* Simulator::popEvent()
+{
+    eElement* event = m_eventHeap[0];
+    eElement* last  = m_eventHeap.back();
+    m_eventHeap.pop_back();
+
+    if( last != event ){
+        m_eventHeap[0] = last;
+        eventDown( 0 );
+    }
+    event->eventIndex = -1;
+    event->eventTime  = 0;
+    return event;
 }
 
 void Simulator::addEventAt( uint64_t time, eElement* el )
@@ -532,61 +754,46 @@ void Simulator::addEventAt( uint64_t time, eElement* el )
         //qDebug() << "Warning: Simulator::addEvent Repeated event"<<el->getId()<<el->eventTime<<time + m_circTime;
         return;
     }
-
-    eElement* last  = nullptr;
-    eElement* event = m_firstEvent;
+    el->eventTime = time;
+    el->eventSeq  = ++m_eventSeq;  // Same time: last added runs first
 
 #ifdef DEBUG_EVENTS
-    uint64_t finds = 0;
+    uint64_t finds = m_findEvents;
 #endif
 
-    while( event )
-    {
-#ifdef DEBUG_EVENTS
-        finds++;
-#endif
-        if( time <= event->eventTime ) break; // Insert event here
-        last  = event;
-        event = event->nextEvent;
-    }
-    el->eventTime = time;
+    m_eventHeap.push_back( el );
+    eventUp( m_eventHeap.size()-1 );
 
 #ifdef DEBUG_EVENTS
+    finds = m_findEvents-finds;
     if( finds > m_maxfinds ) m_maxfinds = finds;
     m_events++;
     m_totEvents++;
-    m_findEvents += finds;
     if( m_events > m_maxEvents ) m_maxEvents = m_events;
 #endif
-
-    if( last ) last->nextEvent = el;
-    else       m_firstEvent = el; // List was empty or insert First
-
-    el->nextEvent = event;
 }
 
 void Simulator::cancelEvents( eElement* el )
 {
     if( el->eventTime == 0 ) return;
-    eElement* event = m_firstEvent;
-    eElement* last  = nullptr;
-    eElement* next  = nullptr;
     el->eventTime = 0;
 
-    while( event ){
-        next = event->nextEvent;
-        if( el == event )
-        {
-            if( last ) last->nextEvent = next;
-            else       m_firstEvent = next;
-            event->nextEvent = nullptr;
+    int i = el->eventIndex;
+    if( i < 0 ) return;
+    el->eventIndex = -1;
+
+    eElement* last = m_eventHeap.back();
+    m_eventHeap.pop_back();
+    if( last != el )               // Fill the gap with last event and restore heap order
+    {
+        m_eventHeap[i] = last;
+        eventDown( i );
+        if( last->eventIndex == i ) eventUp( i );
+    }
 #ifdef DEBUG_EVENTS
-            m_events--;
+    m_events--;
 #endif
-        }
-        else last = event;
-        event = next;
-}   }
+}
 
 void Simulator::addToEnodeList( eNode* nod )
 { if( !m_eNodeList.contains(nod) ) m_eNodeList.append( nod ); }
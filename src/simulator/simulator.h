@@ -10,6 +10,7 @@
 #include "e-node.h"
 #include "e-element.h"
 #include "analogclock.h"
+#include "diodebatch.h"
 
 enum simState_t{
     SIM_STOPPED=0,
@@ -21,8 +22,33 @@ enum simState_t{
     SIM_DEBUG,
 };
 
+struct nlStats_t{        // Newton-Raphson iterations
+    uint64_t steps;      // Nonlinear solutions
+    uint64_t iterations; // Total iterations
+    uint64_t gminSteps;  // Solutions that needed gmin stepping
+    uint64_t failures;   // Max iterations reached
+    uint32_t lastIter;   // Iterations in last solution
+    uint32_t maxIter;    // Max iterations in one solution
+};
+
+enum guiSync_t{        // Free running mode
+    SYNC_NONE=0,
+    SYNC_REQUEST,      // GUI wants to update components
+    SYNC_PAUSED,       // Simulation thread waiting at frame boundary
+};
+
 #include <QElapsedTimer>
 #include <QFuture>
+#include <vector>
+#include <atomic>
+#include <cmath>
+
+#define NL_GMIN_ITER  50     // Iterations before starting gmin stepping
+#define NL_GMIN_START 1e-2   // First gmin step
+#define NL_GMIN_END   1e-12  // Last gmin step
+#define NL_STAMP_ABSTOL 1e-12 // Damped currents and admittances: absolute tolerance
+
+#define FREE_SYNC_NS  1e8    // Free running: min time between GUI syncs at frame boundary (10 FPS)
 
 class BaseProcessor;
 class Updatable;
@@ -53,6 +79,19 @@ class Simulator : public QObject
         void stopSim();
 
         void setWarning( int warning ) { m_warning = warning; }
+        int error() { return m_error; }
+
+        bool freeRun() { return m_freeRun; }     // Simulation thread runs continuously, not paced by timer
+        void setFreeRun( bool f ) { m_freeRun = f; }
+
+        bool holdSim();    // Stop simulation thread at a safe point (GUI thread)
+        void releaseSim(); // Let simulation thread continue after holdSim()
+
+        void setHeadless( bool h ) { m_headless = h; } // No timer: simulation driven by runHeadless()
+        void runHeadless( uint64_t endTime );
+
+        uint64_t eventCount() { return m_eventCount; }
+        uint64_t solveCount() { return m_solveCount; }
         
         uint64_t fps() { return m_fps; }
         void setFps( uint64_t fps );
@@ -73,12 +112,30 @@ class Simulator : public QObject
 
         void  setMaxNlSteps( uint32_t steps ) { m_maxNlstp = steps; }
         uint32_t maxNlSteps( ) { return m_maxNlstp; }
+
+        void  setNlAbsTol( double tol ) { m_nlAbsTol = tol; }
+        double nlAbsTol() { return m_nlAbsTol; }
+
+        void  setNlRelTol( double tol ) { m_nlRelTol = tol; }
+        double nlRelTol() { return m_nlRelTol; }
+
+        inline bool nlConverged( double v, double vOld ) // Nonlinear elements: voltage converged?
+        { return std::fabs( v-vOld ) <= m_nlAbsTol + m_nlRelTol*std::fmax( std::fabs(v), std::fabs(vOld) ); }
+
+        inline bool nlStampConverged( double stamped, double model ) // Damped stamp reached model value?
+        { return std::fabs( stamped-model ) <= NL_STAMP_ABSTOL + m_nlRelTol*std::fmax( std::fabs(stamped), std::fabs(model) ); }
+
+        double   gmin() { return m_gmin; }      // Extra conductance in PN junctions while gmin stepping
+        uint32_t nlIteration() { return m_NLstep; }
+
+        const nlStats_t& nlStats() { return m_nlStats; }
         
         bool isRunning() { return (m_state >= SIM_STARTING); }
         bool isPaused()  { return (m_state == SIM_PAUSED); }
         bool isPauseDebug() { return (m_state == SIM_PAUSED && m_debug == true); }
 
         uint64_t circTime() { return m_circTime; }
+        uint64_t circTimeSnapshot() { return m_snapTime.load( std::memory_order_acquire ); } // Safe from GUI thread
 
         void timerEvent( QTimerEvent* e );
 
@@ -99,8 +156,9 @@ class Simulator : public QObject
         void addToSocketList( Socket* el );
         void remFromSocketList( Socket* el );
 
-        /// FIXME: make a list?
-        /// QemuDevice* m_qemuDevice;
+        void addQemuPending( QemuDevice* dev ) { m_qemuPending.push_back( dev ); }
+
+        uint64_t burstLimit(); // MCUs can run instructions with no external effects before this time
 
     private:
  static Simulator* m_pSelf;
@@ -112,15 +170,28 @@ class Simulator : public QObject
 
         void createNodes();
         void resetSim();
-        void runCircuit();
+        void runCircuit( uint64_t endRun );
+        void runFree();
         inline void solveCircuit();
         inline void solveMatrix();
+        void gminStep();
 
         inline void clearEventList();
 
+        void syncQemu();
+
+        // Event queue: binary heap ordered by time, last added first on same time
+        inline bool eventFirst( eElement* a, eElement* b )
+        { return (a->eventTime < b->eventTime) || (a->eventTime == b->eventTime && a->eventSeq > b->eventSeq); }
+        inline void eventUp( int i );
+        inline void eventDown( int i );
+        inline eElement* popEvent();
+
         //inline void stopTimer();
         //inline void initTimer();
-        eElement* m_firstEvent;
+        std::vector<eElement*> m_eventHeap;
+        std::vector<QemuDevice*> m_qemuPending; // Qemu devices released at this time step
+        uint64_t m_eventSeq;
 
 #ifdef DEBUG_EVENTS
         uint64_t m_events;
@@ -138,6 +209,7 @@ class Simulator : public QObject
         QMap<int, QString> m_warnings;
 
         QList<eNode*> m_eNodeList;
+        std::vector<eNode*> m_nonLinNodes; // eNodes with Non Linear elements
 
         eNode*    m_changedNode;
         eElement* m_voltChanged;
@@ -147,10 +219,12 @@ class Simulator : public QObject
         QList<Updatable*> m_updateList;
         QList<Socket*> m_socketList;
 
-        volatile simState_t m_state;
+        std::atomic<simState_t> m_state;
         simState_t m_oldState;
 
         bool m_debug;
+        bool m_headless;
+        std::atomic<bool> m_freeRun;
         bool m_converged;
         bool m_pauseCirc;
 
@@ -164,6 +238,10 @@ class Simulator : public QObject
         uint64_t m_fps;
         uint32_t m_NLstep;
         uint32_t m_maxNlstp;
+        double   m_nlAbsTol;
+        double   m_nlRelTol;
+        double   m_gmin;
+        nlStats_t m_nlStats;
 
         uint64_t m_psPerSec;
         uint64_t m_stepSize;  ///
@@ -174,6 +252,13 @@ class Simulator : public QObject
 
         uint64_t m_timerTime;
         uint64_t m_circTime;
+        uint64_t m_endRun;    // End time of current runCircuit()
+        uint64_t m_eventCount;
+        uint64_t m_solveCount;
+
+        std::atomic<uint64_t> m_snapTime; // Circuit time published by simulation thread at each frame
+        std::atomic<int> m_guiSync;       // guiSync_t
+        std::atomic<bool> m_framePublished; // Concurrent Updatables published by runCircuit() for current state
         uint64_t m_tStep;
         uint64_t m_lastStep;
         uint64_t m_refTime;
@@ -181,8 +266,10 @@ class Simulator : public QObject
         uint64_t m_loopTime;
         uint64_t m_guiTime;
         uint64_t m_updtTime;
+        uint64_t m_freeSyncTime; // Last frame boundary sync in free running mode
         double   m_simLoad;
 
         QElapsedTimer m_RefTimer;
         AnalogClock m_analogClock;
+        DiodeBatch  m_diodeBatch;
 };
@@ -0,0 +1,172 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#include <algorithm>
+#include <set>
+
+#include "sparselu.h"
+
+SparseLU::SparseLU()
+{
+    m_n = 0;
+    m_factorOps = 0;
+}
+SparseLU::~SparseLU(){}
+
+void SparseLU::analyze( int n, const std::vector<std::vector<int>> &pattern )
+{
+    m_n = n;
+    m_factorOps = 0;
+
+    minimumDegree( pattern );
+
+    m_lu.assign( m_colIdx.size(), 0 );
+    m_a.assign( m_colIdx.size(), 0 );
+    m_work.assign( m_n, 0 );
+    m_y.assign( m_n, 0 );
+}
+
+// Minimum degree ordering: eliminate first the node with less connections.
+// Eliminating a node connects all it's neighbors, which gives the fill-in,
+// so the pattern of L and U is obtained in the same pass.
+void SparseLU::minimumDegree( const std::vector<std::vector<int>> &pattern )
+{
+    std::vector<std::set<int>> adj( m_n );
+    for( int row=0; row<m_n; ++row )
+    {
+        for( int col : pattern[row] )
+        {
+            if( col == row ) continue;
+            adj[row].insert( col ); // Symmetric pattern
+            adj[col].insert( row );
+    }   }
+
+    m_perm.assign( m_n, 0 );
+    m_pinv.assign( m_n, 0 );
+    std::vector<bool> done( m_n, false );
+    std::vector<std::vector<int>> upper( m_n ); // Neighbors at elimination (old indexes)
+
+    for( int k=0; k<m_n; ++k )
+    {
+        int best = -1;
+        size_t degree = 0;
+        for( int i=0; i<m_n; ++i )
+        {
+            if( done[i] ) continue;
+            if( best < 0 || adj[i].size() < degree ) { best = i; degree = adj[i].size(); }
+        }
+        done[best] = true;
+        m_perm[k] = best;
+        m_pinv[best] = k;
+
+        std::vector<int> nb( adj[best].begin(), adj[best].end() );
+        for( int u : nb ) adj[u].erase( best );
+        for( int u : nb )                          // Fill-in
+            for( int w : nb ) if( u != w ) adj[u].insert( w );
+
+        m_factorOps += (double)nb.size()*(nb.size()+1);
+        upper[k] = nb;
+    }
+
+    std::vector<std::vector<int>> lower( m_n );    // Lower cols per row (new indexes)
+    for( int j=0; j<m_n; ++j )
+        for( int u : upper[j] ) lower[ m_pinv[u] ].push_back( j ); // Ascending j
+
+    m_rowPtr.assign( m_n+1, 0 );
+    m_diag.assign( m_n, 0 );
+    m_colIdx.clear();
+
+    for( int i=0; i<m_n; ++i )
+    {
+        m_rowPtr[i] = m_colIdx.size();
+        for( int j : lower[i] ) m_colIdx.push_back( j );
+
+        m_diag[i] = m_colIdx.size();
+        m_colIdx.push_back( i );
+
+        std::vector<int> cols;
+        for( int u : upper[i] ) cols.push_back( m_pinv[u] );
+        std::sort( cols.begin(), cols.end() );
+        for( int j : cols ) m_colIdx.push_back( j );
+    }
+    m_rowPtr[m_n] = m_colIdx.size();
+}
+
+int SparseLU::slot( int row, int col )
+{
+    int r = m_pinv[row];
+    int c = m_pinv[col];
+    auto first = m_colIdx.begin()+m_rowPtr[r];
+    auto last  = m_colIdx.begin()+m_rowPtr[r+1];
+    auto it = std::lower_bound( first, last, c );
+    if( it == last || *it != c ) return -1;
+    return it-m_colIdx.begin();
+}
+
+void SparseLU::factor( int first ) // Row by row Gaussian elimination over fixed pattern
+{
+    if( first < 0 ) first = 0;
+    if( first >= m_n ) return;
+
+    const int*  colIdx = m_colIdx.data();
+    double* lu = m_lu.data();
+    double* w  = m_work.data();
+
+    std::copy( m_a.begin()+m_rowPtr[first], m_a.end(), m_lu.begin()+m_rowPtr[first] );
+
+    for( int i=first; i<m_n; ++i )   // Rows before first only depend on rows before first
+    {
+        const int start = m_rowPtr[i];
+        const int end   = m_rowPtr[i+1];
+        const int diag  = m_diag[i];
+
+        for( int p=start; p<end; ++p ) w[colIdx[p]] = lu[p]; // Scatter row
+
+        for( int p=start; p<diag; ++p )      // Lower triangular elements
+        {
+            int k = colIdx[p];
+            double div = lu[m_diag[k]];
+            double q = w[k];
+            if( div != 0 ) q /= div;
+            w[k] = q;
+            if( q == 0 ) continue;
+
+            for( int r=m_diag[k]+1; r<m_rowPtr[k+1]; ++r ) w[colIdx[r]] -= q*lu[r];
+        }
+        for( int p=start; p<end; ++p ) lu[p] = w[colIdx[p]]; // Gather row
+    }
+}
+
+bool SparseLU::solve( const double* b, double* x )
+{
+    const int*    colIdx = m_colIdx.data();
+    const double* lu = m_lu.data();
+    double* y = m_y.data();
+
+    for( int i=0; i<m_n; ++i ) y[i] = b[m_perm[i]];
+
+    for( int i=0; i<m_n; ++i )        // Forward substitution from lower triangular matrix
+    {
+        double tot = y[i];
+        for( int p=m_rowPtr[i]; p<m_diag[i]; ++p ) tot -= lu[p]*y[colIdx[p]];
+        y[i] = tot;
+    }
+    bool isOk = true;
+
+    for( int i=m_n-1; i>=0; --i )     // Back substitution from upper triangular matrix
+    {
+        double tot = y[i];
+        for( int p=m_diag[i]+1; p<m_rowPtr[i+1]; ++p ) tot -= lu[p]*y[colIdx[p]];
+
+        double div = lu[m_diag[i]];
+        double volt = 0;
+        if( div != 0 ) volt = tot/div;
+        else isOk = false;
+        y[i] = volt;
+    }
+    for( int i=0; i<m_n; ++i ) x[m_perm[i]] = y[i];
+
+    return isOk;
+}
@@ -0,0 +1,53 @@
+/***************************************************************************
+ *   Copyright (C) 2026 by Santiago González                               *
+ *                                                                         *
+ ***( see copyright.txt file at root folder )*******************************/
+
+#pragma once
+
+#include <vector>
+
+// Sparse LU factorization for one group of nodes of the circuit Matrix.
+// Ordering and fill pattern are calculated once per topology in analyze(),
+// factor() only does numeric factorization over that fixed pattern.
+
+class SparseLU
+{
+    public:
+        SparseLU();
+        ~SparseLU();
+
+        // pattern[row] = columns with nonzero values in that row (local indexes)
+        void analyze( int n, const std::vector<std::vector<int>> &pattern );
+
+        int size()   { return m_n; }
+        int nonZeros() { return m_colIdx.size(); }
+        double factorOps() { return m_factorOps; } // Flops estimation of one factorization
+
+        int factorIndex( int i ) { return m_pinv[i]; } // Row in factor order
+
+        int slot( int row, int col ); // Position of element (row,col) in factor storage, -1 if not in pattern
+        double* element( int row, int col ) // Matrix element stamped directly, nullptr if not in pattern
+        { int s = slot( row, col ); return s < 0 ? nullptr : &m_a[s]; }
+
+        void factor( int first=0 );   // Refactor from row first, rows before it didn't change
+        bool solve( const double* b, double* x ); // b = currents, x = voltages
+
+    private:
+        void minimumDegree( const std::vector<std::vector<int>> &pattern );
+
+        int m_n;
+        double m_factorOps;
+
+        std::vector<int> m_perm;      // m_perm[newIndex] = oldIndex
+        std::vector<int> m_pinv;      // m_pinv[oldIndex] = newIndex
+
+        std::vector<int> m_rowPtr;    // Row compressed storage of L and U (permuted)
+        std::vector<int> m_colIdx;
+        std::vector<int> m_diag;      // Position of diagonal element in each row
+        std::vector<double> m_lu;
+        std::vector<double> m_a;      // Matrix elements in factor storage, fill-in elements are 0
+
+        std::vector<double> m_work;   // Dense work vectors
+        std::vector<double> m_y;
+};